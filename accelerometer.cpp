@@ -32,15 +32,14 @@
 #include <anjay/anjay.h>
 #include <avsystem/commons/avs_defs.h>
 #include <avsystem/commons/avs_list_cxx.hpp>
-#include <avsystem/commons/avs_log.h>
-
-#include <XNucleoIKS01A2.h>
 
 #include "accelerometer.h"
+#include "app_log.h"
+#include "client_local.h"
+#include "sensor_backend.h"
+#include "static_object_storage.h"
 
-#define ACCELEROMETER_OBJ_LOG(...) avs_log(accelerometer_obj, __VA_ARGS__)
-
-#define SENSOR_ID LSM303AGR_ACC_WHO_AM_I
+#define ACCELEROMETER_OBJ_LOG(...) APP_LOG(accelerometer_obj, __VA_ARGS__)
 
 using namespace std;
 
@@ -82,7 +81,7 @@ constexpr double VALUE_SCALE = 0.01;
 struct AccelerometerObject {
     const anjay_dm_object_def_t *const def;
 
-    LSM303AGRAccSensor *sensor;
+    SensorBackend *sensors;
 
     int32_t x_value;
     int32_t y_value;
@@ -169,23 +168,23 @@ AccelerometerObject::AccelerometerObject() : def(&OBJ_DEF) {}
 
 AccelerometerObject::~AccelerometerObject() {}
 
+CLIENT_LOCAL StaticObjectStorage<AccelerometerObject> OBJ_STORAGE;
+
 const anjay_dm_object_def_t **accelerometer_object_create(void) {
-    LSM303AGRAccSensor *sensor =
-            XNucleoIKS01A2::instance(D14, D15)->accelerometer;
-    uint8_t id = 0;
+    SensorBackend &sensors = sensor_backend();
     int32_t sensor_value[3];
-    if (sensor->read_id(&id) || id != SENSOR_ID || sensor->enable()
-        || sensor->get_x_axes(sensor_value)) {
+    if (sensors.enable(SensorType::ACCELEROMETER)
+        || sensors.read_axes(SensorType::ACCELEROMETER, sensor_value)) {
         ACCELEROMETER_OBJ_LOG(WARNING, "Failed to initialize accelerometer");
         return NULL;
     }
 
-    AccelerometerObject *obj = new (nothrow) AccelerometerObject;
+    AccelerometerObject *obj = OBJ_STORAGE.construct();
     if (!obj) {
         return NULL;
     }
 
-    obj->sensor = sensor;
+    obj->sensors = &sensors;
     obj->x_value = sensor_value[0];
     obj->y_value = sensor_value[1];
     obj->z_value = sensor_value[2];
@@ -195,11 +194,11 @@ const anjay_dm_object_def_t **accelerometer_object_create(void) {
 
 void accelerometer_object_release(const anjay_dm_object_def_t **def) {
     if (def) {
-        delete get_obj(def);
+        OBJ_STORAGE.destroy();
     }
 }
 
-const anjay_dm_object_def_t **OBJ_DEF_PTR;
+CLIENT_LOCAL const anjay_dm_object_def_t **OBJ_DEF_PTR;
 
 } // namespace
 
@@ -236,7 +235,7 @@ void accelerometer_object_update(anjay_t *anjay) {
     AccelerometerObject *obj = get_obj(OBJ_DEF_PTR);
 
     int32_t value[3];
-    if (obj->sensor->get_x_axes(value)) {
+    if (obj->sensors->read_axes(SensorType::ACCELEROMETER, value)) {
         ACCELEROMETER_OBJ_LOG(ERROR, "Failed to get accelerometer values");
         return;
     }
@@ -19,6 +19,8 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
+#include <utility>
 
 namespace avs {
 
@@ -27,6 +29,48 @@ namespace constexpr_conversions {
 constexpr const char BASE64_CHARS[] =
         "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
+constexpr const char HEX_CHARS_LOWER[] = "0123456789abcdef";
+constexpr const char HEX_CHARS_UPPER[] = "0123456789ABCDEF";
+
+/**
+ * Maps every possible input character to its numeric value, or -1 if it is
+ * not a valid digit. Using a table instead of searching the alphabet for every
+ * input character keeps the constexpr evaluation cheap for large inputs, such
+ * as certificate chains.
+ */
+struct DecodeTable {
+    int8_t values[256];
+
+    constexpr DecodeTable(const char *alphabet, size_t size)
+            : DecodeTable(alphabet, size, nullptr, 0) {}
+
+    constexpr DecodeTable(const char *alphabet,
+                          size_t size,
+                          const char *alt_alphabet,
+                          size_t alt_size)
+            : values() {
+        for (size_t i = 0; i < sizeof(values); ++i) {
+            values[i] = -1;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            values[(unsigned char) alphabet[i]] = (int8_t) i;
+        }
+        for (size_t i = 0; i < alt_size; ++i) {
+            values[(unsigned char) alt_alphabet[i]] = (int8_t) i;
+        }
+    }
+
+    constexpr int operator[](char ch) const {
+        return values[(unsigned char) ch];
+    }
+};
+
+constexpr DecodeTable BASE64_TABLE{ BASE64_CHARS, sizeof(BASE64_CHARS) - 1 };
+
+constexpr DecodeTable HEX_TABLE{ HEX_CHARS_LOWER, sizeof(HEX_CHARS_LOWER) - 1,
+                                 HEX_CHARS_UPPER,
+                                 sizeof(HEX_CHARS_UPPER) - 1 };
+
 template <typename T, size_t N, size_t... Indexes>
 constexpr std::array<T, N> as_array(const T (&tab)[N],
                                     std::index_sequence<Indexes...>) {
@@ -38,79 +82,183 @@ constexpr std::array<T, N> as_array(const T (&tab)[N]) {
     return as_array<T, N>(tab, std::make_index_sequence<N>());
 }
 
-constexpr int base64_char_index(char ch) {
-    for (int i = 0; i < (int) sizeof(BASE64_CHARS) - 1; ++i) {
-        if (BASE64_CHARS[i] == ch) {
-            return i;
+/**
+ * Checks that the data is a concatenation of one or more complete DER-encoded
+ * SEQUENCEs (e.g. a certificate chain), without buffering any of it.
+ */
+class DerSequenceChecker {
+    enum class State { TAG, LENGTH, LENGTH_CONT };
+
+    State state_;
+    size_t offset_;
+    size_t element_end_;
+    size_t length_;
+    uint8_t length_bytes_left_;
+    size_t elements_;
+    bool valid_;
+
+    constexpr void header_finished() {
+        element_end_ = offset_ + 1 + length_;
+        ++elements_;
+        state_ = State::TAG;
+    }
+
+public:
+    constexpr DerSequenceChecker()
+            : state_(State::TAG),
+              offset_(0),
+              element_end_(0),
+              length_(0),
+              length_bytes_left_(0),
+              elements_(0),
+              valid_(true) {}
+
+    constexpr void feed(uint8_t byte) {
+        if (offset_ < element_end_ || !valid_) {
+            // Contents are not inspected
+            ++offset_;
+            return;
+        }
+        switch (state_) {
+        case State::TAG:
+            valid_ = (byte == 0x30);
+            state_ = State::LENGTH;
+            break;
+        case State::LENGTH:
+            if (byte < 0x80) {
+                length_ = byte;
+                header_finished();
+            } else if (byte == 0x80 || (byte & 0x7F) > 4) {
+                // Indefinite length is not allowed in DER
+                valid_ = false;
+            } else {
+                length_ = 0;
+                length_bytes_left_ = (uint8_t) (byte & 0x7F);
+                state_ = State::LENGTH_CONT;
+            }
+            break;
+        case State::LENGTH_CONT:
+            length_ = (length_ << 8) | byte;
+            if (!--length_bytes_left_) {
+                header_finished();
+            }
+            break;
         }
+        ++offset_;
     }
-    return -1;
+
+    constexpr bool valid() const {
+        return valid_ && elements_ && state_ == State::TAG
+               && offset_ == element_end_;
+    }
+};
+
+/**
+ * Result of scanning a PEM input. Each block between lines starting with '-'
+ * is treated as a separate base64 stream, so that certificate chains with
+ * padding in the middle are decoded correctly.
+ */
+struct PemScanResult {
+    size_t der_size;
+    bool padding_valid;
+    bool der_valid;
+};
+
+constexpr bool is_pem_line_end(char ch) {
+    // The input might be a quoted string literal
+    return ch == '\n' || ch == '\'' || ch == '"';
+}
+
+constexpr bool base64_block_valid(size_t data_chars,
+                                  size_t padding_chars,
+                                  uint32_t accumulator,
+                                  uint8_t bits) {
+    // A single trailing character cannot encode a whole byte, padding is
+    // either absent or completes the last quantum, and unused bits are zero.
+    return data_chars % 4 != 1 && padding_chars <= 2
+           && (!padding_chars || (data_chars + padding_chars) % 4 == 0)
+           && !(accumulator & ((1U << bits) - 1));
 }
 
 template <size_t N, const char Str[N]>
-constexpr size_t count_active_pem_chars() {
-    size_t result = 0;
-    for (size_t i = 0; i < N; ++i) {
-        if (Str[i] == '-') {
+constexpr PemScanResult scan_pem() {
+    PemScanResult result{ 0, true, false };
+    DerSequenceChecker der{};
+    size_t data_chars = 0;
+    size_t padding_chars = 0;
+    uint32_t accumulator = 0;
+    uint8_t bits = 0;
+    for (size_t i = 0; i <= N; ++i) {
+        if (i == N || Str[i] == '-') {
+            result.padding_valid =
+                    result.padding_valid
+                    && base64_block_valid(data_chars, padding_chars,
+                                          accumulator, bits);
+            data_chars = 0;
+            padding_chars = 0;
+            accumulator = 0;
+            bits = 0;
             // Skip lines starting with '-'
-            while (i < N
-                   && !(Str[i] == '\n' || Str[i] == '\'' || Str[i] == '"')) {
+            while (i < N && !is_pem_line_end(Str[i])) {
                 ++i;
             }
-        } else if (base64_char_index(Str[i]) >= 0) {
-            ++result;
+        } else if (Str[i] == '=') {
+            ++padding_chars;
+        } else if (BASE64_TABLE[Str[i]] >= 0) {
+            // Data after padding is not allowed within a single block
+            result.padding_valid = result.padding_valid && !padding_chars;
+            ++data_chars;
+            accumulator = (accumulator << 6) | BASE64_TABLE[Str[i]];
+            bits += 6;
+            if (bits >= 8) {
+                bits -= 8;
+                der.feed((uint8_t) (accumulator >> bits));
+                accumulator &= (1U << bits) - 1;
+                ++result.der_size;
+            }
         }
     }
+    result.der_valid = der.valid();
     return result;
 }
 
-template <size_t N,
-          const char Str[N],
-          size_t OutSize = count_active_pem_chars<N, Str>()>
-constexpr auto strip_non_pem_chars() {
-    char result[OutSize] = {};
+template <size_t N, const char Str[N]>
+constexpr auto pem2der() {
+    constexpr PemScanResult SCAN = scan_pem<N, Str>();
+    static_assert(SCAN.padding_valid, "Invalid base64 padding in PEM input");
+    static_assert(SCAN.der_valid,
+                  "PEM input does not decode to a sequence of DER elements");
+
+    uint8_t result[SCAN.der_size] = {};
     size_t out = 0;
+    uint32_t accumulator = 0;
+    uint8_t bits = 0;
     for (size_t i = 0; i < N; ++i) {
         if (Str[i] == '-') {
+            accumulator = 0;
+            bits = 0;
             // Skip lines starting with '-'
-            while (i < N
-                   && !(Str[i] == '\n' || Str[i] == '\'' || Str[i] == '"')) {
+            while (i < N && !is_pem_line_end(Str[i])) {
                 ++i;
             }
-        } else if (base64_char_index(Str[i]) >= 0) {
-            result[out++] = Str[i];
-        }
-    }
-    return as_array<char, OutSize>(result);
-}
-
-template <size_t N,
-          const char Str[N],
-          size_t OutSize = (count_active_pem_chars<N, Str>() * 3) / 4>
-constexpr auto pem2der() {
-    uint8_t result[OutSize] = {};
-    size_t out = 0;
-    const auto input = strip_non_pem_chars<N, Str>();
-    uint8_t bits = 0;
-    uint32_t accumulator = 0;
-    for (size_t i = 0; i < input.size(); ++i) {
-        bits += 6;
-        accumulator <<= 6;
-        accumulator |= base64_char_index(input[i]);
-        if (bits >= 8) {
-            bits -= 8;
-            result[out++] = (uint8_t) ((accumulator >> bits) & 0xFFu);
+        } else if (BASE64_TABLE[Str[i]] >= 0) {
+            accumulator = (accumulator << 6) | BASE64_TABLE[Str[i]];
+            bits += 6;
+            if (bits >= 8) {
+                bits -= 8;
+                result[out++] = (uint8_t) (accumulator >> bits);
+                accumulator &= (1U << bits) - 1;
+            }
         }
     }
-    return as_array<uint8_t, OutSize>(result);
+    return as_array<uint8_t, SCAN.der_size>(result);
 }
 
 template <size_t N, const char Str[N]>
 constexpr size_t count_valid_hex_chars() {
     size_t result = 0;
     for (size_t i = 0; i < N; ++i) {
-        if ((Str[i] >= '0' && Str[i] <= '9') || (Str[i] >= 'a' && Str[i] <= 'f')
-            || (Str[i] >= 'A' && Str[i] <= 'F')) {
+        if (HEX_TABLE[Str[i]] >= 0) {
             ++result;
         }
     }
@@ -127,17 +275,9 @@ constexpr auto unhexlify() {
     uint8_t nibbles = 0;
     uint8_t accumulator = 0;
     for (size_t i = 0; i < N; ++i) {
-        int16_t nibble = -1;
-        if (Str[i] >= '0' && Str[i] <= '9') {
-            nibble = Str[i] - '0';
-        } else if (Str[i] >= 'a' && Str[i] <= 'f') {
-            nibble = Str[i] - 'a' + 10;
-        } else if (Str[i] >= 'A' && Str[i] <= 'F') {
-            nibble = Str[i] - 'A' + 10;
-        }
+        const int nibble = HEX_TABLE[Str[i]];
         if (nibble >= 0) {
-            accumulator <<= 4;
-            accumulator |= nibble;
+            accumulator = (uint8_t) ((accumulator << 4) | nibble);
             ++nibbles;
         }
         if (nibbles == 2) {
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef MBED_CLOUD_CLIENT_FOTA_ENABLE
+
+#include <limits>
+
+#include <avsystem/commons/avs_defs.h>
+#include <avsystem/commons/avs_utils.h>
+
+#include "der_stream_validator.h"
+
+namespace {
+
+constexpr uint8_t DER_TAG_SEQUENCE = 0x30;
+constexpr uint8_t DER_TAG_CONSTRUCTED_FLAG = 0x20;
+constexpr uint8_t DER_TAG_NUMBER_MASK = 0x1F;
+constexpr uint8_t DER_TAG_CONTINUATION_FLAG = 0x80;
+constexpr uint8_t DER_LENGTH_LONG_FORM_FLAG = 0x80;
+
+// Limits for the number of subsequent tag bytes in the high tag number form,
+// and for the number of length bytes in the long form.
+constexpr uint8_t MAX_TAG_BYTES = 4;
+constexpr uint8_t MAX_LENGTH_BYTES = 4;
+
+} // namespace
+
+DerStreamValidator::DerStreamValidator()
+        : state_(State::TAG),
+          offset_(0),
+          total_size_(0),
+          constructed_(false),
+          tag_bytes_(0),
+          length_bytes_left_(0),
+          length_bytes_(0),
+          length_(0),
+          content_end_(0),
+          depth_(0),
+          ends_() {}
+
+int DerStreamValidator::feed(const void *data,
+                             size_t data_size,
+                             size_t *out_consumed) {
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(data);
+    size_t consumed = 0;
+    while (consumed < data_size && state_ != State::DONE
+           && state_ != State::ERROR) {
+        if (state_ == State::CONTENT) {
+            // Contents of primitive elements are not inspected at all
+            size_t to_skip =
+                    AVS_MIN(data_size - consumed, content_end_ - offset_);
+            consumed += to_skip;
+            offset_ += to_skip;
+            pop_finished();
+        } else {
+            ++offset_;
+            if (process_byte(bytes[consumed++])) {
+                state_ = State::ERROR;
+            }
+        }
+    }
+    *out_consumed = consumed;
+    return state_ == State::ERROR ? -1 : 0;
+}
+
+int DerStreamValidator::process_byte(uint8_t byte) {
+    switch (state_) {
+    case State::TAG:
+        // End-of-contents octets are only used with indefinite length, which
+        // is not allowed in DER
+        if ((!depth_ && byte != DER_TAG_SEQUENCE) || !byte) {
+            return -1;
+        }
+        constructed_ = (byte & DER_TAG_CONSTRUCTED_FLAG);
+        tag_bytes_ = 0;
+        state_ = ((byte & DER_TAG_NUMBER_MASK) == DER_TAG_NUMBER_MASK)
+                         ? State::TAG_CONT
+                         : State::LENGTH;
+        return 0;
+
+    case State::TAG_CONT:
+        // High tag number form; leading zero groups are not allowed
+        if ((!tag_bytes_ && byte == DER_TAG_CONTINUATION_FLAG)
+            || ++tag_bytes_ > MAX_TAG_BYTES) {
+            return -1;
+        }
+        if (!(byte & DER_TAG_CONTINUATION_FLAG)) {
+            state_ = State::LENGTH;
+        }
+        return 0;
+
+    case State::LENGTH:
+        if (!(byte & DER_LENGTH_LONG_FORM_FLAG)) {
+            length_ = byte;
+            return header_finished();
+        }
+        // Zero length bytes in the long form denote the indefinite length
+        length_bytes_ = (uint8_t) (byte & ~DER_LENGTH_LONG_FORM_FLAG);
+        if (!length_bytes_ || length_bytes_ > MAX_LENGTH_BYTES) {
+            return -1;
+        }
+        length_bytes_left_ = length_bytes_;
+        length_ = 0;
+        state_ = State::LENGTH_CONT;
+        return 0;
+
+    case State::LENGTH_CONT:
+        // DER requires the length to be encoded on the minimal number of bytes
+        if (length_bytes_left_ == length_bytes_ && !byte) {
+            return -1;
+        }
+        length_ = (length_ << 8) | byte;
+        if (--length_bytes_left_) {
+            return 0;
+        }
+        if (length_ < DER_LENGTH_LONG_FORM_FLAG) {
+            return -1;
+        }
+        return header_finished();
+
+    default:
+        AVS_UNREACHABLE("invalid state");
+        return -1;
+    }
+}
+
+int DerStreamValidator::header_finished() {
+    if (length_ > std::numeric_limits<size_t>::max() - offset_) {
+        return -1;
+    }
+    const size_t end = offset_ + length_;
+    if (!depth_) {
+        total_size_ = end;
+    } else if (end > ends_[depth_ - 1]) {
+        // Element does not fit in its parent
+        return -1;
+    }
+    if (constructed_ && depth_ < MAX_DEPTH) {
+        ends_[depth_++] = end;
+        state_ = State::TAG;
+    } else {
+        content_end_ = end;
+        state_ = State::CONTENT;
+    }
+    pop_finished();
+    return 0;
+}
+
+void DerStreamValidator::pop_finished() {
+    if (state_ == State::CONTENT) {
+        if (offset_ < content_end_) {
+            return;
+        }
+        state_ = State::TAG;
+    }
+    while (depth_ && offset_ == ends_[depth_ - 1]) {
+        --depth_;
+    }
+    if (!depth_) {
+        state_ = State::DONE;
+    }
+}
+
+#endif // MBED_CLOUD_CLIENT_FOTA_ENABLE
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DER_STREAM_VALIDATOR_H
+#define DER_STREAM_VALIDATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Incremental validator of the structure of a single DER-encoded element,
+ * whose outermost tag is required to be a constructed SEQUENCE.
+ *
+ * Data may be fed in chunks of arbitrary size. Only the TLV headers are
+ * inspected and no data is buffered, so the memory usage is constant. Nested
+ * constructed elements are validated up to MAX_DEPTH levels, deeper ones are
+ * treated as opaque.
+ */
+class DerStreamValidator {
+public:
+    static constexpr size_t MAX_DEPTH = 8;
+
+    DerStreamValidator();
+
+    /**
+     * Feeds the validator with subsequent bytes of the element. Data past the
+     * end of the outermost element is not consumed.
+     *
+     * @param data         Pointer to the data.
+     * @param data_size    Number of bytes available at @p data.
+     * @param out_consumed Set to the number of bytes that belong to the
+     *                     element.
+     *
+     * @returns 0 on success, or -1 if the data is not a valid DER encoding.
+     */
+    int feed(const void *data, size_t data_size, size_t *out_consumed);
+
+    /**
+     * @returns Size of the whole outermost element, including its header, or
+     *          0 if the header has not been received yet.
+     */
+    size_t total_size() const {
+        return total_size_;
+    }
+
+    bool complete() const {
+        return state_ == State::DONE;
+    }
+
+private:
+    enum class State {
+        TAG,
+        TAG_CONT,
+        LENGTH,
+        LENGTH_CONT,
+        CONTENT,
+        DONE,
+        ERROR
+    };
+
+    State state_;
+    size_t offset_;
+    size_t total_size_;
+    bool constructed_;
+    uint8_t tag_bytes_;
+    uint8_t length_bytes_left_;
+    uint8_t length_bytes_;
+    size_t length_;
+    size_t content_end_;
+    size_t depth_;
+    size_t ends_[MAX_DEPTH];
+
+    int process_byte(uint8_t byte);
+    int header_finished();
+    void pop_finished();
+};
+
+#endif /* DER_STREAM_VALIDATOR_H */
@@ -0,0 +1,194 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef MBED_CLOUD_CLIENT_FOTA_ENABLE
+
+#include <avsystem/commons/avs_log.h>
+
+#include "fota_telemetry.h"
+
+#define LOG(...) avs_log(fota_telemetry, __VA_ARGS__)
+
+namespace {
+
+constexpr int NO_PHASE = -1;
+
+// Download progress is logged in steps of this many percent
+constexpr unsigned PROGRESS_LOG_STEP_PERCENT = 10;
+
+const char *const PHASE_NAMES[FotaTelemetry::PHASE_COUNT] = {
+    "manifest", "download", "verify", "install"
+};
+
+int64_t to_ms(avs_time_duration_t duration) {
+    int64_t ms = 0;
+    avs_time_duration_to_scalar(&ms, AVS_TIME_MS, duration);
+    return ms;
+}
+
+} // namespace
+
+FotaTelemetry FotaTelemetry::INSTANCE;
+
+FotaTelemetry::FotaTelemetry()
+        : attempts_(0),
+          failures_(0),
+          in_progress_(false),
+          last_state_(-1),
+          bytes_downloaded_(0),
+          flash_writes_(0),
+          flash_write_time_(AVS_TIME_DURATION_ZERO),
+          generation_(0),
+          current_phase_(NO_PHASE),
+          last_progress_percent_(0) {
+    for (size_t i = 0; i < PHASE_COUNT; ++i) {
+        phase_start_[i] = AVS_TIME_MONOTONIC_INVALID;
+        phase_end_[i] = AVS_TIME_MONOTONIC_INVALID;
+    }
+}
+
+void FotaTelemetry::download_started() {
+    ++attempts_;
+    in_progress_ = true;
+    bytes_downloaded_ = 0;
+    flash_writes_ = 0;
+    flash_write_time_ = AVS_TIME_DURATION_ZERO;
+    last_progress_percent_ = 0;
+    current_phase_ = NO_PHASE;
+    for (size_t i = 0; i < PHASE_COUNT; ++i) {
+        phase_start_[i] = AVS_TIME_MONOTONIC_INVALID;
+        phase_end_[i] = AVS_TIME_MONOTONIC_INVALID;
+    }
+    phase_started(Phase::MANIFEST);
+    if (attempts_ > 1) {
+        LOG(INFO, "FOTA download attempt %lu", (unsigned long) attempts_);
+    }
+}
+
+void FotaTelemetry::download_finished() {
+    in_progress_ = false;
+    phase_finished();
+    log_summary();
+}
+
+void FotaTelemetry::download_failed() {
+    attempt_failed("failed");
+}
+
+void FotaTelemetry::download_aborted() {
+    attempt_failed("aborted");
+}
+
+void FotaTelemetry::attempt_failed(const char *what) {
+    if (!in_progress_) {
+        return;
+    }
+    if (current_phase_ != NO_PHASE) {
+        LOG(WARNING, "FOTA %s during %s phase", what,
+            PHASE_NAMES[current_phase_]);
+    }
+    in_progress_ = false;
+    ++failures_;
+    ++generation_;
+    phase_finished();
+    log_summary();
+}
+
+void FotaTelemetry::phase_started(Phase phase) {
+    phase_finished();
+    current_phase_ = (int) phase;
+    phase_start_[current_phase_] = avs_time_monotonic_now();
+    ++generation_;
+}
+
+void FotaTelemetry::phase_finished() {
+    if (current_phase_ != NO_PHASE) {
+        phase_end_[current_phase_] = avs_time_monotonic_now();
+        current_phase_ = NO_PHASE;
+        ++generation_;
+    }
+}
+
+void FotaTelemetry::bytes_received(size_t size) {
+    bytes_downloaded_ += size;
+    ++generation_;
+}
+
+void FotaTelemetry::flash_write_finished(avs_time_monotonic_t start_time) {
+    ++flash_writes_;
+    flash_write_time_ = avs_time_duration_add(
+            flash_write_time_,
+            avs_time_monotonic_diff(avs_time_monotonic_now(), start_time));
+    ++generation_;
+}
+
+void FotaTelemetry::state_reported(int state) {
+    if (state != last_state_) {
+        LOG(DEBUG, "FOTA state: %d", state);
+        last_state_ = state;
+        ++generation_;
+    }
+}
+
+void FotaTelemetry::progress(size_t downloaded_size, size_t total_size) {
+    if (!total_size) {
+        return;
+    }
+    unsigned percent = (unsigned) ((uint64_t) downloaded_size * 100
+                                   / total_size);
+    if (percent >= last_progress_percent_ + PROGRESS_LOG_STEP_PERCENT
+        || (percent == 100 && last_progress_percent_ != 100)) {
+        LOG(INFO, "FOTA progress: %u%% (%lu/%lu B, %lu B/s)", percent,
+            (unsigned long) downloaded_size, (unsigned long) total_size,
+            (unsigned long) throughput());
+        last_progress_percent_ = percent;
+    }
+}
+
+avs_time_duration_t FotaTelemetry::phase_duration(Phase phase) const {
+    const size_t index = (size_t) phase;
+    if (!avs_time_monotonic_valid(phase_start_[index])) {
+        return AVS_TIME_DURATION_ZERO;
+    }
+    avs_time_monotonic_t end = phase_end_[index];
+    if (!avs_time_monotonic_valid(end)) {
+        end = avs_time_monotonic_now();
+    }
+    return avs_time_monotonic_diff(end, phase_start_[index]);
+}
+
+uint32_t FotaTelemetry::throughput() const {
+    int64_t ms = to_ms(avs_time_duration_add(phase_duration(Phase::MANIFEST),
+                                             phase_duration(Phase::DOWNLOAD)));
+    if (ms <= 0) {
+        return 0;
+    }
+    return (uint32_t) (bytes_downloaded_ * 1000 / (uint64_t) ms);
+}
+
+void FotaTelemetry::log_summary() const {
+    LOG(INFO,
+        "FOTA attempt %lu: %lu B downloaded at %lu B/s; manifest %ld ms, "
+        "download %ld ms, verify %ld ms; %lu flash writes took %ld ms",
+        (unsigned long) attempts_, (unsigned long) bytes_downloaded_,
+        (unsigned long) throughput(),
+        (long) to_ms(phase_duration(Phase::MANIFEST)),
+        (long) to_ms(phase_duration(Phase::DOWNLOAD)),
+        (long) to_ms(phase_duration(Phase::VERIFY)),
+        (unsigned long) flash_writes_, (long) to_ms(flash_write_time_));
+}
+
+#endif // MBED_CLOUD_CLIENT_FOTA_ENABLE
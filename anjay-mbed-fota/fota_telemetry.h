@@ -0,0 +1,113 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOTA_TELEMETRY_H
+#define FOTA_TELEMETRY_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <avsystem/commons/avs_time.h>
+
+/**
+ * Collects timing and throughput statistics of the firmware update process.
+ *
+ * The statistics concern the most recent update attempt, except for the
+ * attempt and failure counters, which are kept since boot.
+ */
+class FotaTelemetry {
+public:
+    enum class Phase { MANIFEST, DOWNLOAD, VERIFY, INSTALL };
+    static constexpr size_t PHASE_COUNT = 4;
+
+    static FotaTelemetry INSTANCE;
+
+    void download_started();
+    void download_finished();
+    void download_failed();
+    /**
+     * Counts the current attempt as failed if it has neither finished nor
+     * failed yet, e.g. when the download is reset by the server.
+     */
+    void download_aborted();
+    void phase_started(Phase phase);
+    void phase_finished();
+    void bytes_received(size_t size);
+    void flash_write_finished(avs_time_monotonic_t start_time);
+    void state_reported(int state);
+    void progress(size_t downloaded_size, size_t total_size);
+    void log_summary() const;
+
+    uint32_t attempts() const {
+        return attempts_;
+    }
+
+    uint32_t failures() const {
+        return failures_;
+    }
+
+    int last_state() const {
+        return last_state_;
+    }
+
+    uint64_t bytes_downloaded() const {
+        return bytes_downloaded_;
+    }
+
+    uint32_t flash_writes() const {
+        return flash_writes_;
+    }
+
+    avs_time_duration_t flash_write_time() const {
+        return flash_write_time_;
+    }
+
+    /**
+     * Incremented whenever any of the statistics change, so that readers can
+     * detect that without comparing all the values.
+     */
+    uint32_t generation() const {
+        return generation_;
+    }
+
+    avs_time_duration_t phase_duration(Phase phase) const;
+
+    /**
+     * @returns Average download speed in bytes per second, including the time
+     *          spent on receiving the manifest.
+     */
+    uint32_t throughput() const;
+
+private:
+    FotaTelemetry();
+
+    void attempt_failed(const char *what);
+
+    uint32_t attempts_;
+    uint32_t failures_;
+    bool in_progress_;
+    int last_state_;
+    uint64_t bytes_downloaded_;
+    uint32_t flash_writes_;
+    avs_time_duration_t flash_write_time_;
+    uint32_t generation_;
+    int current_phase_;
+    avs_time_monotonic_t phase_start_[PHASE_COUNT];
+    avs_time_monotonic_t phase_end_[PHASE_COUNT];
+    unsigned last_progress_percent_;
+};
+
+#endif /* FOTA_TELEMETRY_H */
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef MBED_CLOUD_CLIENT_FOTA_ENABLE
+
+#include <cstring>
+
+#include <avsystem/commons/avs_defs.h>
+
+#include "heatshrink_decoder.h"
+
+HeatshrinkDecoder::HeatshrinkDecoder()
+        : state_(State::TAG),
+          window_sz2_(0),
+          lookahead_sz2_(0),
+          window_(nullptr),
+          window_mask_(0),
+          head_(0),
+          bit_buf_(0),
+          bit_count_(0),
+          backref_index_(0),
+          backref_count_(0) {}
+
+int HeatshrinkDecoder::reset(uint8_t window_sz2,
+                             uint8_t lookahead_sz2,
+                             uint8_t *window,
+                             size_t window_size) {
+    if (window_sz2 < MIN_WINDOW_SZ2 || window_sz2 > MAX_WINDOW_SZ2
+        || lookahead_sz2 < MIN_LOOKAHEAD_SZ2 || lookahead_sz2 >= window_sz2
+        || window_size < ((size_t) 1 << window_sz2)) {
+        return -1;
+    }
+    state_ = State::TAG;
+    window_sz2_ = window_sz2;
+    lookahead_sz2_ = lookahead_sz2;
+    window_ = window;
+    window_mask_ = ((size_t) 1 << window_sz2) - 1;
+    head_ = 0;
+    bit_buf_ = 0;
+    bit_count_ = 0;
+    // Back-references reaching before the beginning of the stream refer to
+    // zeros, the same as in the reference implementation.
+    memset(window_, 0, window_mask_ + 1);
+    return 0;
+}
+
+bool HeatshrinkDecoder::get_bits(uint8_t count,
+                                 const uint8_t **in,
+                                 const uint8_t *in_end,
+                                 uint16_t *out_value) {
+    // Bits are stored MSB first. At most 15 bits are requested at once, so
+    // the accumulator never holds more than 22 bits.
+    while (bit_count_ < count && *in < in_end) {
+        bit_buf_ = (bit_buf_ << 8) | *(*in)++;
+        bit_count_ += 8;
+    }
+    if (bit_count_ < count) {
+        return false;
+    }
+    bit_count_ -= count;
+    *out_value = (uint16_t) ((bit_buf_ >> bit_count_) & ((1U << count) - 1));
+    return true;
+}
+
+void HeatshrinkDecoder::emit(uint8_t byte, uint8_t **out) {
+    *(*out)++ = byte;
+    window_[head_++ & window_mask_] = byte;
+}
+
+size_t HeatshrinkDecoder::decode(const void *in,
+                                 size_t in_size,
+                                 size_t *out_in_consumed,
+                                 void *out,
+                                 size_t out_size) {
+    const uint8_t *const in_start = reinterpret_cast<const uint8_t *>(in);
+    const uint8_t *const in_end = in_start + in_size;
+    uint8_t *const out_start = reinterpret_cast<uint8_t *>(out);
+    uint8_t *const out_end = out_start + out_size;
+    const uint8_t *in_ptr = in_start;
+    uint8_t *out_ptr = out_start;
+    uint16_t value;
+    while (out_ptr < out_end) {
+        if (state_ == State::BACKREF_COPY) {
+            emit(window_[(head_ - backref_index_) & window_mask_], &out_ptr);
+            if (!--backref_count_) {
+                state_ = State::TAG;
+            }
+            continue;
+        }
+        bool have_bits;
+        switch (state_) {
+        case State::TAG:
+            if ((have_bits = get_bits(1, &in_ptr, in_end, &value))) {
+                state_ = value ? State::LITERAL : State::BACKREF_INDEX;
+            }
+            break;
+        case State::LITERAL:
+            if ((have_bits = get_bits(8, &in_ptr, in_end, &value))) {
+                emit((uint8_t) value, &out_ptr);
+                state_ = State::TAG;
+            }
+            break;
+        case State::BACKREF_INDEX:
+            if ((have_bits = get_bits(window_sz2_, &in_ptr, in_end, &value))) {
+                backref_index_ = (uint16_t) (value + 1);
+                state_ = State::BACKREF_COUNT;
+            }
+            break;
+        case State::BACKREF_COUNT:
+            if ((have_bits =
+                         get_bits(lookahead_sz2_, &in_ptr, in_end, &value))) {
+                backref_count_ = (uint16_t) (value + 1);
+                state_ = State::BACKREF_COPY;
+            }
+            break;
+        default:
+            AVS_UNREACHABLE("invalid state");
+            have_bits = false;
+        }
+        if (!have_bits) {
+            break;
+        }
+    }
+    *out_in_consumed = (size_t) (in_ptr - in_start);
+    return (size_t) (out_ptr - out_start);
+}
+
+#endif // MBED_CLOUD_CLIENT_FOTA_ENABLE
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HEATSHRINK_DECODER_H
+#define HEATSHRINK_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Streaming decoder of the heatshrink (LZSS) compressed data format.
+ *
+ * The sliding window is provided by the caller, so that its size may be
+ * bounded at compile time. The decoder itself does not allocate any memory.
+ */
+class HeatshrinkDecoder {
+public:
+    static constexpr uint8_t MIN_WINDOW_SZ2 = 4;
+    static constexpr uint8_t MAX_WINDOW_SZ2 = 15;
+    static constexpr uint8_t MIN_LOOKAHEAD_SZ2 = 3;
+
+    HeatshrinkDecoder();
+
+    /**
+     * Prepares the decoder for a new stream.
+     *
+     * @param window_sz2    Base-2 logarithm of the window size used by the
+     *                      encoder.
+     * @param lookahead_sz2 Base-2 logarithm of the lookahead size used by the
+     *                      encoder.
+     * @param window        Buffer for the sliding window.
+     * @param window_size   Size of @p window; needs to be at least
+     *                      2^window_sz2 bytes.
+     *
+     * @returns 0 on success, or -1 if the parameters are not supported.
+     */
+    int reset(uint8_t window_sz2,
+              uint8_t lookahead_sz2,
+              uint8_t *window,
+              size_t window_size);
+
+    /**
+     * Decodes as much data as possible, limited either by the input or by the
+     * space available in the output buffer.
+     *
+     * @param in              Compressed data.
+     * @param in_size         Number of bytes available at @p in.
+     * @param out_in_consumed Set to the number of bytes consumed from @p in.
+     * @param out             Buffer for the decompressed data.
+     * @param out_size        Size of @p out.
+     *
+     * @returns Number of bytes written to @p out.
+     */
+    size_t decode(const void *in,
+                  size_t in_size,
+                  size_t *out_in_consumed,
+                  void *out,
+                  size_t out_size);
+
+private:
+    enum class State {
+        TAG,
+        LITERAL,
+        BACKREF_INDEX,
+        BACKREF_COUNT,
+        BACKREF_COPY
+    };
+
+    State state_;
+    uint8_t window_sz2_;
+    uint8_t lookahead_sz2_;
+    uint8_t *window_;
+    size_t window_mask_;
+    size_t head_;
+    uint32_t bit_buf_;
+    uint8_t bit_count_;
+    uint16_t backref_index_;
+    uint16_t backref_count_;
+
+    bool get_bits(uint8_t count,
+                  const uint8_t **in,
+                  const uint8_t *in_end,
+                  uint16_t *out_value);
+    void emit(uint8_t byte, uint8_t **out);
+};
+
+#endif /* HEATSHRINK_DECODER_H */
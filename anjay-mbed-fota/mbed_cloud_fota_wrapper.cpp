@@ -22,9 +22,8 @@
 
 #include <anjay/fw_update.h>
 
-#include <mbedtls/asn1.h>
-
 #include "anjay_mbed_fota_conversions.h"
+#include "fota_telemetry.h"
 #include "mbed_cloud_fota_wrapper.h"
 
 #include "fota.h"
@@ -93,6 +92,27 @@ public:
 
 NextFotaAction NEXT_ACTION;
 
+// The manifest needs to be passed to fota_on_manifest() as a whole. It is
+// stored in a statically allocated buffer, so that a large or malicious
+// manifest cannot exhaust the heap in the middle of the download. Note that
+// the buffer permanently occupies max-manifest-size bytes (1 KB by default) of
+// .bss, even when no update is in progress.
+unsigned char MANIFEST_BUF[MBED_CONF_ANJAY_MBED_FOTA_MAX_MANIFEST_SIZE];
+
+// Image data is coalesced in a statically allocated buffer as well, so that
+// the download cannot fail halfway through for lack of heap. Only the largest
+// multiple of the block device program size that fits in it is used.
+unsigned char WRITE_BUF[MBED_CONF_ANJAY_MBED_FOTA_WRITE_BUFFER_SIZE];
+
+#if MBED_CONF_ANJAY_MBED_FOTA_COMPRESSION_SUPPORT
+// Compressed images start with this magic, followed by the window and
+// lookahead sizes used by the heatshrink encoder
+constexpr unsigned char HEATSHRINK_MAGIC[] = { 'A', 'H', 'S', '1' };
+
+uint8_t DECOMPRESSION_WINDOW
+        [1 << MBED_CONF_ANJAY_MBED_FOTA_COMPRESSION_MAX_WINDOW_SZ2];
+#endif // MBED_CONF_ANJAY_MBED_FOTA_COMPRESSION_SUPPORT
+
 #if defined(MBED_CONF_ANJAY_MBED_FOTA_UPDATE_CERT)
 constexpr const char UPDATE_CERT_PEM[] =
         AVS_QUOTE_MACRO((MBED_CONF_ANJAY_MBED_FOTA_UPDATE_CERT));
@@ -176,7 +196,9 @@ anjay_fw_update_initial_result_t initial_result_impl() {
 
 void fota_app_on_download_progress(size_t downloaded_size,
                                    size_t current_chunk_size,
-                                   size_t total_size) {}
+                                   size_t total_size) {
+    FotaTelemetry::INSTANCE.progress(downloaded_size, total_size);
+}
 
 int fota_app_on_complete(int32_t status) {
     return FOTA_STATUS_SUCCESS;
@@ -229,6 +251,7 @@ int fota_source_report_update_result(int result) {
 int fota_source_report_state(fota_source_state_e state,
                              report_sent_callback_t on_sent,
                              report_sent_callback_t on_failure) {
+    FotaTelemetry::INSTANCE.state_reported(state);
     if (on_sent) {
         on_sent();
     }
@@ -239,6 +262,7 @@ int fota_source_report_state_in_ms(fota_source_state_e state,
                                    report_sent_callback_t on_sent,
                                    report_sent_callback_t on_failure,
                                    size_t in_ms) {
+    FotaTelemetry::INSTANCE.state_reported(state);
     return FOTA_STATUS_SUCCESS;
 }
 
@@ -295,6 +319,14 @@ MbedCloudFotaGlobal::MbedCloudFotaGlobal() {
     fota_component_desc_info_t desc = { 0 };
     desc.need_reboot = true;
     desc.curr_fw_get_digest = fota_curr_fw_get_digest;
+#if MBED_CONF_ANJAY_MBED_FOTA_DELTA_SUPPORT
+    // Only declares the component as accepting delta payloads. They are
+    // written to the candidate storage as downloaded, like full images; the
+    // full image is reconstructed by the FOTA library, which reads the
+    // running firmware through fota_curr_fw_read().
+    desc.support_delta = true;
+    desc.curr_fw_read = fota_curr_fw_read;
+#endif // MBED_CONF_ANJAY_MBED_FOTA_DELTA_SUPPORT
     result = fota_component_add(&desc, COMPONENT_NAME, semver);
     assert(!result);
 
@@ -309,15 +341,26 @@ anjay_fw_update_initial_result_t MbedCloudFotaGlobal::initial_result() {
 
 MbedCloudFotaFlasher::MbedCloudFotaFlasher()
         : input_offset_(0),
-          manifest_size_(0),
-          header_buf_{ 0 },
-          manifest_buf_() {
+          image_offset_(0),
+          manifest_validator_(),
+#if MBED_CONF_ANJAY_MBED_FOTA_COMPRESSION_SUPPORT
+          image_format_(ImageFormat::UNKNOWN),
+#else  // MBED_CONF_ANJAY_MBED_FOTA_COMPRESSION_SUPPORT
+          image_format_(ImageFormat::RAW),
+#endif // MBED_CONF_ANJAY_MBED_FOTA_COMPRESSION_SUPPORT
+          image_header_{ 0 },
+          image_header_fill_(0),
+          decoder_(),
+          write_buf_size_(0),
+          write_buf_fill_(0) {
     assert(!fota_is_active_update());
     LAST_RESULT = FOTA_STATUS_SUCCESS;
     NEXT_ACTION = NextFotaAction();
 }
 
 MbedCloudFotaFlasher::~MbedCloudFotaFlasher() {
+    // Destroyed before the download has finished, i.e. reset by the server
+    FotaTelemetry::INSTANCE.download_aborted();
     abort();
 }
 
@@ -329,6 +372,7 @@ void MbedCloudFotaFlasher::abort() {
 }
 
 int MbedCloudFotaFlasher::failure() {
+    FotaTelemetry::INSTANCE.download_failed();
     // Note: The numerical values come from
     // https://raw.githubusercontent.com/OpenMobileAlliance/lwm2m-registry/prod/10252.xml
     switch (LAST_RESULT) {
@@ -392,54 +436,21 @@ int MbedCloudFotaFlasher::failure() {
     }
 }
 
-size_t MbedCloudFotaFlasher::read_manifest_length() {
-    unsigned char *p = header_buf_;
-    const unsigned char *const start = p;
-    const unsigned char *const end = p + sizeof(header_buf_);
-    // Pelion FOTA manifests are ASN.1 DER-encoded.
-    // Let's read the outermost length.
-    size_t length = 0;
-    int result = mbedtls_asn1_get_tag(
-            &p, end, &length, MBEDTLS_ASN1_CONSTRUCTED | MBEDTLS_ASN1_SEQUENCE);
-    if (result && result != MBEDTLS_ERR_ASN1_OUT_OF_DATA) {
-        return 0;
-    }
-    // Note: we don't treat MBEDTLS_ERR_ASN1_OUT_OF_DATA as an error condition,
-    // because mbedtls_asn1_get_tag() expects the the end pointer to be beyond
-    // all the data whose length has just been read. The length pointer shall
-    // be now set anyway.
-    if (p == start || !length) {
-        return 0;
+int MbedCloudFotaFlasher::write_manifest(const void *data, size_t data_size) {
+    size_t consumed = 0;
+    if (manifest_validator_.feed(data, data_size, &consumed)) {
+        fota_source_report_update_result(-FOTA_STATUS_MANIFEST_MALFORMED);
+        return failure();
     }
-    return (p - start) + length;
-}
-
-int MbedCloudFotaFlasher::write_header(const void *data, size_t data_size) {
-    assert(input_offset_ <= sizeof(header_buf_));
-    size_t to_write = AVS_MIN(data_size, sizeof(header_buf_) - input_offset_);
-    memcpy(header_buf_ + input_offset_, data, to_write);
-    input_offset_ += to_write;
-    if (input_offset_ >= sizeof(header_buf_)) {
-        if ((manifest_size_ = read_manifest_length()) < sizeof(header_buf_)
-            || !(manifest_buf_ =
-                         std::make_unique<unsigned char[]>(manifest_size_))) {
-            fota_source_report_update_result(-FOTA_STATUS_OUT_OF_MEMORY);
-            return failure();
-        }
-        memcpy(manifest_buf_.get(), header_buf_, sizeof(header_buf_));
+    if (manifest_validator_.total_size() > sizeof(MANIFEST_BUF)) {
+        fota_source_report_update_result(-FOTA_STATUS_OUT_OF_MEMORY);
+        return failure();
     }
-    return 0;
-}
-
-int MbedCloudFotaFlasher::write_manifest(const void *data, size_t data_size) {
-    assert(input_offset_ <= manifest_size_);
-    size_t to_write = AVS_MIN(data_size, manifest_size_ - input_offset_);
-    assert(!to_write || manifest_buf_);
-    memcpy(manifest_buf_.get() + input_offset_, data, to_write);
-    input_offset_ += to_write;
-    if (input_offset_ >= manifest_size_) {
-        fota_on_manifest(manifest_buf_.get(), manifest_size_);
-        manifest_buf_.reset();
+    assert(input_offset_ + consumed <= sizeof(MANIFEST_BUF));
+    memcpy(MANIFEST_BUF + input_offset_, data, consumed);
+    input_offset_ += consumed;
+    if (manifest_validator_.complete()) {
+        fota_on_manifest(MANIFEST_BUF, input_offset_);
         if (!fota_is_active_update()) {
             fota_source_report_update_result(-FOTA_STATUS_MANIFEST_MALFORMED);
             return failure();
@@ -456,29 +467,194 @@ int MbedCloudFotaFlasher::write_manifest(const void *data, size_t data_size) {
             fota_source_report_update_result(-FOTA_STATUS_INTERNAL_ERROR);
             return failure();
         }
+        FotaTelemetry::INSTANCE.phase_started(FotaTelemetry::Phase::DOWNLOAD);
     }
     return 0;
 }
 
-int MbedCloudFotaFlasher::write_image(const void *data, size_t data_size) {
-    int result = fota_ext_downloader_write_image_fragment(
-            data, input_offset_ - manifest_size_, data_size);
+int MbedCloudFotaFlasher::init_write_buffer() {
+    size_t program_size;
+    int result = fota_bd_get_program_size(&program_size);
+    if (result) {
+        return result;
+    }
+    program_size = AVS_MAX(program_size, (size_t) 1);
+    // write-buffer-size must be at least the program size of the candidate
+    // storage, otherwise the writes cannot be aligned
+    assert(program_size <= sizeof(WRITE_BUF));
+    if (program_size > sizeof(WRITE_BUF)) {
+        return FOTA_STATUS_OUT_OF_MEMORY;
+    }
+    // Use a multiple of the program size, so that every write except the last
+    // one is aligned to the program unit and does not cause
+    // a read-modify-write cycle on the candidate storage.
+    write_buf_size_ = sizeof(WRITE_BUF) - sizeof(WRITE_BUF) % program_size;
+    write_buf_fill_ = 0;
+    return 0;
+}
+
+int MbedCloudFotaFlasher::write_image_fragment(const void *data,
+                                               size_t offset,
+                                               size_t size) {
+    const avs_time_monotonic_t start_time = avs_time_monotonic_now();
+    int result = fota_ext_downloader_write_image_fragment(data, offset, size);
+    FotaTelemetry::INSTANCE.flash_write_finished(start_time);
+    return result;
+}
+
+int MbedCloudFotaFlasher::flush_write_buffer() {
+    if (!write_buf_fill_) {
+        return 0;
+    }
+    int result = write_image_fragment(WRITE_BUF,
+                                      image_offset_ - write_buf_fill_,
+                                      write_buf_fill_);
+    if (!result) {
+        write_buf_fill_ = 0;
+    }
+    return result;
+}
+
+int MbedCloudFotaFlasher::store_image(const void *data,
+                                      size_t data_size,
+                                      size_t *out_consumed) {
+    int result = 0;
+    *out_consumed = 0;
+    if (!write_buf_size_) {
+        result = init_write_buffer();
+    }
     if (!result) {
-        input_offset_ += data_size;
+        if (!write_buf_fill_ && data_size >= write_buf_size_) {
+            // Nothing is buffered and at least one whole chunk is available,
+            // so write all the whole chunks directly, without copying.
+            size_t to_write = data_size - data_size % write_buf_size_;
+            result = write_image_fragment(data, image_offset_, to_write);
+            if (!result) {
+                image_offset_ += to_write;
+                *out_consumed = to_write;
+            }
+        } else {
+            size_t to_write =
+                    AVS_MIN(data_size, write_buf_size_ - write_buf_fill_);
+            memcpy(WRITE_BUF + write_buf_fill_, data, to_write);
+            write_buf_fill_ += to_write;
+            image_offset_ += to_write;
+            *out_consumed = to_write;
+            if (write_buf_fill_ == write_buf_size_) {
+                result = flush_write_buffer();
+            }
+        }
+    }
+    return result;
+}
+
+int MbedCloudFotaFlasher::store_whole_image(const void *data,
+                                            size_t data_size) {
+    int result = 0;
+    while (!result && data_size) {
+        size_t consumed = 0;
+        result = store_image(data, data_size, &consumed);
+        data = (const char *) data + consumed;
+        data_size -= consumed;
+    }
+    return result;
+}
+
+int MbedCloudFotaFlasher::read_image_header(const void *data,
+                                            size_t data_size,
+                                            size_t *out_consumed) {
+#if MBED_CONF_ANJAY_MBED_FOTA_COMPRESSION_SUPPORT
+    static_assert(sizeof(image_header_) == sizeof(HEATSHRINK_MAGIC) + 2,
+                  "image_header_ has a wrong size");
+    // Don't consume anything past the magic until we know that the image is
+    // compressed; otherwise the buffered bytes are stored as raw image data.
+    size_t header_size = image_header_fill_ < sizeof(HEATSHRINK_MAGIC)
+                                 ? sizeof(HEATSHRINK_MAGIC)
+                                 : sizeof(image_header_);
+    size_t to_copy = AVS_MIN(data_size, header_size - image_header_fill_);
+    memcpy(image_header_ + image_header_fill_, data, to_copy);
+    image_header_fill_ += to_copy;
+    *out_consumed = to_copy;
+    if (image_header_fill_ == sizeof(HEATSHRINK_MAGIC)
+        && memcmp(image_header_, HEATSHRINK_MAGIC, sizeof(HEATSHRINK_MAGIC))
+                   != 0) {
+        image_format_ = ImageFormat::RAW;
+        return store_whole_image(image_header_, image_header_fill_);
+    }
+    if (image_header_fill_ == sizeof(image_header_)) {
+        if (decoder_.reset(image_header_[sizeof(HEATSHRINK_MAGIC)],
+                           image_header_[sizeof(HEATSHRINK_MAGIC) + 1],
+                           DECOMPRESSION_WINDOW,
+                           sizeof(DECOMPRESSION_WINDOW))) {
+            return FOTA_STATUS_MANIFEST_PAYLOAD_UNSUPPORTED;
+        }
+        image_format_ = ImageFormat::HEATSHRINK;
+    }
+    return 0;
+#else  // MBED_CONF_ANJAY_MBED_FOTA_COMPRESSION_SUPPORT
+    AVS_UNREACHABLE("compression support is disabled");
+    return FOTA_STATUS_INTERNAL_ERROR;
+#endif // MBED_CONF_ANJAY_MBED_FOTA_COMPRESSION_SUPPORT
+}
+
+int MbedCloudFotaFlasher::decompress_image(const void *data,
+                                           size_t data_size,
+                                           size_t *out_consumed) {
+    int result = 0;
+    *out_consumed = 0;
+    if (!write_buf_size_) {
+        result = init_write_buffer();
+    }
+    while (!result) {
+        // Decompress directly into the write buffer, to avoid copying
+        unsigned char *out = WRITE_BUF + write_buf_fill_;
+        size_t consumed = 0;
+        size_t produced =
+                decoder_.decode(data, data_size, &consumed, out,
+                                write_buf_size_ - write_buf_fill_);
+        data = (const char *) data + consumed;
+        data_size -= consumed;
+        *out_consumed += consumed;
+        if (!produced) {
+            break;
+        }
+        write_buf_fill_ += produced;
+        image_offset_ += produced;
+        if (write_buf_fill_ == write_buf_size_) {
+            result = flush_write_buffer();
+        }
+    }
+    return result;
+}
+
+int MbedCloudFotaFlasher::write_image(const void *data, size_t data_size) {
+    size_t consumed = 0;
+    int result = 0;
+    switch (image_format_) {
+    case ImageFormat::UNKNOWN:
+        result = read_image_header(data, data_size, &consumed);
+        break;
+    case ImageFormat::RAW:
+        result = store_image(data, data_size, &consumed);
+        break;
+    case ImageFormat::HEATSHRINK:
+        result = decompress_image(data, data_size, &consumed);
+        break;
     }
     if (result) {
         fota_source_report_update_result(-result);
+    } else {
+        input_offset_ += consumed;
     }
     return result;
 }
 
 int MbedCloudFotaFlasher::write(const void *data, size_t data_size) {
     int result = 0;
+    FotaTelemetry::INSTANCE.bytes_received(data_size);
     while (!result && data_size) {
         size_t original_input_offset = input_offset_;
-        if (!manifest_size_) {
-            result = write_header(data, data_size);
-        } else if (input_offset_ < manifest_size_) {
+        if (!manifest_validator_.complete()) {
             result = write_manifest(data, data_size);
         } else {
             result = write_image(data, data_size);
@@ -494,7 +670,11 @@ int MbedCloudFotaFlasher::write(const void *data, size_t data_size) {
 }
 
 int MbedCloudFotaFlasher::finish() {
-    int result = fota_ext_downloader_on_image_ready();
+    FotaTelemetry::INSTANCE.phase_started(FotaTelemetry::Phase::VERIFY);
+    int result = flush_write_buffer();
+    if (!result) {
+        result = fota_ext_downloader_on_image_ready();
+    }
     if (result) {
         fota_source_report_update_result(-result);
         return failure();
@@ -517,10 +697,12 @@ int MbedCloudFotaFlasher::finish() {
     // If everything went well,
     // fota_app_on_install_authorization() has just been called
     assert(NEXT_ACTION.type() == NextFotaAction::Type::AUTHORIZE);
+    FotaTelemetry::INSTANCE.download_finished();
     return 0;
 }
 
 void MbedCloudFotaFlasher::flash() {
+    FotaTelemetry::INSTANCE.phase_started(FotaTelemetry::Phase::INSTALL);
     if (NEXT_ACTION.type() == NextFotaAction::Type::AUTHORIZE) {
         NEXT_ACTION.perform();
     }
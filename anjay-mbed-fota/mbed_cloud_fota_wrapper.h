@@ -22,6 +22,9 @@
 
 #include <anjay/fw_update.h>
 
+#include "der_stream_validator.h"
+#include "heatshrink_decoder.h"
+
 class MbedCloudFotaGlobal {
     MbedCloudFotaGlobal();
 
@@ -32,20 +35,36 @@ public:
 };
 
 class MbedCloudFotaFlasher {
+    enum class ImageFormat { UNKNOWN, RAW, HEATSHRINK };
+
     size_t input_offset_;
-    size_t manifest_size_;
-    unsigned char header_buf_[8];
-    std::unique_ptr<unsigned char[]> manifest_buf_;
+    size_t image_offset_;
+    DerStreamValidator manifest_validator_;
+    ImageFormat image_format_;
+    unsigned char image_header_[6];
+    size_t image_header_fill_;
+    HeatshrinkDecoder decoder_;
+    size_t write_buf_size_;
+    size_t write_buf_fill_;
 
     MbedCloudFotaFlasher(const MbedCloudFotaFlasher &) = delete;
     MbedCloudFotaFlasher &operator=(const MbedCloudFotaFlasher &) = delete;
 
     void abort();
     int failure();
-    size_t read_manifest_length();
-    int write_header(const void *data, size_t data_size);
     int write_manifest(const void *data, size_t data_size);
     int write_image(const void *data, size_t data_size);
+    int read_image_header(const void *data,
+                          size_t data_size,
+                          size_t *out_consumed);
+    int decompress_image(const void *data,
+                         size_t data_size,
+                         size_t *out_consumed);
+    int store_image(const void *data, size_t data_size, size_t *out_consumed);
+    int store_whole_image(const void *data, size_t data_size);
+    int init_write_buffer();
+    int write_image_fragment(const void *data, size_t offset, size_t size);
+    int flush_write_buffer();
 
 public:
     MbedCloudFotaFlasher();
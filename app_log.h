@@ -0,0 +1,116 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef APP_LOG_H
+#define APP_LOG_H
+
+#include <avsystem/commons/avs_log.h>
+
+/**
+ * Wrapper around avs_log() that additionally filters messages at compile
+ * time, against a minimum level configured per group of modules in
+ * mbed_app.json (e.g. "log_level_network": "WARNING"). Groups that are not
+ * configured explicitly fall back to "log_level_min".
+ *
+ * Calls below the minimum level are placed in a branch with a constant false
+ * condition, so they are optimized out together with their format strings
+ * and argument evaluation, while still being checked by the compiler. The
+ * runtime level set with avs_log_set_default_level() still applies to the
+ * remaining ones.
+ */
+#define APP_LOG(Module, Level, ...)                          \
+    do {                                                     \
+        if (AVS_LOG_##Level >= APP_LOG_MIN_LEVEL_##Module) { \
+            avs_log(Module, Level, __VA_ARGS__);             \
+        }                                                    \
+    } while (0)
+
+#define APP_LOG_LEVEL__(Level) AVS_LOG_##Level
+#define APP_LOG_LEVEL_(Level) APP_LOG_LEVEL__(Level)
+
+#ifdef MBED_CONF_APP_LOG_LEVEL_MIN
+#define APP_LOG_LEVEL_MIN APP_LOG_LEVEL_(MBED_CONF_APP_LOG_LEVEL_MIN)
+#else // MBED_CONF_APP_LOG_LEVEL_MIN
+#define APP_LOG_LEVEL_MIN AVS_LOG_TRACE
+#endif // MBED_CONF_APP_LOG_LEVEL_MIN
+
+#ifdef MBED_CONF_APP_LOG_LEVEL_LWM2M
+#define APP_LOG_LEVEL_LWM2M APP_LOG_LEVEL_(MBED_CONF_APP_LOG_LEVEL_LWM2M)
+#else // MBED_CONF_APP_LOG_LEVEL_LWM2M
+#define APP_LOG_LEVEL_LWM2M APP_LOG_LEVEL_MIN
+#endif // MBED_CONF_APP_LOG_LEVEL_LWM2M
+
+#ifdef MBED_CONF_APP_LOG_LEVEL_NETWORK
+#define APP_LOG_LEVEL_NETWORK APP_LOG_LEVEL_(MBED_CONF_APP_LOG_LEVEL_NETWORK)
+#else // MBED_CONF_APP_LOG_LEVEL_NETWORK
+#define APP_LOG_LEVEL_NETWORK APP_LOG_LEVEL_MIN
+#endif // MBED_CONF_APP_LOG_LEVEL_NETWORK
+
+#ifdef MBED_CONF_APP_LOG_LEVEL_OBJECTS
+#define APP_LOG_LEVEL_OBJECTS APP_LOG_LEVEL_(MBED_CONF_APP_LOG_LEVEL_OBJECTS)
+#else // MBED_CONF_APP_LOG_LEVEL_OBJECTS
+#define APP_LOG_LEVEL_OBJECTS APP_LOG_LEVEL_MIN
+#endif // MBED_CONF_APP_LOG_LEVEL_OBJECTS
+
+#ifdef MBED_CONF_APP_LOG_LEVEL_PERSISTENCE
+#define APP_LOG_LEVEL_PERSISTENCE \
+    APP_LOG_LEVEL_(MBED_CONF_APP_LOG_LEVEL_PERSISTENCE)
+#else // MBED_CONF_APP_LOG_LEVEL_PERSISTENCE
+#define APP_LOG_LEVEL_PERSISTENCE APP_LOG_LEVEL_MIN
+#endif // MBED_CONF_APP_LOG_LEVEL_PERSISTENCE
+
+#ifdef MBED_CONF_APP_LOG_LEVEL_SMS
+#define APP_LOG_LEVEL_SMS APP_LOG_LEVEL_(MBED_CONF_APP_LOG_LEVEL_SMS)
+#else // MBED_CONF_APP_LOG_LEVEL_SMS
+#define APP_LOG_LEVEL_SMS APP_LOG_LEVEL_MIN
+#endif // MBED_CONF_APP_LOG_LEVEL_SMS
+
+#ifdef MBED_CONF_APP_LOG_LEVEL_STATS
+#define APP_LOG_LEVEL_STATS APP_LOG_LEVEL_(MBED_CONF_APP_LOG_LEVEL_STATS)
+#else // MBED_CONF_APP_LOG_LEVEL_STATS
+#define APP_LOG_LEVEL_STATS APP_LOG_LEVEL_MIN
+#endif // MBED_CONF_APP_LOG_LEVEL_STATS
+
+#ifdef MBED_CONF_APP_LOG_LEVEL_FW_UPDATE
+#define APP_LOG_LEVEL_FW_UPDATE \
+    APP_LOG_LEVEL_(MBED_CONF_APP_LOG_LEVEL_FW_UPDATE)
+#else // MBED_CONF_APP_LOG_LEVEL_FW_UPDATE
+#define APP_LOG_LEVEL_FW_UPDATE APP_LOG_LEVEL_MIN
+#endif // MBED_CONF_APP_LOG_LEVEL_FW_UPDATE
+
+// Assignment of avs_log modules to the groups above
+#define APP_LOG_MIN_LEVEL_lwm2m APP_LOG_LEVEL_LWM2M
+#define APP_LOG_MIN_LEVEL_network APP_LOG_LEVEL_NETWORK
+#define APP_LOG_MIN_LEVEL_modem_bg96 APP_LOG_LEVEL_NETWORK
+#define APP_LOG_MIN_LEVEL_accelerometer_obj APP_LOG_LEVEL_OBJECTS
+#define APP_LOG_MIN_LEVEL_barometer_obj APP_LOG_LEVEL_OBJECTS
+#define APP_LOG_MIN_LEVEL_conn_mon_obj APP_LOG_LEVEL_OBJECTS
+#define APP_LOG_MIN_LEVEL_device_obj APP_LOG_LEVEL_OBJECTS
+#define APP_LOG_MIN_LEVEL_fota_stats_obj APP_LOG_LEVEL_OBJECTS
+#define APP_LOG_MIN_LEVEL_humidity_obj APP_LOG_LEVEL_OBJECTS
+#define APP_LOG_MIN_LEVEL_joystick_obj APP_LOG_LEVEL_OBJECTS
+#define APP_LOG_MIN_LEVEL_magnetometer_obj APP_LOG_LEVEL_OBJECTS
+#define APP_LOG_MIN_LEVEL_system_health_obj APP_LOG_LEVEL_OBJECTS
+#define APP_LOG_MIN_LEVEL_persistence APP_LOG_LEVEL_PERSISTENCE
+#define APP_LOG_MIN_LEVEL_sms_driver APP_LOG_LEVEL_SMS
+#define APP_LOG_MIN_LEVEL_boot_timing APP_LOG_LEVEL_STATS
+#define APP_LOG_MIN_LEVEL_latency APP_LOG_LEVEL_STATS
+#define APP_LOG_MIN_LEVEL_mbed_stats APP_LOG_LEVEL_STATS
+#define APP_LOG_MIN_LEVEL_wakeup_stats APP_LOG_LEVEL_STATS
+#define APP_LOG_MIN_LEVEL_fw_update APP_LOG_LEVEL_FW_UPDATE
+
+#endif // APP_LOG_H
@@ -34,14 +34,14 @@
 #include <anjay/anjay.h>
 #include <avsystem/commons/avs_defs.h>
 #include <avsystem/commons/avs_list.h>
-#include <avsystem/commons/avs_log.h>
-#include <avsystem/commons/avs_memory.h>
-
-#include <XNucleoIKS01A2.h>
 
+#include "app_log.h"
 #include "barometer.h"
+#include "client_local.h"
+#include "sensor_backend.h"
+#include "static_object_storage.h"
 
-#define BAROMETER_OBJ_LOG(...) avs_log(barometer_obj, __VA_ARGS__)
+#define BAROMETER_OBJ_LOG(...) APP_LOG(barometer_obj, __VA_ARGS__)
 
 #define BAROMETER_OID 3315
 
@@ -103,7 +103,7 @@ constexpr double VALUE_SCALE = 100.0;
 
 typedef struct barometer_struct {
     const anjay_dm_object_def_t *def;
-    LPS22HBSensor *sensor;
+    SensorBackend *sensors;
     float min_value;
     float max_value;
     float curr_value;
@@ -245,21 +245,24 @@ struct ObjDef : public anjay_dm_object_def_t {
     }
 } const OBJ_DEF;
 
+CLIENT_LOCAL StaticObjectStorage<barometer_t> OBJ_STORAGE;
+
 const anjay_dm_object_def_t **barometer_object_create(void) {
-    LPS22HBSensor *sensor = XNucleoIKS01A2::instance(D14, D15)->pt_sensor;
+    SensorBackend &sensors = sensor_backend();
     float sensor_value;
-    if (sensor->enable() || sensor->get_pressure(&sensor_value)) {
+    if (sensors.enable(SensorType::BAROMETER)
+        || sensors.read_scalar(SensorType::BAROMETER, &sensor_value)) {
         BAROMETER_OBJ_LOG(WARNING, "Failed to initialize barometer");
         return NULL;
     }
 
-    barometer_t *obj = (barometer_t *) avs_calloc(1, sizeof(barometer_t));
+    barometer_t *obj = OBJ_STORAGE.construct();
     if (!obj) {
-        (void) sensor->disable();
+        (void) sensors.disable(SensorType::BAROMETER);
         return NULL;
     }
     obj->def = &OBJ_DEF;
-    obj->sensor = sensor;
+    obj->sensors = &sensors;
     obj->curr_value = sensor_value;
     reset_min_max_values(obj);
 
@@ -268,12 +271,11 @@ const anjay_dm_object_def_t **barometer_object_create(void) {
 
 void barometer_object_release(const anjay_dm_object_def_t **def) {
     if (def) {
-        barometer_t *obj = get_obj(def);
-        avs_free(obj);
+        OBJ_STORAGE.destroy();
     }
 }
 
-const anjay_dm_object_def_t **OBJ_DEF_PTR;
+CLIENT_LOCAL const anjay_dm_object_def_t **OBJ_DEF_PTR;
 
 } // namespace
 
@@ -308,7 +310,7 @@ void barometer_object_update(anjay_t *anjay) {
     barometer_t *obj = get_obj(OBJ_DEF_PTR);
 
     float value;
-    if (obj->sensor->get_pressure(&value)) {
+    if (obj->sensors->read_scalar(SensorType::BAROMETER, &value)) {
         BAROMETER_OBJ_LOG(ERROR, "Failed to get pressure");
         return;
     }
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "boot_timing.h"
+
+#include <chrono>
+#include <mbed.h>
+
+#include "app_log.h"
+
+namespace {
+
+constexpr uint32_t NOT_REACHED = UINT32_MAX;
+
+const char *const BOOT_PHASE_NAMES[BOOT_PHASE_COUNT] = {
+    "configuration loaded", "network up", "registered"
+};
+
+// Kernel time is counted from reset, so it can be used directly
+uint32_t BOOT_PHASE_MS[BOOT_PHASE_COUNT] = { NOT_REACHED, NOT_REACHED,
+                                             NOT_REACHED };
+
+} // namespace
+
+void boot_timing_mark(BootPhase phase) {
+    const size_t index = static_cast<size_t>(phase);
+    const uint32_t now_ms =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                    Kernel::Clock::now().time_since_epoch())
+                    .count();
+    uint32_t expected = NOT_REACHED;
+    if (core_util_atomic_cas_u32(&BOOT_PHASE_MS[index], &expected, now_ms)) {
+        APP_LOG(boot_timing, INFO, "boot: %s after %lu ms",
+                BOOT_PHASE_NAMES[index], (unsigned long) now_ms);
+    }
+}
+
+int64_t boot_timing_get_ms(BootPhase phase) {
+    const uint32_t value = core_util_atomic_load_u32(
+            &BOOT_PHASE_MS[static_cast<size_t>(phase)]);
+    return value == NOT_REACHED ? -1 : value;
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BOOT_TIMING_H
+#define BOOT_TIMING_H
+
+#include <cstddef>
+#include <cstdint>
+
+enum class BootPhase { CONFIG_LOADED, NETWORK_UP, REGISTERED };
+
+constexpr size_t BOOT_PHASE_COUNT = 3;
+
+/**
+ * Records the time since reset at which @p phase has been reached for the
+ * first time. Subsequent calls for the same phase are ignored, so that
+ * reconnections do not overwrite the boot timings.
+ *
+ * May be called from any thread.
+ */
+void boot_timing_mark(BootPhase phase);
+
+/**
+ * @returns Time since reset, in milliseconds, at which @p phase has been
+ *          reached, or -1 if it has not been reached yet.
+ */
+int64_t boot_timing_get_ms(BootPhase phase);
+
+#endif // BOOT_TIMING_H
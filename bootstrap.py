@@ -110,7 +110,7 @@ def _load_cert_as_der(cert_file):
     return cert
 
 
-def _prepare_fota_config(app_config, manifest_config, update_certificate):
+def _prepare_fota_config(app_config, manifest_config, update_certificate, compression):
     if manifest_config is None:
         manifest_config = _get_or_create_manifest_dev_config()
 
@@ -132,6 +132,8 @@ def _prepare_fota_config(app_config, manifest_config, update_certificate):
         update_certificate).decode()
     app_config['target_overrides']['*']['anjay-mbed-fota.vendor-id'] = vendor_id
     app_config['target_overrides']['*']['anjay-mbed-fota.class-id'] = class_id
+    if compression:
+        app_config['target_overrides']['*']['anjay-mbed-fota.compression-support'] = True
     with open(APP_CONFIG_FILE, 'w') as f:
         json.dump(app_config, f, indent=4)
         f.write('\n')
@@ -146,6 +148,8 @@ def _main(args):
                         help='Configuration file for manifest-tool. If not provided, a development configuration will be used and created if necessary.')
     parser.add_argument('--update-certificate', type=str,
                         help='Certificate file that will be used for verifying the update images. May be empty for development configuration.')
+    parser.add_argument('--compression', action='store_true',
+                        help='Enable support for compressed firmware images, as generated by firmwarize.py --compress')
     args = parser.parse_args(args)
 
     with _safe_chdir(ROOT_DIR):
@@ -162,7 +166,8 @@ def _main(args):
         fota_enable = _traverse_config(config,
                                        ['target_overrides', args.target, 'anjay-mbed-fota.enable'])
         if fota_enable:
-            _prepare_fota_config(config, args.manifest_config, args.update_certificate)
+            _prepare_fota_config(config, args.manifest_config, args.update_certificate,
+                                 args.compression)
 
 
 if __name__ == '__main__':
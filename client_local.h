@@ -0,0 +1,33 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CLIENT_LOCAL_H
+#define CLIENT_LOCAL_H
+
+/**
+ * Storage class of variables that belong to a single LwM2M client, e.g. the
+ * state of application Objects. The device runs exactly one client, so these
+ * are plain globals. The host fleet simulator (host/fleet_main.cpp) runs one
+ * client per thread and is built with APP_CLIENT_PER_THREAD, which gives each
+ * client its own copy.
+ */
+#ifdef APP_CLIENT_PER_THREAD
+#define CLIENT_LOCAL thread_local
+#else // APP_CLIENT_PER_THREAD
+#define CLIENT_LOCAL
+#endif // APP_CLIENT_PER_THREAD
+
+#endif // CLIENT_LOCAL_H
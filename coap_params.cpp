@@ -0,0 +1,43 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "coap_params.h"
+
+#include <cstring>
+
+#include <avsystem/commons/avs_time.h>
+
+avs_coap_udp_tx_params_t coap_udp_tx_params() {
+    avs_coap_udp_tx_params_t params;
+    memset(&params, 0, sizeof(params));
+    params.ack_timeout = avs_time_duration_from_scalar(
+            MBED_CONF_APP_COAP_ACK_TIMEOUT_MS, AVS_TIME_MS);
+    params.ack_random_factor = 1.5;
+    params.max_retransmit = MBED_CONF_APP_COAP_MAX_RETRANSMIT;
+    params.nstart = 1;
+    return params;
+}
+
+int coap_max_transmit_wait_s() {
+    const avs_coap_udp_tx_params_t tx_params = coap_udp_tx_params();
+    int64_t max_transmit_wait_ms;
+    if (avs_time_duration_to_scalar(
+                &max_transmit_wait_ms, AVS_TIME_MS,
+                avs_coap_udp_max_transmit_wait(&tx_params))) {
+        return -1;
+    }
+    return (int) ((max_transmit_wait_ms + 999) / 1000);
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COAP_PARAMS_H
+#define COAP_PARAMS_H
+
+#include <avsystem/coap/udp.h>
+
+/**
+ * CoAP/UDP transmission parameters used by the client, as configured with
+ * coap_ack_timeout_ms and coap_max_retransmit in mbed_app.json.
+ */
+avs_coap_udp_tx_params_t coap_udp_tx_params();
+
+/**
+ * MAX_TRANSMIT_WAIT for coap_udp_tx_params(), rounded up to whole seconds.
+ * This is how long Anjay keeps listening for incoming messages after the
+ * last exchange when in queue mode, and thus the PSM active time requested
+ * from the modem.
+ */
+int coap_max_transmit_wait_s();
+
+#endif // COAP_PARAMS_H
@@ -36,12 +36,13 @@
 #include <CellularInterface.h>
 #include <anjay/anjay.h>
 #include <avsystem/commons/avs_defs.h>
-#include <avsystem/commons/avs_log.h>
-#include <avsystem/commons/avs_memory.h>
 
+#include "app_log.h"
+#include "client_local.h"
 #include "conn_monitoring_object.h"
+#include "static_object_storage.h"
 
-#define CONN_MONITORING_OBJ_LOG(...) avs_log(conn_mon_obj, __VA_ARGS__)
+#define CONN_MONITORING_OBJ_LOG(...) APP_LOG(conn_mon_obj, __VA_ARGS__)
 
 /**
  * Network Bearer: R, Single, Mandatory
@@ -377,11 +378,12 @@ struct ObjDef : public anjay_dm_object_def_t {
     }
 } const OBJ_DEF;
 
+CLIENT_LOCAL StaticObjectStorage<connectivity_monitoring_t> OBJ_STORAGE;
+
 const anjay_dm_object_def_t **
 connectivity_monitoring_object_create(mbed::CellularContext *cell_ctx,
                                       mbed::CellularNetwork *net) {
-    connectivity_monitoring_t *obj = (connectivity_monitoring_t *) avs_calloc(
-            1, sizeof(connectivity_monitoring_t));
+    connectivity_monitoring_t *obj = OBJ_STORAGE.construct();
     if (!obj) {
         return NULL;
     }
@@ -394,13 +396,12 @@ connectivity_monitoring_object_create(mbed::CellularContext *cell_ctx,
 void connectivity_monitoring_object_release(
         const anjay_dm_object_def_t ***def) {
     if (*def) {
-        connectivity_monitoring_t *obj = get_obj(*def);
-        avs_free(obj);
+        OBJ_STORAGE.destroy();
         *def = NULL;
     }
 }
 
-const anjay_dm_object_def_t **OBJ_DEF_PTR;
+CLIENT_LOCAL const anjay_dm_object_def_t **OBJ_DEF_PTR;
 
 } // namespace
 
@@ -0,0 +1,237 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "connection_manager.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <chrono>
+
+#include "app_log.h"
+#include "wakeup_stats.h"
+
+namespace {
+
+constexpr uint32_t LINK_UP_FLAG = 1 << 0;
+constexpr uint32_t STOPPED_FLAG = 1 << 1;
+
+constexpr uint32_t RETRY_MIN_DELAY_MS =
+        MBED_CONF_APP_NETWORK_RETRY_MIN_DELAY_MS;
+constexpr uint32_t RETRY_MAX_DELAY_MS =
+        MBED_CONF_APP_NETWORK_RETRY_MAX_DELAY_MS;
+constexpr std::chrono::milliseconds CONNECT_TIMEOUT{
+    MBED_CONF_APP_NETWORK_CONNECT_TIMEOUT_MS
+};
+
+static_assert(RETRY_MIN_DELAY_MS > 0
+                      && RETRY_MIN_DELAY_MS <= RETRY_MAX_DELAY_MS
+                      && RETRY_MAX_DELAY_MS <= UINT32_MAX / 2,
+              "invalid network retry delays");
+
+} // namespace
+
+ConnectionManager::ConnectionManager()
+        : netif_(),
+          queue_(),
+          link_flags_(),
+          link_callback_(),
+          retry_event_(0),
+          timeout_event_(0),
+          retry_delay_ms_(RETRY_MIN_DELAY_MS),
+          jitter_state_(1) {}
+
+void ConnectionManager::set_link_callback(
+        mbed::Callback<void(bool)> link_callback) {
+    assert(!netif_);
+    link_callback_ = link_callback;
+}
+
+int ConnectionManager::start(NetworkInterface *netif,
+                             events::EventQueue *queue) {
+    assert(!netif_);
+    netif_ = netif;
+    queue_ = queue;
+    retry_delay_ms_ = RETRY_MIN_DELAY_MS;
+    // Timing of the modem and the network differs enough between devices to
+    // desynchronize their retries; xorshift state must not be zero
+    jitter_state_ = us_ticker_read() | 1;
+    link_flags_.clear();
+
+    netif_->attach(callback(this, &ConnectionManager::on_status_change));
+    nsapi_error_t err = netif_->set_blocking(false);
+    if (err != NSAPI_ERROR_OK) {
+        APP_LOG(network, ERROR, "cannot switch to non-blocking mode: %d",
+                err);
+    } else if (!queue_->call(this, &ConnectionManager::connect)) {
+        APP_LOG(network, ERROR, "cannot schedule connection");
+        err = NSAPI_ERROR_NO_MEMORY;
+    }
+    if (err != NSAPI_ERROR_OK) {
+        netif_->attach(nullptr);
+        netif_ = nullptr;
+        return -1;
+    }
+    return 0;
+}
+
+void ConnectionManager::stop() {
+    NetworkInterface *netif = netif_;
+    if (!netif) {
+        return;
+    }
+    netif->attach(nullptr);
+    // Pending events may only be safely cancelled from the queue itself
+    link_flags_.clear(STOPPED_FLAG);
+    while (!queue_->call(this, &ConnectionManager::shut_down)) {
+        ThisThread::sleep_for(10ms);
+    }
+    link_flags_.wait_any(STOPPED_FLAG);
+
+    netif->set_blocking(true);
+    netif->disconnect();
+    link_flags_.clear();
+}
+
+bool ConnectionManager::link_up() const {
+    return link_flags_.get() & LINK_UP_FLAG;
+}
+
+void ConnectionManager::on_status_change(nsapi_event_t event,
+                                         intptr_t value) {
+    // Called from the network stack context, which may be an interrupt
+    if (event == NSAPI_EVENT_CONNECTION_STATUS_CHANGE) {
+        queue_->call(this, &ConnectionManager::handle_status,
+                     static_cast<nsapi_connection_status_t>(value));
+    }
+}
+
+void ConnectionManager::handle_status(nsapi_connection_status_t status) {
+    WakeupScope wakeup(WakeupCause::NETWORK_EVENT);
+    if (!netif_) {
+        return;
+    }
+    switch (status) {
+    case NSAPI_STATUS_GLOBAL_UP:
+        cancel_event(&timeout_event_);
+        cancel_event(&retry_event_);
+        retry_delay_ms_ = RETRY_MIN_DELAY_MS;
+        set_link_up(true);
+        break;
+    case NSAPI_STATUS_DISCONNECTED:
+        cancel_event(&timeout_event_);
+        set_link_up(false);
+        if (!retry_event_) {
+            schedule_retry();
+        }
+        break;
+    default:
+        // Connection is still in progress
+        break;
+    }
+}
+
+void ConnectionManager::set_link_up(bool up) {
+    if (up == link_up()) {
+        return;
+    }
+    if (up) {
+        APP_LOG(network, INFO, "link up");
+        link_flags_.set(LINK_UP_FLAG);
+    } else {
+        APP_LOG(network, WARNING, "link down");
+        link_flags_.clear(LINK_UP_FLAG);
+    }
+    if (link_callback_) {
+        link_callback_(up);
+    }
+}
+
+void ConnectionManager::connect() {
+    WakeupScope wakeup(WakeupCause::NETWORK_EVENT);
+    retry_event_ = 0;
+    if (!netif_) {
+        return;
+    }
+    APP_LOG(network, INFO, "connecting");
+    nsapi_error_t err = netif_->connect();
+    switch (err) {
+    case NSAPI_ERROR_IS_CONNECTED:
+        handle_status(netif_->get_connection_status());
+        return;
+    case NSAPI_ERROR_OK:
+    case NSAPI_ERROR_IN_PROGRESS:
+    case NSAPI_ERROR_ALREADY:
+    case NSAPI_ERROR_BUSY:
+        // Result will be reported through the status callback
+        break;
+    default:
+        APP_LOG(network, WARNING, "connect failed: %d", err);
+        schedule_retry();
+        return;
+    }
+    if (!timeout_event_) {
+        timeout_event_ = queue_->call_in(
+                CONNECT_TIMEOUT, this, &ConnectionManager::connect_timed_out);
+    }
+}
+
+void ConnectionManager::connect_timed_out() {
+    timeout_event_ = 0;
+    if (!netif_) {
+        return;
+    }
+    APP_LOG(network, WARNING, "connection timed out");
+    netif_->disconnect();
+    if (!retry_event_) {
+        schedule_retry();
+    }
+}
+
+void ConnectionManager::schedule_retry() {
+    const uint32_t delay_ms = next_retry_delay_ms();
+    APP_LOG(network, INFO, "retrying in %lu ms", (unsigned long) delay_ms);
+    retry_event_ = queue_->call_in(std::chrono::milliseconds(delay_ms), this,
+                                   &ConnectionManager::connect);
+}
+
+void ConnectionManager::cancel_event(int *event) {
+    if (*event) {
+        queue_->cancel(*event);
+        *event = 0;
+    }
+}
+
+void ConnectionManager::shut_down() {
+    cancel_event(&timeout_event_);
+    cancel_event(&retry_event_);
+    netif_ = nullptr;
+    set_link_up(false);
+    link_flags_.set(STOPPED_FLAG);
+}
+
+uint32_t ConnectionManager::next_retry_delay_ms() {
+    // xorshift32 is good enough to spread retries of many devices in time
+    jitter_state_ ^= jitter_state_ << 13;
+    jitter_state_ ^= jitter_state_ >> 17;
+    jitter_state_ ^= jitter_state_ << 5;
+
+    // Half of the delay is fixed, the other half is random
+    const uint32_t half = retry_delay_ms_ / 2;
+    const uint32_t delay_ms =
+            retry_delay_ms_ - half + jitter_state_ % (half + 1);
+    retry_delay_ms_ = std::min(retry_delay_ms_ * 2, RETRY_MAX_DELAY_MS);
+    return delay_ms;
+}
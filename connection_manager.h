@@ -0,0 +1,87 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CONNECTION_MANAGER_H
+#define CONNECTION_MANAGER_H
+
+#include <cstdint>
+
+#include <mbed.h>
+
+/**
+ * Keeps a NetworkInterface connected.
+ *
+ * The interface is switched to non-blocking mode and its status changes are
+ * tracked through the status callback. If connecting fails, times out or the
+ * link is lost later on, another attempt is made after a delay that grows
+ * exponentially (with random jitter) up to a configured maximum, and is reset
+ * once the link is up again.
+ *
+ * All the work is done on the event queue passed to start(); status getters
+ * may be called from any thread, and link changes are also reported through
+ * the callback set with set_link_callback().
+ */
+class ConnectionManager {
+    NetworkInterface *netif_;
+    events::EventQueue *queue_;
+    rtos::EventFlags link_flags_;
+    mbed::Callback<void(bool)> link_callback_;
+    int retry_event_;
+    int timeout_event_;
+    uint32_t retry_delay_ms_;
+    uint32_t jitter_state_;
+
+    ConnectionManager(const ConnectionManager &) = delete;
+    ConnectionManager &operator=(const ConnectionManager &) = delete;
+
+    void on_status_change(nsapi_event_t event, intptr_t value);
+    void handle_status(nsapi_connection_status_t status);
+    void set_link_up(bool up);
+    void connect();
+    void connect_timed_out();
+    void schedule_retry();
+    void cancel_event(int *event);
+    void shut_down();
+    uint32_t next_retry_delay_ms();
+
+public:
+    ConnectionManager();
+
+    /**
+     * Sets the function called with the new state of the link whenever it
+     * goes up or down, including when stop() takes it down. It is called
+     * from the event queue passed to start(), so it must not block. Must not
+     * be called while the manager is started.
+     */
+    void set_link_callback(mbed::Callback<void(bool)> link_callback);
+
+    /**
+     * Starts connecting @p netif; all callbacks are dispatched on @p queue.
+     *
+     * @returns 0 on success, negative value otherwise.
+     */
+    int start(NetworkInterface *netif, events::EventQueue *queue);
+
+    /**
+     * Stops reconnecting and disconnects the interface. Must not be called
+     * from the event queue passed to start().
+     */
+    void stop();
+
+    bool link_up() const;
+};
+
+#endif // CONNECTION_MANAGER_H
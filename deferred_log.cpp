@@ -0,0 +1,157 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "deferred_log.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include <mbed.h>
+
+namespace {
+
+// Each record consists of a 16-bit length followed by that many bytes of
+// the message, possibly wrapped around the end of the buffer
+constexpr size_t RECORD_HEADER_SIZE = sizeof(uint16_t);
+constexpr size_t BUFFER_SIZE = MBED_CONF_APP_LOG_BUFFER_SIZE;
+constexpr uint32_t DATA_AVAILABLE_FLAG = 1;
+
+// Offsets are reduced modulo BUFFER_SIZE, which must thus divide the range
+// of size_t, so that the arithmetic stays correct when they wrap around
+static_assert(BUFFER_SIZE > RECORD_HEADER_SIZE && BUFFER_SIZE <= UINT16_MAX
+                      && !(BUFFER_SIZE & (BUFFER_SIZE - 1)),
+              "log buffer size must be a power of two, at most 32768");
+
+uint8_t BUFFER[BUFFER_SIZE];
+// Offsets grow monotonically and are only reduced modulo BUFFER_SIZE when
+// accessing the buffer, so that a full buffer can be told from an empty one.
+// WRITE_OFFSET is only modified by writers and READ_OFFSET by the log thread,
+// both with BUFFER_MUTEX held.
+size_t READ_OFFSET;
+size_t WRITE_OFFSET;
+uint32_t DROPPED;
+
+rtos::Mutex BUFFER_MUTEX;
+// Held while printing, so that messages are printed in order, either by the
+// log thread or synchronously by deferred_log_write()
+rtos::Mutex PRINT_MUTEX;
+rtos::EventFlags FLAGS;
+rtos::Thread THREAD(osPriorityLow,
+                    MBED_CONF_APP_LOG_THREAD_STACK_SIZE,
+                    nullptr,
+                    "log");
+
+void copy_in(size_t offset, const void *data, size_t size) {
+    const size_t start = offset % BUFFER_SIZE;
+    const size_t first_part = std::min(size, BUFFER_SIZE - start);
+    memcpy(&BUFFER[start], data, first_part);
+    memcpy(BUFFER, (const uint8_t *) data + first_part, size - first_part);
+}
+
+/**
+ * Prints the oldest message from the buffer, if any. Shall be called with
+ * PRINT_MUTEX held.
+ *
+ * @returns true if a message has been printed, false if the buffer is empty.
+ */
+bool print_message() {
+    size_t read_offset;
+    {
+        ScopedMutexLock lock(BUFFER_MUTEX);
+        if (READ_OFFSET == WRITE_OFFSET) {
+            return false;
+        }
+        read_offset = READ_OFFSET;
+    }
+    // Writers never modify data that has not been read yet, so the record
+    // is printed straight from the buffer, without holding the lock
+    uint16_t length;
+    const size_t header_start = read_offset % BUFFER_SIZE;
+    if (BUFFER_SIZE - header_start >= sizeof(length)) {
+        memcpy(&length, &BUFFER[header_start], sizeof(length));
+    } else {
+        ((uint8_t *) &length)[0] = BUFFER[header_start];
+        ((uint8_t *) &length)[1] = BUFFER[0];
+    }
+    const size_t start = (read_offset + RECORD_HEADER_SIZE) % BUFFER_SIZE;
+    const size_t first_part = std::min<size_t>(length, BUFFER_SIZE - start);
+    fwrite(&BUFFER[start], 1, first_part, stdout);
+    fwrite(BUFFER, 1, length - first_part, stdout);
+    fputc('\n', stdout);
+
+    ScopedMutexLock lock(BUFFER_MUTEX);
+    READ_OFFSET = read_offset + RECORD_HEADER_SIZE + length;
+    return true;
+}
+
+void log_thread() {
+    uint32_t reported_dropped = 0;
+    while (true) {
+        FLAGS.wait_any(DATA_AVAILABLE_FLAG);
+        ScopedMutexLock lock(PRINT_MUTEX);
+        while (print_message()) {
+        }
+        const uint32_t dropped = deferred_log_dropped();
+        if (dropped != reported_dropped) {
+            printf("[%lu log messages dropped]\n",
+                   (unsigned long) (dropped - reported_dropped));
+            reported_dropped = dropped;
+        }
+    }
+}
+
+} // namespace
+
+int deferred_log_start() {
+    if (THREAD.start(log_thread) != osOK) {
+        return -1;
+    }
+    // Print whatever has been logged before
+    FLAGS.set(DATA_AVAILABLE_FLAG);
+    return 0;
+}
+
+void deferred_log_write(avs_log_level_t level, const char *message) {
+    if (level >= AVS_LOG_ERROR) {
+        // An error may be followed by a crash, which would lose whatever is
+        // still buffered, so flush the buffer and print it right away
+        ScopedMutexLock lock(PRINT_MUTEX);
+        while (print_message()) {
+        }
+        puts(message);
+        return;
+    }
+    const size_t length =
+            std::min(strlen(message), BUFFER_SIZE - RECORD_HEADER_SIZE);
+    const uint16_t header = (uint16_t) length;
+    {
+        ScopedMutexLock lock(BUFFER_MUTEX);
+        if (BUFFER_SIZE - (WRITE_OFFSET - READ_OFFSET)
+            < RECORD_HEADER_SIZE + length) {
+            core_util_atomic_incr_u32(&DROPPED, 1);
+            return;
+        }
+        copy_in(WRITE_OFFSET, &header, sizeof(header));
+        copy_in(WRITE_OFFSET + RECORD_HEADER_SIZE, message, length);
+        WRITE_OFFSET += RECORD_HEADER_SIZE + length;
+    }
+    FLAGS.set(DATA_AVAILABLE_FLAG);
+}
+
+uint32_t deferred_log_dropped() {
+    return core_util_atomic_load_u32(&DROPPED);
+}
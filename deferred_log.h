@@ -0,0 +1,50 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DEFERRED_LOG_H
+#define DEFERRED_LOG_H
+
+#include <cstdint>
+
+#include <avsystem/commons/avs_log.h>
+
+/**
+ * Starts a low-priority thread that writes the buffered log messages to
+ * the console. Messages written before that are buffered as well.
+ *
+ * @returns 0 on success, negative value otherwise.
+ */
+int deferred_log_start();
+
+/**
+ * Copies @p message into a ring buffer, to be printed later on by the
+ * logging thread, so that the caller does not wait for the UART. If the
+ * buffer is full, the message is dropped and counted.
+ *
+ * Messages of level ERROR and above are printed synchronously instead, after
+ * all the messages still in the buffer, so that none of them is lost if the
+ * error is followed by a crash.
+ *
+ * May be used as (a part of) an avs_log handler.
+ */
+void deferred_log_write(avs_log_level_t level, const char *message);
+
+/**
+ * @returns Total number of messages dropped because the buffer was full.
+ */
+uint32_t deferred_log_dropped();
+
+#endif // DEFERRED_LOG_H
@@ -318,6 +318,19 @@ void show_menu_and_maybe_update_config(Lwm2mConfig &config) {
                                            ? "ENABLED"
                                            : "DISABLED";
                         }),
+                SerialConfigMenuEntry(
+                        "LwM2M Queue Mode",
+                        [&]() {
+                            cached_config.queue_mode_enabled =
+                                    !cached_config.queue_mode_enabled;
+                            return SerialConfigMenuEntry::MenuLoopAction::
+                                    CONTINUE;
+                        },
+                        [&]() {
+                            return cached_config.queue_mode_enabled
+                                           ? "ENABLED"
+                                           : "DISABLED";
+                        }),
                 SerialConfigMenuEntry(
                         "LwM2M client log level",
                         [&]() {
@@ -448,6 +461,7 @@ Lwm2mConfig::Lwm2mConfig()
                                         PSK_IDENTITY,
                                         PSK_KEY),
                       false,
+                      MBED_CONF_APP_QUEUE_MODE,
                       AVS_LOG_DEBUG
 #ifdef ANJAY_WITH_LWM2M11
                       ,
@@ -470,6 +484,7 @@ const char *rg_server_psk_identity = "rg_server_psk_identity";
 const char *rg_server_psk_key = "rg_server_psk_key";
 
 const char *persistence_enabled = "persistence_enabled";
+const char *queue_mode_enabled = "queue_mode_enabled";
 const char *log_level = "log_level";
 #ifdef ANJAY_WITH_LM2M11
 const char *maximum_version = "maximum_version";
@@ -542,6 +557,21 @@ int key_persistence(Lwm2mConfigPersistence::Direction direction,
     return -1;
 }
 
+// For keys added in later versions of the application: a configuration
+// stored by an older version does not contain them, and the default value
+// is kept instead of failing the whole restore
+template <typename T>
+int optional_key_persistence(Lwm2mConfigPersistence::Direction direction,
+                             const char *key,
+                             T &value) {
+    int result = key_persistence(direction, key, value);
+    if (direction == Lwm2mConfigPersistence::Direction::RESTORE
+        && result == MBED_ERROR_ITEM_NOT_FOUND) {
+        return 0;
+    }
+    return result;
+}
+
 } // namespace
 
 int Lwm2mConfigPersistence::persistence(Direction direction,
@@ -590,6 +620,11 @@ int Lwm2mConfigPersistence::persistence(Direction direction,
             || (result = key_persistence(direction, rat,
                                          config.modem_config.rat))
 #endif // MBED_CONF_TARGET_NETWORK_DEFAULT_INTERFACE_TYPE == CELLULAR
+            // Keys added later must go last, so that the ones above are
+            // restored even if reading one of these fails
+            || (result = optional_key_persistence(direction,
+                                                  queue_mode_enabled,
+                                                  config.queue_mode_enabled))
     );
     return result;
 }
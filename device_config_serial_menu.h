@@ -62,6 +62,16 @@ struct ModemConfig {
     mbed::CellularNetwork::RadioAccessTechnology rat;
 
     ModemConfig();
+
+    bool operator==(const ModemConfig &other) const {
+        return apn == other.apn && username == other.username
+               && password == other.password
+               && sim_pin_code == other.sim_pin_code && rat == other.rat;
+    }
+
+    bool operator!=(const ModemConfig &other) const {
+        return !(*this == other);
+    }
 };
 #endif // MBED_CONF_TARGET_NETWORK_DEFAULT_INTERFACE_TYPE == CELLULAR
 
@@ -69,6 +79,7 @@ struct Lwm2mConfig {
     Lwm2mServerConfig bs_server_config;
     Lwm2mServerConfig rg_server_config;
     bool persistence_enabled;
+    bool queue_mode_enabled;
     avs_log_level_t log_level;
 #ifdef ANJAY_WITH_LWM2M11
     anjay_lwm2m_version_t maximum_version;
@@ -80,6 +91,7 @@ struct Lwm2mConfig {
     Lwm2mConfig(Lwm2mServerConfig &&bs_server_config,
                 Lwm2mServerConfig &&rg_server_config,
                 bool persistence_enabled,
+                bool queue_mode_enabled,
                 avs_log_level_t log_level
 #ifdef ANJAY_WITH_LWM2M11
                 ,
@@ -89,6 +101,7 @@ struct Lwm2mConfig {
             : bs_server_config(std::move(bs_server_config)),
               rg_server_config(std::move(rg_server_config)),
               persistence_enabled(persistence_enabled),
+              queue_mode_enabled(queue_mode_enabled),
               log_level(log_level)
 #ifdef ANJAY_WITH_LWM2M11
               ,
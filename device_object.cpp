@@ -29,14 +29,16 @@
 
 #include <anjay/anjay.h>
 #include <avsystem/commons/avs_defs.h>
-#include <avsystem/commons/avs_log.h>
-#include <avsystem/commons/avs_memory.h>
+#include <avsystem/commons/avs_time.h>
 
 #include "mbed_power_mgmt.h"
 
+#include "app_log.h"
+#include "client_local.h"
 #include "device_object.h"
+#include "static_object_storage.h"
 
-#define DEVICE_OBJ_LOG(...) avs_log(device_obj, __VA_ARGS__)
+#define DEVICE_OBJ_LOG(...) APP_LOG(device_obj, __VA_ARGS__)
 
 /**
  * Manufacturer: R, Single, Optional
@@ -117,13 +119,31 @@
  */
 #define RID_SOFTWARE_VERSION 19
 
+/**
+ * Minimum adjustment of the real-time clock, relative to the monotonic clock,
+ * that is notified as a change of Current Time. Both clocks only have a 1 s
+ * resolution on some targets.
+ */
+#define CURRENT_TIME_JUMP_THRESHOLD_S 2
+
 typedef struct device_struct {
     const anjay_dm_object_def_t *def;
 
     avs_time_duration_t current_time_offset;
+    // Real time minus monotonic time, as of the last notified Current Time
+    avs_time_duration_t real_time_base;
+    // Number of reads of Current Time, by LwM2M Servers and by the
+    // observation engine
+    uint32_t current_time_reads;
     bool reboot;
 } device_t;
 
+static avs_time_duration_t real_time_base(void) {
+    return avs_time_duration_diff(
+            avs_time_real_now().since_real_epoch,
+            avs_time_monotonic_now().since_monotonic_epoch);
+}
+
 static inline device_t *get_obj(const anjay_dm_object_def_t *const *obj_ptr) {
     assert(obj_ptr);
     return AVS_CONTAINER_OF(obj_ptr, device_t, def);
@@ -224,6 +244,7 @@ static int resource_read(anjay_t *anjay,
 
     case RID_CURRENT_TIME: {
         assert(riid == ANJAY_ID_INVALID);
+        ++obj->current_time_reads;
         int64_t seconds_since_unix_epoch;
         if (avs_time_real_to_scalar(
                     &seconds_since_unix_epoch, AVS_TIME_S,
@@ -342,24 +363,26 @@ struct ObjDef : public anjay_dm_object_def_t {
     }
 } const OBJ_DEF;
 
+CLIENT_LOCAL StaticObjectStorage<device_t> OBJ_STORAGE;
+
 const anjay_dm_object_def_t **device_object_create(void) {
-    device_t *obj = (device_t *) avs_calloc(1, sizeof(device_t));
+    device_t *obj = OBJ_STORAGE.construct();
     if (!obj) {
         return NULL;
     }
     obj->def = &OBJ_DEF;
+    obj->real_time_base = real_time_base();
     return &obj->def;
 }
 
 void device_object_release(const anjay_dm_object_def_t ***def) {
     if (*def) {
-        device_t *obj = get_obj(*def);
-        avs_free(obj);
+        OBJ_STORAGE.destroy();
         *def = NULL;
     }
 }
 
-const anjay_dm_object_def_t **OBJ_DEF_PTR;
+CLIENT_LOCAL const anjay_dm_object_def_t **OBJ_DEF_PTR;
 
 } // namespace
 
@@ -392,5 +415,23 @@ void device_object_update(anjay_t *anjay) {
         DEVICE_OBJ_LOG(INFO, "Rebooting...\n");
         system_reset();
     }
-    anjay_notify_changed(anjay, 3, 0, RID_CURRENT_TIME);
+
+    // Current Time is computed on read, so it is only notified when the
+    // real-time clock is adjusted; otherwise, observers are expected to rely
+    // on pmax. Writes by a LwM2M Server are notified by Anjay itself.
+    const avs_time_duration_t base = real_time_base();
+    int64_t jump_s = 0;
+    (void) avs_time_duration_to_scalar(
+            &jump_s, AVS_TIME_S,
+            avs_time_duration_diff(base, obj->real_time_base));
+    if (jump_s >= CURRENT_TIME_JUMP_THRESHOLD_S
+        || jump_s <= -CURRENT_TIME_JUMP_THRESHOLD_S) {
+        DEVICE_OBJ_LOG(INFO, "Real-time clock has been adjusted");
+        obj->real_time_base = base;
+        anjay_notify_changed(anjay, 3, 0, RID_CURRENT_TIME);
+    }
+}
+
+uint32_t device_object_current_time_reads(void) {
+    return OBJ_DEF_PTR ? get_obj(OBJ_DEF_PTR)->current_time_reads : 0;
 }
@@ -17,6 +17,8 @@
 #ifndef DEVICE_OBJECT_H
 #define DEVICE_OBJECT_H
 
+#include <stdint.h>
+
 #include <anjay/anjay.h>
 
 int device_object_install(anjay_t *anjay);
@@ -25,4 +27,13 @@ void device_object_uninstall(anjay_t *anjay);
 
 void device_object_update(anjay_t *anjay);
 
+/**
+ * @returns Number of times Current Time has been read since the Device Object
+ *          has been installed. Each notification of the Resource, or of the
+ *          Instance containing it, makes Anjay read it for every matching
+ *          observation, so this measures the work of the observation engine
+ *          caused by the Resource.
+ */
+uint32_t device_object_current_time_reads(void);
+
 #endif // DEVICE_OBJECT_H
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "event_loop.h"
+
+#include <mbed.h>
+
+#include <algorithm>
+
+#include <avsystem/commons/avs_list.h>
+#include <avsystem/commons/avs_socket.h>
+
+#include "app_log.h"
+#include "latency_histogram.h"
+#include "wakeup_stats.h"
+
+namespace {
+
+// Anjay uses one socket per connection to a LwM2M Server, plus one for an
+// ongoing firmware download
+constexpr size_t MAX_SOCKETS = 8;
+
+} // namespace
+
+EventLoop::EventLoop(anjay_t *anjay, int max_wait_ms)
+        : anjay_(anjay), max_wait_ms_(max_wait_ms), interrupted_(false) {}
+
+bool EventLoop::job_due() {
+    int delay_ms;
+    return !anjay_sched_time_to_next_ms(anjay_, &delay_ms) && delay_ms <= 0;
+}
+
+int EventLoop::run() {
+    while (!core_util_atomic_load_bool(&interrupted_)) {
+        struct pollfd fds[MAX_SOCKETS];
+        avs_net_socket_t *sockets[MAX_SOCKETS];
+        size_t socket_count = 0;
+
+        AVS_LIST(avs_net_socket_t *const) socket;
+        AVS_LIST_FOREACH(socket, anjay_get_sockets(anjay_)) {
+            const void *system_socket = avs_net_socket_get_system(*socket);
+            if (!system_socket) {
+                continue;
+            }
+            if (socket_count == MAX_SOCKETS) {
+                APP_LOG(lwm2m, WARNING, "too many sockets, some are ignored");
+                break;
+            }
+            fds[socket_count].fd = *(const int *) system_socket;
+            fds[socket_count].events = POLLIN;
+            fds[socket_count].revents = 0;
+            sockets[socket_count++] = *socket;
+        }
+
+        int next_job_ms;
+        const bool job_scheduled =
+                !anjay_sched_time_to_next_ms(anjay_, &next_job_ms);
+        const uint32_t wait_start = latency_timestamp();
+        const int ready = poll(fds, socket_count, wait_time_ms());
+        if (ready < 0) {
+            APP_LOG(lwm2m, ERROR, "poll() failed");
+            return -1;
+        }
+
+        // Jobs scheduled from other threads are run by whatever wakes the
+        // loop up next; a timeout with no job due is a wasted wakeup
+        const bool woken_for_job = ready == 0 && job_due();
+        WakeupCause cause = WakeupCause::LOOP_TIMEOUT;
+        if (ready > 0) {
+            cause = WakeupCause::INCOMING_PACKET;
+        } else if (woken_for_job) {
+            cause = WakeupCause::SCHEDULED_JOB;
+        }
+        WakeupScope wakeup(cause);
+        if (woken_for_job && job_scheduled) {
+            const uint32_t waited_us = latency_elapsed_us(wait_start);
+            const uint32_t due_us = (uint32_t) std::max(next_job_ms, 0) * 1000;
+            // Otherwise, the job that is due has been scheduled meanwhile
+            if (waited_us >= due_us) {
+                latency_histogram_record_us(LatencyHistogramId::EVENT_LOOP_LAG,
+                                            waited_us - due_us);
+            }
+        }
+        for (size_t i = 0; ready > 0 && i < socket_count; ++i) {
+            if (fds[i].revents) {
+                LatencyScope latency(LatencyHistogramId::SOCKET_SERVE);
+                anjay_serve(anjay_, sockets[i]);
+            }
+        }
+        if (job_due()) {
+            LatencyScope latency(LatencyHistogramId::SCHED_RUN);
+            anjay_sched_run(anjay_);
+        }
+    }
+    return 0;
+}
+
+void EventLoop::interrupt() {
+    core_util_atomic_store_bool(&interrupted_, true);
+}
+
+int EventLoop::wait_time_ms() {
+    if (max_wait_ms_ >= 0) {
+        return anjay_sched_calculate_wait_time_ms(anjay_, max_wait_ms_);
+    }
+    // anjay_sched_calculate_wait_time_ms() treats the limit as a plain number
+    int delay_ms;
+    if (anjay_sched_time_to_next_ms(anjay_, &delay_ms)) {
+        return -1;
+    }
+    return std::max(delay_ms, 0);
+}
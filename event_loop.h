@@ -0,0 +1,77 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include <anjay/anjay.h>
+
+/**
+ * Event loop of an Anjay instance, used instead of anjay_event_loop_run()
+ * so that the time spent sleeping is only limited by the scheduler, and so
+ * that every wakeup is accounted (see wakeup_stats.h).
+ *
+ * Each iteration waits for incoming packets for as long as
+ * anjay_sched_calculate_wait_time_ms() allows, serves the sockets that are
+ * ready and runs the jobs that are due. The wait is additionally limited by
+ * the maximum wait passed to the constructor, which bounds the latency of
+ * jobs scheduled from other threads: they cannot wake the loop up.
+ *
+ * How late the loop wakes up for jobs, and how long each socket serve and
+ * scheduler run take, are recorded in the latency histograms.
+ */
+class EventLoop {
+    anjay_t *anjay_;
+    int max_wait_ms_;
+    bool interrupted_;
+
+    EventLoop(const EventLoop &) = delete;
+    EventLoop &operator=(const EventLoop &) = delete;
+
+    bool job_due();
+
+public:
+    /**
+     * @param max_wait_ms Maximum time to sleep, in milliseconds; negative
+     *                    value means that the loop sleeps until the next job
+     *                    is due or a packet arrives.
+     */
+    EventLoop(anjay_t *anjay, int max_wait_ms);
+
+    /**
+     * Runs the loop until interrupt() is called.
+     *
+     * @returns 0 if interrupted, negative value if waiting for packets
+     *          failed.
+     */
+    int run();
+
+    /**
+     * Makes run() return. May be called from any thread; when called from
+     * another thread than the one running the loop, it takes effect after
+     * at most the maximum wait.
+     */
+    void interrupt();
+
+    /**
+     * @returns Time the loop may sleep for before the next job is due, in
+     *          milliseconds, limited by the maximum wait; negative value if
+     *          there is no limit.
+     */
+    int wait_time_ms();
+};
+
+#endif // EVENT_LOOP_H
@@ -108,11 +108,42 @@ def get_default_output_name(input_file, target):
                                                         target=target, version=version)
 
 
-def pack_firmware(input_file, output_file, manifest_config, manifest_tool_args):
+def create_delta(python, current_file, input_file, delta_file):
+    logging.debug('Using manifest-delta-tool')
+    command = [python, '-m', 'manifesttool.delta_tool.delta_tool', '-c', current_file, '-n',
+               input_file, '-o', delta_file]
+    logging.debug('Running: %r', command)
+    subprocess.check_call(command)
+    logging.info('Delta size: %d bytes (full image: %d bytes)', os.path.getsize(delta_file),
+                 os.path.getsize(input_file))
+
+
+HEATSHRINK_MAGIC = b'AHS1'
+
+
+def compress_image(image, window_sz2, lookahead_sz2):
+    try:
+        import heatshrink2
+    except ImportError:
+        logging.error('heatshrink2 is required for compression: python3 -m pip install heatshrink2')
+        raise
+
+    compressed = heatshrink2.compress(image, window_sz2=window_sz2, lookahead_sz2=lookahead_sz2)
+    logging.info('Compressed image size: %d bytes (uncompressed: %d bytes)', len(compressed),
+                 len(image))
+    return HEATSHRINK_MAGIC + bytes([window_sz2, lookahead_sz2]) + compressed
+
+
+def pack_firmware(input_file, output_file, manifest_config, manifest_tool_args,
+                  delta_from=None, compression=None):
     PYTHON = sys.executable or 'python3'
     DUMMY_URL = ' '
     with contextlib.ExitStack() as stack:
         manifest_file = stack.enter_context(tempfile.NamedTemporaryFile())
+        if delta_from is not None:
+            delta_file = stack.enter_context(tempfile.NamedTemporaryFile())
+            create_delta(PYTHON, delta_from, input_file, delta_file.name)
+            input_file = delta_file.name
         if manifest_config is None:
             logging.debug('Using manifest-dev-tool')
             command = [PYTHON, '-m', 'manifesttool.dev_tool.dev_tool', 'create', '-u', DUMMY_URL,
@@ -122,7 +153,8 @@ def pack_firmware(input_file, output_file, manifest_config, manifest_tool_args):
             import yaml
             manifest_config = yaml.safe_load(manifest_config)
             manifest_config['payload']['file-path'] = input_file
-            manifest_config['payload']['format'] = 'raw-binary'
+            manifest_config['payload']['format'] = (
+                'raw-binary' if delta_from is None else 'arm-patch-stream')
             modified_manifest_config = stack.enter_context(tempfile.NamedTemporaryFile())
             yaml.safe_dump(manifest_config, modified_manifest_config)
             modified_manifest_config.flush()
@@ -137,7 +169,11 @@ def pack_firmware(input_file, output_file, manifest_config, manifest_tool_args):
             with open(manifest_file.name, 'rb') as manifest:
                 f.write(manifest.read())
             with open(input_file, 'rb') as image:
-                f.write(image.read())
+                image = image.read()
+                # The manifest always describes the uncompressed payload
+                if compression is not None:
+                    image = compress_image(image, *compression)
+                f.write(image)
 
     logging.info('DONE! Grab your %s', output_file)
 
@@ -167,6 +203,14 @@ def _main(args):
                         help='Overwrite existing output file if one exists', action='store_true')
     parser.add_argument('--manifest-config', type=str,
                         help='Configuration file for manifest-tool. If not provided, a development configuration will be used.')
+    parser.add_argument('--delta-from', type=str,
+                        help='Currently deployed *_update.bin file. If provided, a delta package against it will be created instead of a full image. Requires anjay-mbed-fota.delta-support to be enabled on the device.')
+    parser.add_argument('--compress', action='store_true',
+                        help='Compress the image with heatshrink. Requires anjay-mbed-fota.compression-support to be enabled on the device.')
+    parser.add_argument('--compress-window-sz2', type=int, default=10,
+                        help='Base-2 logarithm of the heatshrink window size; must not be larger than anjay-mbed-fota.compression-max-window-sz2 (default: 10)')
+    parser.add_argument('--compress-lookahead-sz2', type=int, default=4,
+                        help='Base-2 logarithm of the heatshrink lookahead size (default: 4)')
     parser.add_argument('manifest_tool_args', type=str, nargs='*',
                         help='Additional arguments passed to manifest-tool or manifest-dev-tool')
     args = parser.parse_args(args)
@@ -205,7 +249,16 @@ def _main(args):
             'Input filename (%s) does not end with _update.bin, did you pass the correct input file?',
             args.input)
 
-    pack_firmware(args.input, args.output, args.manifest_config, args.manifest_tool_args)
+    if args.delta_from and not os.path.exists(args.delta_from):
+        logging.error('Firmware image %s does not exists, use --delta-from', args.delta_from)
+        return 1
+
+    compression = None
+    if args.compress:
+        compression = (args.compress_window_sz2, args.compress_lookahead_sz2)
+
+    pack_firmware(args.input, args.output, args.manifest_config, args.manifest_tool_args,
+                  args.delta_from, compression)
     return 0
 
 
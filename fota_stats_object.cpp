@@ -0,0 +1,296 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * LwM2M Object: FOTA Statistics
+ * ID: 26241, Vendor-specific, Optional, Single
+ *
+ * Timing and throughput statistics of the firmware update process. Unless
+ * stated otherwise, the values concern the most recent update attempt.
+ */
+#ifdef MBED_CLOUD_CLIENT_FOTA_ENABLE
+
+#include <assert.h>
+#include <stdbool.h>
+
+#include <anjay/anjay.h>
+#include <avsystem/commons/avs_defs.h>
+
+#include "app_log.h"
+#include "client_local.h"
+#include "fota_stats_object.h"
+#include "fota_telemetry.h"
+#include "static_object_storage.h"
+
+#define FOTA_STATS_OBJ_LOG(...) APP_LOG(fota_stats_obj, __VA_ARGS__)
+
+/**
+ * Attempts: R, Single, Mandatory
+ * type: integer, range: N/A, unit: N/A
+ * Number of firmware download attempts since boot. Values larger than 1
+ * mean that the download has been retried.
+ */
+#define RID_ATTEMPTS 0
+
+/**
+ * Failures: R, Single, Mandatory
+ * type: integer, range: N/A, unit: N/A
+ * Number of failed firmware update attempts since boot.
+ */
+#define RID_FAILURES 1
+
+/**
+ * Last State: R, Single, Mandatory
+ * type: integer, range: N/A, unit: N/A
+ * Last state reported by the FOTA library (fota_source_state_e), or -1 if
+ * none has been reported yet.
+ */
+#define RID_LAST_STATE 2
+
+/**
+ * Manifest Time: R, Single, Mandatory
+ * type: integer, range: N/A, unit: ms
+ * Time between opening the download stream and accepting the manifest.
+ */
+#define RID_MANIFEST_TIME 3
+
+/**
+ * Download Time: R, Single, Mandatory
+ * type: integer, range: N/A, unit: ms
+ * Time spent on downloading the firmware image, after the manifest.
+ */
+#define RID_DOWNLOAD_TIME 4
+
+/**
+ * Verify Time: R, Single, Mandatory
+ * type: integer, range: N/A, unit: ms
+ * Time spent on verifying the downloaded image.
+ */
+#define RID_VERIFY_TIME 5
+
+/**
+ * Install Time: R, Single, Mandatory
+ * type: integer, range: N/A, unit: ms
+ * Time elapsed since the installation has been requested. The device
+ * reboots during installation, so this is only non-zero if the installation
+ * has failed or is still in progress.
+ */
+#define RID_INSTALL_TIME 6
+
+/**
+ * Bytes Downloaded: R, Single, Mandatory
+ * type: integer, range: N/A, unit: B
+ * Number of bytes received, including the manifest.
+ */
+#define RID_BYTES_DOWNLOADED 7
+
+/**
+ * Throughput: R, Single, Mandatory
+ * type: integer, range: N/A, unit: B/s
+ * Average download speed, including the time spent on the manifest.
+ */
+#define RID_THROUGHPUT 8
+
+/**
+ * Flash Write Count: R, Single, Mandatory
+ * type: integer, range: N/A, unit: N/A
+ * Number of writes to the candidate storage.
+ */
+#define RID_FLASH_WRITE_COUNT 9
+
+/**
+ * Flash Write Time: R, Single, Mandatory
+ * type: integer, range: N/A, unit: ms
+ * Total time spent on writing to the candidate storage.
+ */
+#define RID_FLASH_WRITE_TIME 10
+
+static const anjay_rid_t RIDS[] = {
+    RID_ATTEMPTS,         RID_FAILURES,         RID_LAST_STATE,
+    RID_MANIFEST_TIME,    RID_DOWNLOAD_TIME,    RID_VERIFY_TIME,
+    RID_INSTALL_TIME,     RID_BYTES_DOWNLOADED, RID_THROUGHPUT,
+    RID_FLASH_WRITE_COUNT, RID_FLASH_WRITE_TIME
+};
+
+typedef struct fota_stats_struct {
+    const anjay_dm_object_def_t *def;
+    uint32_t last_generation;
+} fota_stats_t;
+
+static inline fota_stats_t *
+get_obj(const anjay_dm_object_def_t *const *obj_ptr) {
+    assert(obj_ptr);
+    return AVS_CONTAINER_OF(obj_ptr, fota_stats_t, def);
+}
+
+static int list_resources(anjay_t *anjay,
+                          const anjay_dm_object_def_t *const *obj_ptr,
+                          anjay_iid_t iid,
+                          anjay_dm_resource_list_ctx_t *ctx) {
+    (void) anjay;
+    (void) obj_ptr;
+    (void) iid;
+
+    for (size_t i = 0; i < AVS_ARRAY_SIZE(RIDS); ++i) {
+        anjay_dm_emit_res(ctx, RIDS[i], ANJAY_DM_RES_R, ANJAY_DM_RES_PRESENT);
+    }
+    return 0;
+}
+
+static int ret_duration_ms(anjay_output_ctx_t *ctx,
+                           avs_time_duration_t duration) {
+    int64_t ms;
+    if (avs_time_duration_to_scalar(&ms, AVS_TIME_MS, duration)) {
+        return ANJAY_ERR_INTERNAL;
+    }
+    return anjay_ret_i64(ctx, ms);
+}
+
+static int resource_read(anjay_t *anjay,
+                         const anjay_dm_object_def_t *const *obj_ptr,
+                         anjay_iid_t iid,
+                         anjay_rid_t rid,
+                         anjay_riid_t riid,
+                         anjay_output_ctx_t *ctx) {
+    (void) anjay;
+    (void) obj_ptr;
+    (void) riid;
+    assert(iid == 0);
+    assert(riid == ANJAY_ID_INVALID);
+
+    const FotaTelemetry &telemetry = FotaTelemetry::INSTANCE;
+
+    switch (rid) {
+    case RID_ATTEMPTS:
+        return anjay_ret_i64(ctx, telemetry.attempts());
+
+    case RID_FAILURES:
+        return anjay_ret_i64(ctx, telemetry.failures());
+
+    case RID_LAST_STATE:
+        return anjay_ret_i32(ctx, telemetry.last_state());
+
+    case RID_MANIFEST_TIME:
+        return ret_duration_ms(ctx, telemetry.phase_duration(
+                                            FotaTelemetry::Phase::MANIFEST));
+
+    case RID_DOWNLOAD_TIME:
+        return ret_duration_ms(ctx, telemetry.phase_duration(
+                                            FotaTelemetry::Phase::DOWNLOAD));
+
+    case RID_VERIFY_TIME:
+        return ret_duration_ms(ctx, telemetry.phase_duration(
+                                            FotaTelemetry::Phase::VERIFY));
+
+    case RID_INSTALL_TIME:
+        return ret_duration_ms(ctx, telemetry.phase_duration(
+                                            FotaTelemetry::Phase::INSTALL));
+
+    case RID_BYTES_DOWNLOADED:
+        return anjay_ret_i64(ctx, (int64_t) telemetry.bytes_downloaded());
+
+    case RID_THROUGHPUT:
+        return anjay_ret_i64(ctx, telemetry.throughput());
+
+    case RID_FLASH_WRITE_COUNT:
+        return anjay_ret_i64(ctx, telemetry.flash_writes());
+
+    case RID_FLASH_WRITE_TIME:
+        return ret_duration_ms(ctx, telemetry.flash_write_time());
+
+    default:
+        return ANJAY_ERR_METHOD_NOT_ALLOWED;
+    }
+}
+
+namespace {
+
+struct ObjDef : public anjay_dm_object_def_t {
+    ObjDef() : anjay_dm_object_def_t() {
+        oid = FOTA_STATS_OID;
+
+        handlers.list_instances = anjay_dm_list_instances_SINGLE;
+
+        handlers.list_resources = list_resources;
+        handlers.resource_read = resource_read;
+
+        handlers.transaction_begin = anjay_dm_transaction_NOOP;
+        handlers.transaction_validate = anjay_dm_transaction_NOOP;
+        handlers.transaction_commit = anjay_dm_transaction_NOOP;
+        handlers.transaction_rollback = anjay_dm_transaction_NOOP;
+    }
+} const OBJ_DEF;
+
+CLIENT_LOCAL StaticObjectStorage<fota_stats_t> OBJ_STORAGE;
+
+const anjay_dm_object_def_t **fota_stats_object_create(void) {
+    fota_stats_t *obj = OBJ_STORAGE.construct();
+    if (!obj) {
+        return NULL;
+    }
+    obj->def = &OBJ_DEF;
+    obj->last_generation = FotaTelemetry::INSTANCE.generation();
+    return &obj->def;
+}
+
+void fota_stats_object_release(const anjay_dm_object_def_t ***def) {
+    if (*def) {
+        OBJ_STORAGE.destroy();
+        *def = NULL;
+    }
+}
+
+CLIENT_LOCAL const anjay_dm_object_def_t **OBJ_DEF_PTR;
+
+} // namespace
+
+int fota_stats_object_install(anjay_t *anjay) {
+    if (OBJ_DEF_PTR) {
+        FOTA_STATS_OBJ_LOG(ERROR,
+                           "FOTA Statistics Object has been already installed");
+        return -1;
+    }
+
+    OBJ_DEF_PTR = fota_stats_object_create();
+    return anjay_register_object(anjay, OBJ_DEF_PTR);
+}
+
+void fota_stats_object_uninstall(anjay_t *anjay) {
+    if (OBJ_DEF_PTR) {
+        if (anjay_unregister_object(anjay, OBJ_DEF_PTR)) {
+            FOTA_STATS_OBJ_LOG(
+                    ERROR, "Error during unregistering FOTA Statistics Object");
+        }
+        fota_stats_object_release(&OBJ_DEF_PTR);
+    }
+}
+
+void fota_stats_object_update(anjay_t *anjay) {
+    if (!OBJ_DEF_PTR) {
+        return;
+    }
+    fota_stats_t *obj = get_obj(OBJ_DEF_PTR);
+
+    const uint32_t generation = FotaTelemetry::INSTANCE.generation();
+    if (generation != obj->last_generation) {
+        obj->last_generation = generation;
+        for (size_t i = 0; i < AVS_ARRAY_SIZE(RIDS); ++i) {
+            (void) anjay_notify_changed(anjay, FOTA_STATS_OID, 0, RIDS[i]);
+        }
+    }
+}
+
+#endif // MBED_CLOUD_CLIENT_FOTA_ENABLE
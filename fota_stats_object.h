@@ -0,0 +1,44 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FOTA_STATS_OBJECT_H
+#define FOTA_STATS_OBJECT_H
+
+#include <anjay/anjay.h>
+
+#ifdef MBED_CLOUD_CLIENT_FOTA_ENABLE
+
+#define FOTA_STATS_OID 26241
+
+int fota_stats_object_install(anjay_t *anjay);
+
+void fota_stats_object_uninstall(anjay_t *anjay);
+
+void fota_stats_object_update(anjay_t *anjay);
+
+#else  // MBED_CLOUD_CLIENT_FOTA_ENABLE
+
+static inline int fota_stats_object_install(anjay_t *anjay) {
+    return 0;
+}
+
+static inline void fota_stats_object_uninstall(anjay_t *anjay) {}
+
+static inline void fota_stats_object_update(anjay_t *anjay) {}
+
+#endif // MBED_CLOUD_CLIENT_FOTA_ENABLE
+
+#endif // FOTA_STATS_OBJECT_H
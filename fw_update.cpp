@@ -20,15 +20,16 @@
 
 #include "fw_update.h"
 
+#include "app_log.h"
+#include "fota_telemetry.h"
 #include "mbed_cloud_fota_wrapper.h"
 
 #include <anjay/fw_update.h>
 
-#include <avsystem/commons/avs_log.h>
 
 #include <cstdlib>
 
-#define LOG(...) avs_log(fw_update, __VA_ARGS__)
+#define LOG(...) APP_LOG(fw_update, __VA_ARGS__)
 
 using namespace std;
 
@@ -40,6 +41,8 @@ public:
 
     void reset_firmware() {
         flasher_.reset();
+        // In case it has been reset before the first block was written
+        FotaTelemetry::INSTANCE.download_aborted();
     }
 
     void perform_upgrade() {
@@ -76,6 +79,7 @@ int fw_update_stream_open(void *user_ptr,
     FirmwareUpdateContext *ctx =
             reinterpret_cast<FirmwareUpdateContext *>(user_ptr);
     ctx->reset_firmware();
+    FotaTelemetry::INSTANCE.download_started();
     return 0;
 }
 
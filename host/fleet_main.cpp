@@ -0,0 +1,510 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * Fleet simulator: runs many independent instances of the client in a single
+ * Linux process, e.g. for load testing of a LwM2M Server. Every client runs
+ * its own Anjay event loop in a dedicated thread, with the complete set of
+ * application Objects; the application is built with APP_CLIENT_PER_THREAD
+ * so that the Objects of different clients do not share any state.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include <CellularNetwork.h>
+#include <XNucleoIKS01A2.h>
+#include <kvstore_global_api/kvstore_global_api.h>
+
+#include <anjay/access_control.h>
+#include <anjay/anjay.h>
+#include <anjay/anjay_config.h>
+#include <anjay/security.h>
+#include <anjay/server.h>
+#ifdef ANJAY_WITH_NET_STATS
+#include <anjay/stats.h>
+#endif // ANJAY_WITH_NET_STATS
+#include <avsystem/commons/avs_log.h>
+
+#include "app_log.h"
+#include "deferred_log.h"
+#include "host_alloc_stats.h"
+#include "host_common.h"
+#include "host_sensor_replay.h"
+#include "object_registry.h"
+#include "persistence.h"
+
+namespace {
+
+struct FleetConfig {
+    size_t client_count = 10;
+    std::string endpoint_prefix = MBED_CONF_APP_ENDPOINT_NAME;
+    std::string server_uri = "coap://127.0.0.1:5683";
+    int32_t lifetime = 50;
+    uint32_t stagger_ms = 100;
+    // 0 means the same schedule as on the device
+    uint32_t sample_period_ms = 0;
+    bool persistence_enabled = false;
+    // 0 means until interrupted
+    uint32_t duration_s = 0;
+    uint32_t report_period_s = 10;
+    bool verbose = false;
+    std::string sensor_trace;
+    double replay_speed = 1.0;
+    bool replay_loop = false;
+};
+
+// Published periodically by the thread of the client, read by the main thread
+struct ClientStats {
+    std::atomic<bool> running{ false };
+    std::atomic<int64_t> heap_bytes{ 0 };
+    std::atomic<int64_t> heap_peak_bytes{ 0 };
+    std::atomic<uint64_t> tx_bytes{ 0 };
+    std::atomic<uint64_t> rx_bytes{ 0 };
+    std::atomic<uint64_t> retransmissions{ 0 };
+};
+
+struct Client {
+    size_t index;
+    std::string endpoint_name;
+    ClientStats stats;
+    std::thread thread;
+};
+
+constexpr uint32_t STATS_PUBLISH_PERIOD_MS = 1000;
+
+// Offset of the synthetic sensor readings between consecutive clients
+constexpr double SENSOR_TIME_OFFSET_S = 37.0;
+
+std::atomic<bool> STOP{ false };
+
+void print_usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [-n COUNT] [-e ENDPOINT_PREFIX] [-u SERVER_URI]\n"
+            "          [-l LIFETIME] [-s STAGGER_MS] [-t SAMPLE_PERIOD_MS]\n"
+            "          [-p] [-d DURATION] [-i REPORT_PERIOD] [-v]\n"
+            "          [-S SENSOR_TRACE [-x SPEED] [-L]]\n"
+            "\n"
+            "  -n  number of clients (default: 10)\n"
+            "  -e  endpoint name prefix; clients are named PREFIX-<index>\n"
+            "      (default: %s)\n"
+            "  -u  NoSec LwM2M Server URI (default: coap://127.0.0.1:5683)\n"
+            "  -l  registration lifetime in seconds (default: 50)\n"
+            "  -s  delay between starting consecutive clients, in\n"
+            "      milliseconds (default: 100)\n"
+            "  -t  sample the sensors every SAMPLE_PERIOD_MS milliseconds,\n"
+            "      whether observed or not (default: as on the device)\n"
+            "  -p  enable persistence, kept in memory\n"
+            "  -d  stop after DURATION seconds (default: run until "
+            "interrupted)\n"
+            "  -i  statistics report period in seconds (default: 10)\n"
+            "  -v  log messages of all levels, not only warnings and errors\n"
+            "  -S  replay sensor readings from a CSV trace instead of\n"
+            "      generating synthetic ones; each client is shifted by\n"
+            "      %.0f s of trace time\n"
+            "  -x  trace replay speed (default: 1.0)\n"
+            "  -L  start the trace over after its last reading\n",
+            argv0, MBED_CONF_APP_ENDPOINT_NAME, SENSOR_TIME_OFFSET_S);
+}
+
+int parse_uint(const char *arg, uint32_t *out) {
+    char *endptr = nullptr;
+    const unsigned long value = strtoul(arg, &endptr, 10);
+    if (!*arg || *endptr || value > UINT32_MAX) {
+        return -1;
+    }
+    *out = (uint32_t) value;
+    return 0;
+}
+
+int parse_args(int argc, char **argv, FleetConfig *config) {
+    int opt;
+    uint32_t value;
+    while ((opt = getopt(argc, argv, "n:e:u:l:s:t:pd:i:vS:x:Lh")) != -1) {
+        switch (opt) {
+        case 'n':
+            if (parse_uint(optarg, &value) || !value) {
+                fprintf(stderr, "invalid number of clients: %s\n", optarg);
+                return -1;
+            }
+            config->client_count = value;
+            break;
+        case 'e':
+            config->endpoint_prefix = optarg;
+            break;
+        case 'u':
+            config->server_uri = optarg;
+            break;
+        case 'l':
+            config->lifetime = atoi(optarg);
+            break;
+        case 's':
+            if (parse_uint(optarg, &config->stagger_ms)) {
+                fprintf(stderr, "invalid stagger: %s\n", optarg);
+                return -1;
+            }
+            break;
+        case 't':
+            if (parse_uint(optarg, &config->sample_period_ms)) {
+                fprintf(stderr, "invalid sample period: %s\n", optarg);
+                return -1;
+            }
+            break;
+        case 'p':
+            config->persistence_enabled = true;
+            break;
+        case 'd':
+            if (parse_uint(optarg, &config->duration_s)) {
+                fprintf(stderr, "invalid duration: %s\n", optarg);
+                return -1;
+            }
+            break;
+        case 'i':
+            if (parse_uint(optarg, &config->report_period_s)
+                || !config->report_period_s) {
+                fprintf(stderr, "invalid report period: %s\n", optarg);
+                return -1;
+            }
+            break;
+        case 'v':
+            config->verbose = true;
+            break;
+        case 'S':
+            config->sensor_trace = optarg;
+            break;
+        case 'x':
+            config->replay_speed = atof(optarg);
+            break;
+        case 'L':
+            config->replay_loop = true;
+            break;
+        default:
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+struct ClientJobArgs {
+    anjay_t *anjay;
+    const FleetConfig *config;
+    ClientStats *stats;
+};
+
+void periodic_update(avs_sched_t *sched, const void *args_) {
+    const ClientJobArgs *args = (const ClientJobArgs *) args_;
+
+    object_registry_update(args->anjay);
+    if (args->config->persistence_enabled
+        && persist_anjay_if_required(args->anjay)) {
+        APP_LOG(lwm2m, ERROR, "couldn't persist Anjay's state");
+    }
+    const avs_time_duration_t delay =
+            args->config->sample_period_ms
+                    ? avs_time_duration_from_scalar(
+                              args->config->sample_period_ms, AVS_TIME_MS)
+                    : object_registry_next_update_delay(args->anjay);
+    AVS_SCHED_DELAYED(sched, nullptr, delay, periodic_update, args,
+                      sizeof(*args));
+}
+
+void publish_stats(anjay_t *anjay, ClientStats *stats) {
+    const HostAllocStats alloc_stats = host_alloc_stats_get();
+    stats->heap_bytes = alloc_stats.current_bytes;
+    stats->heap_peak_bytes = alloc_stats.peak_bytes;
+#ifdef ANJAY_WITH_NET_STATS
+    stats->tx_bytes = anjay_get_tx_bytes(anjay);
+    stats->rx_bytes = anjay_get_rx_bytes(anjay);
+    stats->retransmissions = anjay_get_num_outgoing_retransmissions(anjay);
+#else  // ANJAY_WITH_NET_STATS
+    (void) anjay;
+#endif // ANJAY_WITH_NET_STATS
+}
+
+void periodic_publish_stats(avs_sched_t *sched, const void *args_) {
+    const ClientJobArgs *args = (const ClientJobArgs *) args_;
+
+    publish_stats(args->anjay, args->stats);
+    if (STOP) {
+        anjay_event_loop_interrupt(args->anjay);
+        return;
+    }
+    AVS_SCHED_DELAYED(sched, nullptr,
+                      avs_time_duration_from_scalar(STATS_PUBLISH_PERIOD_MS,
+                                                    AVS_TIME_MS),
+                      periodic_publish_stats, args, sizeof(*args));
+}
+
+void run_client(const FleetConfig &config, Client *client) {
+    host_sensors_set_time_offset(client->index * SENSOR_TIME_OFFSET_S);
+    ReplaySensorBackend::set_thread_time_offset(
+            client->index * SENSOR_TIME_OFFSET_S * 1000.0);
+
+    anjay_configuration_t anjay_config;
+    memset(&anjay_config, 0, sizeof(anjay_config));
+    anjay_config.endpoint_name = client->endpoint_name.c_str();
+    anjay_config.in_buffer_size = MBED_CONF_APP_COAP_IN_BUFFER_SIZE;
+    anjay_config.out_buffer_size = MBED_CONF_APP_COAP_OUT_BUFFER_SIZE;
+    anjay_config.msg_cache_size = MBED_CONF_APP_COAP_MSG_CACHE_SIZE;
+    anjay_config.disable_legacy_server_initiated_bootstrap = true;
+
+    anjay_t *anjay = anjay_new(&anjay_config);
+    if (!anjay) {
+        APP_LOG(lwm2m, ERROR, "%s: could not create anjay object",
+                client->endpoint_name.c_str());
+        return;
+    }
+
+    mbed::CellularNetwork network;
+    if (anjay_security_object_install(anjay)
+        || anjay_server_object_install(anjay)
+        || anjay_access_control_install(anjay)) {
+        APP_LOG(lwm2m, ERROR, "%s: cannot install core objects",
+                client->endpoint_name.c_str());
+        goto finish;
+    }
+    if ((!config.persistence_enabled || restore_anjay_from_persistence(anjay))
+        && host_configure_nosec_server(anjay, config.server_uri.c_str(),
+                                       false, config.lifetime)) {
+        APP_LOG(lwm2m, ERROR, "%s: cannot configure servers",
+                client->endpoint_name.c_str());
+        goto finish;
+    }
+    if (object_registry_install(anjay, &network)) {
+        APP_LOG(lwm2m, ERROR, "%s: cannot register data model objects",
+                client->endpoint_name.c_str());
+        goto finish;
+    }
+
+    client->stats.running = true;
+    {
+        const ClientJobArgs job_args = { anjay, &config, &client->stats };
+        periodic_update(anjay_get_scheduler(anjay), &job_args);
+        // Run from within the event loop, so that it can interrupt it
+        AVS_SCHED_NOW(anjay_get_scheduler(anjay), nullptr,
+                      periodic_publish_stats, &job_args, sizeof(job_args));
+
+        const avs_time_duration_t max_wait = avs_time_duration_from_scalar(
+                MBED_CONF_APP_EVENT_LOOP_MAX_WAIT_MS, AVS_TIME_MS);
+        if (anjay_event_loop_run(anjay, max_wait)) {
+            APP_LOG(lwm2m, ERROR, "%s: event loop failed",
+                    client->endpoint_name.c_str());
+        }
+        publish_stats(anjay, &client->stats);
+    }
+
+finish:
+    client->stats.running = false;
+    object_registry_uninstall(anjay);
+    anjay_delete(anjay);
+}
+
+/**
+ * Waits for SIGINT or SIGTERM, which are blocked in all threads.
+ *
+ * @returns true if any of them has been received within @p timeout_ms.
+ */
+bool wait_for_stop_signal(const sigset_t &signals, uint32_t timeout_ms) {
+    struct timespec timeout;
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_nsec = (long) (timeout_ms % 1000) * 1000000;
+    return sigtimedwait(&signals, nullptr, &timeout) >= 0;
+}
+
+struct FleetTotals {
+    size_t running;
+    int64_t heap_bytes;
+    uint64_t tx_bytes;
+    uint64_t rx_bytes;
+    uint64_t retransmissions;
+};
+
+FleetTotals
+get_totals(const std::vector<std::unique_ptr<Client>> &clients) {
+    FleetTotals totals = {};
+    for (const auto &client : clients) {
+        totals.running += client->stats.running;
+        totals.heap_bytes += client->stats.heap_bytes;
+        totals.tx_bytes += client->stats.tx_bytes;
+        totals.rx_bytes += client->stats.rx_bytes;
+        totals.retransmissions += client->stats.retransmissions;
+    }
+    return totals;
+}
+
+void print_report(uint32_t elapsed_s,
+                  size_t client_count,
+                  const FleetTotals &totals,
+                  const FleetTotals &previous,
+                  uint32_t period_s) {
+    printf("[%6" PRIu32 " s] running: %zu/%zu, heap: %" PRId64
+           " KiB (%" PRId64 " B/client), tx: %.1f kB/s, rx: %.1f kB/s, "
+           "retransmissions: %" PRIu64 "\n",
+           elapsed_s, totals.running, client_count, totals.heap_bytes / 1024,
+           totals.running ? totals.heap_bytes / (int64_t) totals.running : 0,
+           (totals.tx_bytes - previous.tx_bytes) / 1000.0 / period_s,
+           (totals.rx_bytes - previous.rx_bytes) / 1000.0 / period_s,
+           totals.retransmissions);
+    fflush(stdout);
+}
+
+void print_summary(const std::vector<std::unique_ptr<Client>> &clients,
+                   uint32_t elapsed_s) {
+    printf("\n%-32s %12s %12s %12s %12s %8s\n", "endpoint", "heap [B]",
+           "peak [B]", "tx [B]", "rx [B]", "retx");
+    for (const auto &client : clients) {
+        printf("%-32s %12" PRId64 " %12" PRId64 " %12" PRIu64 " %12" PRIu64
+               " %8" PRIu64 "\n",
+               client->endpoint_name.c_str(), client->stats.heap_bytes.load(),
+               client->stats.heap_peak_bytes.load(),
+               client->stats.tx_bytes.load(), client->stats.rx_bytes.load(),
+               client->stats.retransmissions.load());
+    }
+    const FleetTotals totals = get_totals(clients);
+    const double seconds = std::max<uint32_t>(elapsed_s, 1);
+    printf("\n%zu clients, %" PRIu32 " s, heap: %" PRId64
+           " B/client, tx: %.1f kB/s, rx: %.1f kB/s\n",
+           clients.size(), elapsed_s,
+           totals.heap_bytes / (int64_t) clients.size(),
+           totals.tx_bytes / 1000.0 / seconds,
+           totals.rx_bytes / 1000.0 / seconds);
+#ifndef ANJAY_WITH_NET_STATS
+    printf("Network statistics are not available: Anjay has been built "
+           "without ANJAY_WITH_NET_STATS\n");
+#endif // ANJAY_WITH_NET_STATS
+}
+
+// Cost of a single sensor reading, i.e. of a sample taken by one of the
+// sensor Objects, including the notifications it may have triggered
+void print_replay_summary(const std::vector<std::unique_ptr<Client>> &clients,
+                          const ReplaySensorBackend &sensor_replay,
+                          double cpu_s) {
+    const uint64_t samples = sensor_replay.read_count();
+    if (!samples) {
+        printf("No sensor readings have been replayed\n");
+        return;
+    }
+    const FleetTotals totals = get_totals(clients);
+    printf("Replayed %" PRIu64 " sensor readings: %.1f B/sample uplink, "
+           "%.1f us/sample CPU\n",
+           samples, (double) totals.tx_bytes / samples, cpu_s * 1e6 / samples);
+}
+
+void log_handler(avs_log_level_t level,
+                 const char *module,
+                 const char *message) {
+    (void) module;
+    deferred_log_write(level, message);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    FleetConfig config;
+    if (parse_args(argc, argv, &config)) {
+        return EXIT_FAILURE;
+    }
+
+    // The main thread waits for these signals synchronously; the mask is
+    // inherited by all client threads
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    if (!deferred_log_start()) {
+        avs_log_set_handler(log_handler);
+    }
+    if (!config.verbose) {
+        avs_log_set_default_level(AVS_LOG_WARNING);
+    }
+    if (config.persistence_enabled) {
+        host_kvstore_set_in_memory();
+    }
+
+    ReplaySensorBackend sensor_replay;
+    if (!config.sensor_trace.empty()) {
+        if (sensor_replay.load(config.sensor_trace, config.replay_speed,
+                               config.replay_loop)) {
+            return EXIT_FAILURE;
+        }
+        sensor_backend_set(sensor_replay);
+    }
+    const clock_t start_cpu = clock();
+
+    std::vector<std::unique_ptr<Client>> clients;
+    clients.reserve(config.client_count);
+    const time_t start_time = time(nullptr);
+    for (size_t i = 0; i < config.client_count && !STOP; ++i) {
+        std::unique_ptr<Client> client(new Client);
+        client->index = i;
+        client->endpoint_name =
+                config.endpoint_prefix + "-" + std::to_string(i);
+        Client *client_ptr = client.get();
+        client->thread = std::thread(
+                [&config, client_ptr]() { run_client(config, client_ptr); });
+        clients.push_back(std::move(client));
+
+        if (config.stagger_ms
+            && wait_for_stop_signal(signals, config.stagger_ms)) {
+            STOP = true;
+        }
+    }
+
+    FleetTotals previous = {};
+    uint32_t last_report_s = (uint32_t) (time(nullptr) - start_time);
+    while (!STOP) {
+        if (wait_for_stop_signal(signals, 1000)) {
+            break;
+        }
+        const uint32_t elapsed_s = (uint32_t) (time(nullptr) - start_time);
+        if (elapsed_s - last_report_s >= config.report_period_s) {
+            const FleetTotals totals = get_totals(clients);
+            print_report(elapsed_s, clients.size(), totals, previous,
+                         elapsed_s - last_report_s);
+            previous = totals;
+            last_report_s = elapsed_s;
+        }
+        if (config.duration_s && elapsed_s >= config.duration_s) {
+            break;
+        }
+    }
+
+    STOP = true;
+    for (const auto &client : clients) {
+        client->thread.join();
+    }
+    print_summary(clients, (uint32_t) (time(nullptr) - start_time));
+    if (!config.sensor_trace.empty()) {
+        print_replay_summary(clients, sensor_replay,
+                             (double) (clock() - start_cpu) / CLOCKS_PER_SEC);
+    }
+    return EXIT_SUCCESS;
+}
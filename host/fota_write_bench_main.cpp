@@ -0,0 +1,206 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Benchmark of writing a firmware image to the candidate storage, emulated
+ * by the fake FOTA library (see shims/fota/host_fota.h). The image is passed
+ * in blocks of the sizes used by LwM2M block-wise transfers, either directly
+ * to fota_ext_downloader_write_image_fragment(), like the FOTA wrapper used
+ * to do, or through MbedCloudFotaFlasher, which coalesces them into chunks
+ * aligned to the program size. The number of program operations,
+ * read-modify-write cycles of partially programmed units and the emulated
+ * flash time, including the verification of the candidate, are reported for
+ * both.
+ */
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <unistd.h>
+#include <vector>
+
+#include "fota.h"
+#include "fota_telemetry.h"
+#include "host_fota.h"
+#include "mbed_cloud_fota_wrapper.h"
+
+namespace {
+
+enum class Mode { DIRECT, COALESCED };
+
+struct BenchConfig {
+    size_t image_size = 256 * 1024;
+    HostFotaConfig fota;
+};
+
+struct Result {
+    HostFotaStats stats;
+    double cpu_ns;
+};
+
+double thread_cpu_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+std::vector<uint8_t> make_image(size_t size) {
+    std::vector<uint8_t> image(size);
+    for (size_t i = 0; i < size; ++i) {
+        image[i] = (uint8_t) (i * 7 + (i >> 8));
+    }
+    return image;
+}
+
+// Passes the fragments to the library as they arrive, then lets it verify
+// the candidate
+int write_direct(const std::vector<uint8_t> &manifest,
+                 const std::vector<uint8_t> &image,
+                 size_t block_size,
+                 Result *out) {
+    std::vector<uint8_t> manifest_copy = manifest;
+    // Also drops the install authorization left by the previous run
+    fota_event_cancel(0);
+    fota_on_manifest(manifest_copy.data(), manifest_copy.size());
+    // The wrapper queues the download authorization for the flasher to
+    // perform; drop it and authorize here instead
+    fota_event_cancel(0);
+    fota_on_authorize(FOTA_INSTALL_STATE_AUTHORIZE);
+    if (!fota_is_active_update()) {
+        return -1;
+    }
+    host_fota_reset_stats();
+    const double cpu_before = thread_cpu_ns();
+    for (size_t offset = 0; offset < image.size(); offset += block_size) {
+        const size_t size = std::min(block_size, image.size() - offset);
+        if (fota_ext_downloader_write_image_fragment(image.data() + offset,
+                                                     offset, size)) {
+            return -1;
+        }
+    }
+    const int result = fota_ext_downloader_on_image_ready();
+    out->cpu_ns = thread_cpu_ns() - cpu_before;
+    out->stats = host_fota_stats();
+    fota_event_cancel(0);
+    fota_multicast_node_on_abort();
+    return result;
+}
+
+int write_coalesced(const std::vector<uint8_t> &manifest,
+                    const std::vector<uint8_t> &image,
+                    size_t block_size,
+                    Result *out) {
+    FotaTelemetry::INSTANCE.download_started();
+    MbedCloudFotaFlasher flasher;
+    if (flasher.write(manifest.data(), manifest.size())) {
+        return -1;
+    }
+    host_fota_reset_stats();
+    const double cpu_before = thread_cpu_ns();
+    for (size_t offset = 0; offset < image.size(); offset += block_size) {
+        const size_t size = std::min(block_size, image.size() - offset);
+        if (flasher.write(image.data() + offset, size)) {
+            return -1;
+        }
+    }
+    const int result = flasher.finish();
+    out->cpu_ns = thread_cpu_ns() - cpu_before;
+    out->stats = host_fota_stats();
+    return result;
+}
+
+void print_usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [-s IMAGE_SIZE] [-P PROGRAM_SIZE] [-o PROGRAM_OP_US] "
+            "[-b PROGRAM_BYTE_US] [-r READ_BYTE_US]\n",
+            argv0);
+}
+
+int parse_args(int argc, char **argv, BenchConfig *config) {
+    int opt;
+    while ((opt = getopt(argc, argv, "s:P:o:b:r:h")) != -1) {
+        switch (opt) {
+        case 's':
+            config->image_size = strtoul(optarg, nullptr, 0);
+            break;
+        case 'P':
+            config->fota.program_size = strtoul(optarg, nullptr, 0);
+            break;
+        case 'o':
+            config->fota.program_op_us = strtod(optarg, nullptr);
+            break;
+        case 'b':
+            config->fota.program_byte_us = strtod(optarg, nullptr);
+            break;
+        case 'r':
+            config->fota.read_byte_us = strtod(optarg, nullptr);
+            break;
+        default:
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+    if (!config->image_size || !config->fota.program_size) {
+        print_usage(argv[0]);
+        return -1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    BenchConfig config;
+    if (parse_args(argc, argv, &config)) {
+        return EXIT_FAILURE;
+    }
+    config.fota.storage_size =
+            std::max(config.fota.storage_size, config.image_size);
+    const std::vector<uint8_t> image = make_image(config.image_size);
+    const std::vector<uint8_t> manifest =
+            host_fota_manifest(image.data(), image.size());
+
+    printf("image %zu B, program size %zu B, write buffer %d B\n",
+           config.image_size, config.fota.program_size,
+           MBED_CONF_ANJAY_MBED_FOTA_WRITE_BUFFER_SIZE);
+    printf("%6s %-10s %9s %12s %8s %12s %10s\n", "block", "mode", "programs",
+           "programmed", "rmw", "flash ms", "cpu us");
+    int result = EXIT_SUCCESS;
+    for (size_t block_size = 16; block_size <= 1024; block_size *= 2) {
+        for (Mode mode : { Mode::DIRECT, Mode::COALESCED }) {
+            host_fota_reset(config.fota);
+            Result r{};
+            const int write_result =
+                    mode == Mode::DIRECT
+                            ? write_direct(manifest, image, block_size, &r)
+                            : write_coalesced(manifest, image, block_size,
+                                              &r);
+            if (write_result) {
+                fprintf(stderr, "writing the image failed\n");
+                result = EXIT_FAILURE;
+                continue;
+            }
+            printf("%6zu %-10s %9" PRIu32 " %12" PRIu64 " %8" PRIu32
+                   " %12.1f %10.1f\n",
+                   block_size, mode == Mode::DIRECT ? "direct" : "coalesced",
+                   r.stats.programs, r.stats.programmed_bytes,
+                   r.stats.read_modify_writes, r.stats.busy_us / 1000.0,
+                   r.cpu_ns / 1000.0);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "host_alloc_stats.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <malloc.h>
+
+// Actual implementations, exported by glibc for this very purpose
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t nmemb, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void __libc_free(void *ptr);
+}
+
+namespace {
+
+// Constant-initialized, so that accessing it never allocates
+thread_local HostAllocStats STATS;
+
+void *account_alloc(void *ptr) {
+    if (ptr) {
+        const size_t size = malloc_usable_size(ptr);
+        STATS.current_bytes += (int64_t) size;
+        STATS.peak_bytes = std::max(STATS.peak_bytes, STATS.current_bytes);
+        ++STATS.allocation_count;
+        STATS.allocated_bytes += size;
+    }
+    return ptr;
+}
+
+void account_free(void *ptr) {
+    if (ptr) {
+        STATS.current_bytes -= (int64_t) malloc_usable_size(ptr);
+    }
+}
+
+} // namespace
+
+HostAllocStats host_alloc_stats_get() {
+    return STATS;
+}
+
+extern "C" {
+
+void *malloc(size_t size) {
+    return account_alloc(__libc_malloc(size));
+}
+
+void *calloc(size_t nmemb, size_t size) {
+    return account_alloc(__libc_calloc(nmemb, size));
+}
+
+void *realloc(void *ptr, size_t size) {
+    const size_t old_size = ptr ? malloc_usable_size(ptr) : 0;
+    void *result = __libc_realloc(ptr, size);
+    if (result || !size) {
+        STATS.current_bytes -= (int64_t) old_size;
+        account_alloc(result);
+    }
+    return result;
+}
+
+void *memalign(size_t alignment, size_t size) {
+    return account_alloc(__libc_memalign(alignment, size));
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+    return account_alloc(__libc_memalign(alignment, size));
+}
+
+int posix_memalign(void **memptr, size_t alignment, size_t size) {
+    if (!alignment || (alignment & (alignment - 1))
+        || alignment % sizeof(void *)) {
+        return EINVAL;
+    }
+    void *ptr = account_alloc(__libc_memalign(alignment, size));
+    if (!ptr) {
+        return ENOMEM;
+    }
+    *memptr = ptr;
+    return 0;
+}
+
+void free(void *ptr) {
+    account_free(ptr);
+    __libc_free(ptr);
+}
+
+} // extern "C"
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef HOST_ALLOC_STATS_H
+#define HOST_ALLOC_STATS_H
+
+#include <cstdint>
+
+/**
+ * Heap usage of a single thread. Linking host_alloc_stats.cpp into an
+ * executable interposes the glibc allocator, so that every block is
+ * accounted to the thread that allocated it, including blocks allocated by
+ * Anjay and the C++ runtime. A block freed by another thread is subtracted
+ * from the usage of that other thread.
+ */
+struct HostAllocStats {
+    int64_t current_bytes;
+    int64_t peak_bytes;
+    uint64_t allocation_count;
+    // Total size of all blocks allocated so far, regardless of whether they
+    // have been freed since
+    uint64_t allocated_bytes;
+};
+
+/**
+ * @returns Heap usage of the calling thread since it was started.
+ */
+HostAllocStats host_alloc_stats_get();
+
+#endif // HOST_ALLOC_STATS_H
@@ -0,0 +1,310 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "host_coap.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <avsystem/commons/avs_list_cxx.hpp>
+#include <avsystem/commons/avs_socket.h>
+
+namespace {
+
+constexpr int RESPONSE_TIMEOUT_MS = 1000;
+constexpr int REGISTER_TIMEOUT_MS = 5000;
+
+void append_option_nibble(std::vector<uint8_t> *ext,
+                          uint32_t value,
+                          uint8_t *nibble) {
+    if (value < 13) {
+        *nibble = (uint8_t) value;
+    } else if (value < 269) {
+        *nibble = 13;
+        ext->push_back((uint8_t) (value - 13));
+    } else {
+        *nibble = 14;
+        ext->push_back((uint8_t) ((value - 269) >> 8));
+        ext->push_back((uint8_t) (value - 269));
+    }
+}
+
+} // namespace
+
+std::vector<uint8_t> coap_encode_uint(uint32_t value) {
+    std::vector<uint8_t> result;
+    for (; value; value >>= 8) {
+        result.insert(result.begin(), (uint8_t) value);
+    }
+    return result;
+}
+
+uint32_t coap_decode_uint(const uint8_t *value, size_t size) {
+    uint32_t result = 0;
+    for (size_t i = 0; i < size; ++i) {
+        result = (result << 8) | value[i];
+    }
+    return result;
+}
+
+CoapOption coap_string_option(uint16_t number, const std::string &value) {
+    return CoapOption{ number,
+                       std::vector<uint8_t>(value.begin(), value.end()) };
+}
+
+std::vector<uint8_t> coap_serialize(uint8_t code,
+                                    std::vector<CoapOption> options,
+                                    const CoapView *response_to,
+                                    const std::vector<uint8_t> &payload) {
+    const size_t token_size = response_to ? response_to->token_size
+                                          : COAP_TOKEN_SIZE;
+    std::vector<uint8_t> out;
+    out.push_back((uint8_t) ((COAP_VERSION << 6)
+                             | ((response_to ? COAP_TYPE_ACK : COAP_TYPE_CON)
+                                << 4)
+                             | token_size));
+    out.push_back(code);
+    out.push_back(response_to ? (uint8_t) (response_to->msg_id >> 8) : 0);
+    out.push_back(response_to ? (uint8_t) response_to->msg_id : 0);
+    if (response_to) {
+        out.insert(out.end(), response_to->token,
+                   response_to->token + token_size);
+    } else {
+        out.insert(out.end(), token_size, 0);
+    }
+    // Options shall be sorted by number; the order of options with the same
+    // number, e.g. Uri-Path segments, is preserved by stable_sort()
+    std::stable_sort(options.begin(), options.end(),
+                     [](const CoapOption &a, const CoapOption &b) {
+                         return a.number < b.number;
+                     });
+    uint16_t last_number = 0;
+    for (const CoapOption &opt : options) {
+        std::vector<uint8_t> ext;
+        uint8_t delta_nibble;
+        uint8_t length_nibble;
+        append_option_nibble(&ext, opt.number - last_number, &delta_nibble);
+        append_option_nibble(&ext, (uint32_t) opt.value.size(),
+                             &length_nibble);
+        out.push_back((uint8_t) ((delta_nibble << 4) | length_nibble));
+        out.insert(out.end(), ext.begin(), ext.end());
+        out.insert(out.end(), opt.value.begin(), opt.value.end());
+        last_number = opt.number;
+    }
+    if (!payload.empty()) {
+        out.push_back(0xFF);
+        out.insert(out.end(), payload.begin(), payload.end());
+    }
+    return out;
+}
+
+void coap_set_msg_id(std::vector<uint8_t> *request, uint16_t msg_id) {
+    (*request)[2] = (uint8_t) (msg_id >> 8);
+    (*request)[3] = (uint8_t) msg_id;
+    // Token only needs to be unique among the outstanding requests
+    (*request)[4] = (*request)[2];
+    (*request)[5] = (*request)[3];
+}
+
+uint32_t coap_token_for_msg_id(uint16_t msg_id) {
+    return (uint32_t) msg_id << 16;
+}
+
+uint32_t coap_token(const CoapView &msg) {
+    return msg.token_size == COAP_TOKEN_SIZE
+                   ? coap_decode_uint(msg.token, msg.token_size)
+                   : UINT32_MAX;
+}
+
+int coap_read_option_nibble(const uint8_t *&ptr,
+                            const uint8_t *end,
+                            uint8_t nibble,
+                            uint32_t *out) {
+    if (nibble < 13) {
+        *out = nibble;
+    } else if (nibble == 13 && ptr < end) {
+        *out = 13u + *ptr++;
+    } else if (nibble == 14 && end - ptr >= 2) {
+        *out = 269u + ((uint32_t) ptr[0] << 8) + ptr[1];
+        ptr += 2;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+int coap_parse(const uint8_t *data, size_t size, CoapView *out) {
+    if (size < 4 || (data[0] >> 6) != COAP_VERSION) {
+        return -1;
+    }
+    out->type = (data[0] >> 4) & 0x03;
+    out->code = data[1];
+    out->msg_id = (uint16_t) ((data[2] << 8) | data[3]);
+    out->token_size = data[0] & 0x0F;
+    if (out->token_size > 8 || size - 4 < out->token_size) {
+        return -1;
+    }
+    out->token = data + 4;
+    out->options = out->token + out->token_size;
+    const uint8_t *ptr = out->options;
+    const uint8_t *end = data + size;
+    while (ptr < end && *ptr != 0xFF) {
+        const uint8_t header = *ptr++;
+        uint32_t delta;
+        uint32_t length;
+        if (coap_read_option_nibble(ptr, end, header >> 4, &delta)
+            || coap_read_option_nibble(ptr, end, header & 0x0F, &length)
+            || (uint32_t) (end - ptr) < length) {
+            return -1;
+        }
+        ptr += length;
+    }
+    out->options_end = ptr;
+    out->payload = ptr < end ? ptr + 1 : end;
+    out->payload_size = (size_t) (end - out->payload);
+    out->size = size;
+    return 0;
+}
+
+LoopbackServer::LoopbackServer(anjay_t *anjay)
+        : anjay_(anjay), client_socket_(nullptr), fd_(-1), next_msg_id_(1) {}
+
+LoopbackServer::~LoopbackServer() {
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+int LoopbackServer::open(uint16_t *out_port) {
+    fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    if (fd_ < 0 || bind(fd_, (const sockaddr *) &addr, sizeof(addr))
+        || getsockname(fd_, (sockaddr *) &addr, &addr_len)) {
+        return -1;
+    }
+    *out_port = ntohs(addr.sin_port);
+    return 0;
+}
+
+avs_net_socket_t *LoopbackServer::find_client_socket() {
+    for (const auto &entry : avs::ListView<const anjay_socket_entry_t>(
+                 anjay_get_socket_entries(anjay_))) {
+        if (entry.transport == ANJAY_SOCKET_TRANSPORT_UDP) {
+            return entry.socket;
+        }
+    }
+    return nullptr;
+}
+
+void LoopbackServer::serve_client(int timeout_ms) {
+    if (!client_socket_ && !(client_socket_ = find_client_socket())) {
+        return;
+    }
+    pollfd pfd = { *(const int *) avs_net_socket_get_system(client_socket_),
+                   POLLIN, 0 };
+    if (poll(&pfd, 1, timeout_ms) == 1) {
+        anjay_serve(anjay_, client_socket_);
+    }
+}
+
+int LoopbackServer::receive(CoapView *out, int timeout_ms) {
+    pollfd pfd = { fd_, POLLIN, 0 };
+    if (poll(&pfd, 1, timeout_ms) != 1) {
+        return -1;
+    }
+    const ssize_t size = recv(fd_, buf_, sizeof(buf_), 0);
+    return size < 0 ? -1 : coap_parse(buf_, (size_t) size, out);
+}
+
+int LoopbackServer::send(const std::vector<uint8_t> &data) {
+    return ::send(fd_, data.data(), data.size(), 0) == (ssize_t) data.size()
+                   ? 0
+                   : -1;
+}
+
+int LoopbackServer::wait_for_registration() {
+    const auto deadline = std::chrono::steady_clock::now()
+                          + std::chrono::milliseconds(REGISTER_TIMEOUT_MS);
+    while (std::chrono::steady_clock::now() < deadline) {
+        anjay_sched_run(anjay_);
+        pollfd pfd = { fd_, POLLIN, 0 };
+        if (poll(&pfd, 1, 10) != 1) {
+            continue;
+        }
+        sockaddr_in client_addr;
+        socklen_t addr_len = sizeof(client_addr);
+        const ssize_t received = recvfrom(fd_, buf_, sizeof(buf_), 0,
+                                          (sockaddr *) &client_addr,
+                                          &addr_len);
+        CoapView request;
+        if (received < 0 || coap_parse(buf_, (size_t) received, &request)
+            || request.code != COAP_CODE_POST) {
+            continue;
+        }
+        bool is_register = false;
+        coap_for_each_option(request, [&](uint16_t number,
+                                          const uint8_t *value, size_t size) {
+            if (number == COAP_OPT_URI_PATH) {
+                is_register = size == 2 && !memcmp(value, "rd", 2);
+                return true;
+            }
+            return false;
+        });
+        if (!is_register) {
+            continue;
+        }
+        const std::vector<uint8_t> response = coap_serialize(
+                COAP_CODE_CREATED,
+                { coap_string_option(COAP_OPT_LOCATION_PATH, "rd"),
+                  coap_string_option(COAP_OPT_LOCATION_PATH, "host") },
+                &request);
+        if (connect(fd_, (const sockaddr *) &client_addr, sizeof(client_addr))
+            || send(response)) {
+            return -1;
+        }
+        serve_client(RESPONSE_TIMEOUT_MS);
+        anjay_sched_run(anjay_);
+        return 0;
+    }
+    return -1;
+}
+
+int LoopbackServer::exchange(std::vector<uint8_t> *request,
+                             CoapView *out_response) {
+    const uint16_t msg_id = next_msg_id_++;
+    coap_set_msg_id(request, msg_id);
+    if (send(*request)) {
+        return -1;
+    }
+    serve_client(RESPONSE_TIMEOUT_MS);
+    // Notifications sent in the meantime are skipped
+    while (!receive(out_response, RESPONSE_TIMEOUT_MS)) {
+        if (out_response->type == COAP_TYPE_ACK
+            && out_response->msg_id == msg_id) {
+            return 0;
+        }
+    }
+    return -1;
+}
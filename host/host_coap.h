@@ -0,0 +1,205 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef HOST_COAP_H
+#define HOST_COAP_H
+
+/**
+ * Minimal CoAP over UDP for the host tools that play the role of the LwM2M
+ * Server: just enough to register a client and to exchange requests with it
+ * over a loopback socket. The client is driven synchronously with
+ * anjay_serve() and anjay_sched_run() on the calling thread.
+ */
+
+#include <arpa/inet.h>
+#include <cstddef>
+#include <cstdint>
+#include <netinet/in.h>
+#include <string>
+#include <vector>
+
+#include <anjay/anjay.h>
+#include <avsystem/commons/avs_net.h>
+
+constexpr uint8_t COAP_VERSION = 1;
+constexpr uint8_t COAP_TYPE_CON = 0;
+constexpr uint8_t COAP_TYPE_NON = 1;
+constexpr uint8_t COAP_TYPE_ACK = 2;
+constexpr uint8_t COAP_CODE_EMPTY = 0x00;
+constexpr uint8_t COAP_CODE_GET = 0x01;
+constexpr uint8_t COAP_CODE_POST = 0x02;
+constexpr uint8_t COAP_CODE_PUT = 0x03;
+constexpr uint8_t COAP_CODE_FETCH = 0x05;
+constexpr uint8_t COAP_CODE_CREATED = 0x41;
+constexpr uint8_t COAP_CODE_CHANGED = 0x44;
+constexpr uint8_t COAP_CODE_CONTENT = 0x45;
+constexpr uint8_t COAP_CODE_NOT_FOUND = 0x84;
+constexpr uint8_t COAP_CODE_METHOD_NOT_ALLOWED = 0x85;
+constexpr uint8_t COAP_CODE_NOT_ACCEPTABLE = 0x86;
+
+constexpr uint16_t COAP_OPT_OBSERVE = 6;
+constexpr uint16_t COAP_OPT_LOCATION_PATH = 8;
+constexpr uint16_t COAP_OPT_URI_PATH = 11;
+constexpr uint16_t COAP_OPT_CONTENT_FORMAT = 12;
+constexpr uint16_t COAP_OPT_URI_QUERY = 15;
+constexpr uint16_t COAP_OPT_ACCEPT = 17;
+constexpr uint16_t COAP_OPT_BLOCK2 = 23;
+
+constexpr uint16_t COAP_FORMAT_SENML_CBOR = 112;
+
+// Requests are built with the same token length, so that the message ID and
+// token of a serialized request can be replaced in place
+constexpr size_t COAP_TOKEN_SIZE = 4;
+
+struct CoapOption {
+    uint16_t number;
+    std::vector<uint8_t> value;
+};
+
+/**
+ * Received message. Points into the receive buffer, so that handling a
+ * message does not allocate memory and distort the measurements.
+ */
+struct CoapView {
+    uint8_t type;
+    uint8_t code;
+    uint16_t msg_id;
+    const uint8_t *token;
+    size_t token_size;
+    const uint8_t *options;
+    const uint8_t *options_end;
+    const uint8_t *payload;
+    size_t payload_size;
+    // Size of the whole datagram
+    size_t size;
+};
+
+std::vector<uint8_t> coap_encode_uint(uint32_t value);
+
+uint32_t coap_decode_uint(const uint8_t *value, size_t size);
+
+CoapOption coap_string_option(uint16_t number, const std::string &value);
+
+/**
+ * Serializes a confirmable request or, if @p response_to is not NULL, a
+ * piggybacked response to it. The message ID and token of a request are left
+ * zeroed, see coap_set_msg_id().
+ */
+std::vector<uint8_t>
+coap_serialize(uint8_t code,
+               std::vector<CoapOption> options,
+               const CoapView *response_to = nullptr,
+               const std::vector<uint8_t> &payload = {});
+
+/**
+ * Sets the message ID of a serialized request, and its token to a value
+ * derived from it.
+ */
+void coap_set_msg_id(std::vector<uint8_t> *request, uint16_t msg_id);
+
+/**
+ * @returns Token that coap_set_msg_id() sets for @p msg_id.
+ */
+uint32_t coap_token_for_msg_id(uint16_t msg_id);
+
+/**
+ * @returns Token of @p msg as an integer, if it is COAP_TOKEN_SIZE bytes
+ *          long, or UINT32_MAX otherwise.
+ */
+uint32_t coap_token(const CoapView &msg);
+
+int coap_parse(const uint8_t *data, size_t size, CoapView *out);
+
+int coap_read_option_nibble(const uint8_t *&ptr,
+                            const uint8_t *end,
+                            uint8_t nibble,
+                            uint32_t *out);
+
+/**
+ * Calls @p visitor(number, value, size) for every option of @p msg, until it
+ * returns true. The options shall have been validated by coap_parse().
+ */
+template <typename Visitor>
+void coap_for_each_option(const CoapView &msg, Visitor &&visitor) {
+    const uint8_t *ptr = msg.options;
+    uint32_t number = 0;
+    while (ptr < msg.options_end) {
+        const uint8_t header = *ptr++;
+        uint32_t delta;
+        uint32_t length;
+        coap_read_option_nibble(ptr, msg.options_end, header >> 4, &delta);
+        coap_read_option_nibble(ptr, msg.options_end, header & 0x0F, &length);
+        number += delta;
+        if (visitor((uint16_t) number, ptr, (size_t) length)) {
+            break;
+        }
+        ptr += length;
+    }
+}
+
+/**
+ * LwM2M Server stand-in: a UDP socket bound to the loopback interface,
+ * connected to the client as soon as it registers.
+ */
+class LoopbackServer {
+    anjay_t *anjay_;
+    avs_net_socket_t *client_socket_;
+    int fd_;
+    uint16_t next_msg_id_;
+    uint8_t buf_[4096];
+
+    LoopbackServer(const LoopbackServer &) = delete;
+    LoopbackServer &operator=(const LoopbackServer &) = delete;
+
+    avs_net_socket_t *find_client_socket();
+
+public:
+    explicit LoopbackServer(anjay_t *anjay);
+    ~LoopbackServer();
+
+    int open(uint16_t *out_port);
+
+    /**
+     * Runs the client until it registers, accepting the first Register
+     * request it sends.
+     */
+    int wait_for_registration();
+
+    /**
+     * Lets the client handle a message from the server, if one arrives
+     * within @p timeout_ms.
+     */
+    void serve_client(int timeout_ms);
+
+    /**
+     * Receives a message; @p out is valid until the next call.
+     */
+    int receive(CoapView *out, int timeout_ms);
+
+    int send(const std::vector<uint8_t> &data);
+
+    /**
+     * Sends @p request, after setting its message ID and token with
+     * coap_set_msg_id(), lets the client handle it and receives the
+     * response; @p out_response is valid until the next call.
+     *
+     * @returns 0 on success, -1 if there was no matching response.
+     */
+    int exchange(std::vector<uint8_t> *request, CoapView *out_response);
+};
+
+#endif // HOST_COAP_H
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "host_common.h"
+
+#include <cstring>
+
+#include <anjay/security.h>
+#include <anjay/server.h>
+
+#include "app_log.h"
+
+int host_configure_nosec_server(anjay_t *anjay,
+                                const char *server_uri,
+                                bool bootstrap,
+                                int32_t lifetime) {
+    anjay_security_instance_t security_instance;
+    memset(&security_instance, 0, sizeof(security_instance));
+    security_instance.ssid = bootstrap ? ANJAY_SSID_BOOTSTRAP : 1;
+    security_instance.server_uri = server_uri;
+    security_instance.bootstrap_server = bootstrap;
+    security_instance.security_mode = ANJAY_SECURITY_NOSEC;
+    anjay_iid_t security_instance_iid = ANJAY_ID_INVALID;
+    if (anjay_security_object_add_instance(anjay, &security_instance,
+                                           &security_instance_iid)) {
+        APP_LOG(lwm2m, ERROR, "could not add security instance");
+        return -1;
+    }
+
+    if (bootstrap) {
+        return 0;
+    }
+
+    anjay_server_instance_t server_instance;
+    memset(&server_instance, 0, sizeof(server_instance));
+    server_instance.ssid = 1;
+    server_instance.lifetime = lifetime;
+    server_instance.default_min_period = -1;
+    server_instance.default_max_period = -1;
+    server_instance.disable_timeout = -1;
+    server_instance.binding = "U";
+    server_instance.notification_storing = false;
+    anjay_iid_t server_instance_iid = ANJAY_ID_INVALID;
+    if (anjay_server_object_add_instance(anjay, &server_instance,
+                                         &server_instance_iid)) {
+        APP_LOG(lwm2m, ERROR, "could not add server instance");
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef HOST_COMMON_H
+#define HOST_COMMON_H
+
+#include <cstdint>
+
+#include <anjay/anjay.h>
+
+/**
+ * Adds Security and Server Object instances for a single NoSec LwM2M Server.
+ * For a Bootstrap Server, only the Security Object instance is added.
+ *
+ * @returns 0 on success, negative value in case of error.
+ */
+int host_configure_nosec_server(anjay_t *anjay,
+                                const char *server_uri,
+                                bool bootstrap,
+                                int32_t lifetime);
+
+#endif // HOST_COMMON_H
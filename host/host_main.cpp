@@ -0,0 +1,267 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * Entry point of the host (Linux) build of the client. Runs the LwM2M Objects
+ * and persistence of the device firmware against POSIX shims of the Mbed OS
+ * APIs, so that they can be profiled and benchmarked with the usual tools.
+ */
+
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <pthread.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include <CellularContext.h>
+#include <CellularNetwork.h>
+#include <kvstore_global_api/kvstore_global_api.h>
+
+#include <anjay/access_control.h>
+#include <anjay/anjay.h>
+#include <anjay/security.h>
+#include <anjay/server.h>
+#include <avsystem/commons/avs_log.h>
+
+#include "app_log.h"
+#include "deferred_log.h"
+#include "host_common.h"
+#include "host_sensor_replay.h"
+#include "object_registry.h"
+#include "persistence.h"
+
+namespace {
+
+struct HostConfig {
+    std::string endpoint_name = MBED_CONF_APP_ENDPOINT_NAME;
+    std::string server_uri = "coap://127.0.0.1:5683";
+    bool bootstrap = false;
+    int32_t lifetime = 50;
+    bool persistence_enabled = false;
+    std::vector<int> rssi_script;
+    std::string sensor_trace;
+    double replay_speed = 1.0;
+    bool replay_loop = false;
+};
+
+void print_usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [-e ENDPOINT_NAME] [-u SERVER_URI] [-b] [-l LIFETIME]\n"
+            "          [-p STORAGE_DIR] [-r RSSI[,RSSI...]]\n"
+            "          [-S SENSOR_TRACE [-x SPEED] [-L]]\n"
+            "\n"
+            "  -e  endpoint name (default: %s)\n"
+            "  -u  NoSec LwM2M Server URI (default: coap://127.0.0.1:5683)\n"
+            "  -b  the server is a LwM2M Bootstrap Server\n"
+            "  -l  registration lifetime in seconds (default: 50)\n"
+            "  -p  enable persistence, storing the state in STORAGE_DIR\n"
+            "  -r  comma-separated signal strengths in dBm, reported\n"
+            "      cyclically by the Connectivity Monitoring object\n"
+            "  -S  replay sensor readings from a CSV trace instead of\n"
+            "      generating synthetic ones\n"
+            "  -x  trace replay speed (default: 1.0)\n"
+            "  -L  start the trace over after its last reading\n",
+            argv0, MBED_CONF_APP_ENDPOINT_NAME);
+}
+
+int parse_rssi_script(const char *arg, std::vector<int> *out) {
+    std::string value = arg;
+    size_t start = 0;
+    while (start <= value.size()) {
+        const size_t end = std::min(value.find(',', start), value.size());
+        const std::string item = value.substr(start, end - start);
+        char *endptr = nullptr;
+        const long rssi = strtol(item.c_str(), &endptr, 10);
+        if (item.empty() || *endptr) {
+            return -1;
+        }
+        out->push_back((int) rssi);
+        start = end + 1;
+    }
+    return 0;
+}
+
+int parse_args(int argc, char **argv, HostConfig *config) {
+    int opt;
+    while ((opt = getopt(argc, argv, "e:u:bl:p:r:S:x:Lh")) != -1) {
+        switch (opt) {
+        case 'e':
+            config->endpoint_name = optarg;
+            break;
+        case 'u':
+            config->server_uri = optarg;
+            break;
+        case 'b':
+            config->bootstrap = true;
+            break;
+        case 'l':
+            config->lifetime = atoi(optarg);
+            break;
+        case 'p':
+            config->persistence_enabled = true;
+            host_kvstore_set_root(optarg);
+            break;
+        case 'r':
+            if (parse_rssi_script(optarg, &config->rssi_script)) {
+                fprintf(stderr, "invalid signal strength list: %s\n", optarg);
+                return -1;
+            }
+            break;
+        case 'S':
+            config->sensor_trace = optarg;
+            break;
+        case 'x':
+            config->replay_speed = atof(optarg);
+            break;
+        case 'L':
+            config->replay_loop = true;
+            break;
+        default:
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+struct PeriodicUpdateArgs {
+    anjay_t *anjay;
+    bool persistence_enabled;
+};
+
+void periodic_update(avs_sched_t *sched, const void *args_) {
+    const PeriodicUpdateArgs *args = (const PeriodicUpdateArgs *) args_;
+
+    object_registry_update(args->anjay);
+    if (args->persistence_enabled && persist_anjay_if_required(args->anjay)) {
+        APP_LOG(lwm2m, ERROR, "couldn't persist Anjay's state");
+    }
+    AVS_SCHED_DELAYED(sched, nullptr,
+                      object_registry_next_update_delay(args->anjay),
+                      periodic_update, args, sizeof(*args));
+}
+
+void log_handler(avs_log_level_t level,
+                 const char *module,
+                 const char *message) {
+    (void) module;
+    deferred_log_write(level, message);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    HostConfig config;
+    if (parse_args(argc, argv, &config)) {
+        return EXIT_FAILURE;
+    }
+
+    ReplaySensorBackend sensor_replay;
+    if (!config.sensor_trace.empty()) {
+        if (sensor_replay.load(config.sensor_trace, config.replay_speed,
+                               config.replay_loop)) {
+            return EXIT_FAILURE;
+        }
+        sensor_backend_set(sensor_replay);
+    }
+
+    // SIGINT and SIGTERM are handled by a dedicated thread, as
+    // anjay_event_loop_interrupt() is not async-signal-safe; the mask is
+    // inherited by all threads started later on
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    if (!deferred_log_start()) {
+        avs_log_set_handler(log_handler);
+    }
+
+    anjay_configuration_t anjay_config;
+    memset(&anjay_config, 0, sizeof(anjay_config));
+    anjay_config.endpoint_name = config.endpoint_name.c_str();
+    anjay_config.in_buffer_size = MBED_CONF_APP_COAP_IN_BUFFER_SIZE;
+    anjay_config.out_buffer_size = MBED_CONF_APP_COAP_OUT_BUFFER_SIZE;
+    anjay_config.msg_cache_size = MBED_CONF_APP_COAP_MSG_CACHE_SIZE;
+    anjay_config.disable_legacy_server_initiated_bootstrap = true;
+
+    anjay_t *anjay = anjay_new(&anjay_config);
+    if (!anjay) {
+        APP_LOG(lwm2m, ERROR, "could not create anjay object");
+        return EXIT_FAILURE;
+    }
+
+    mbed::CellularNetwork network;
+    if (!config.rssi_script.empty()) {
+        network.set_signal_quality_script(config.rssi_script);
+    }
+
+    int result = EXIT_FAILURE;
+    if (anjay_security_object_install(anjay)
+        || anjay_server_object_install(anjay)
+        || anjay_access_control_install(anjay)) {
+        APP_LOG(lwm2m, ERROR, "cannot install core objects");
+        goto finish;
+    }
+    if ((!config.persistence_enabled || restore_anjay_from_persistence(anjay))
+        && host_configure_nosec_server(anjay, config.server_uri.c_str(),
+                                       config.bootstrap, config.lifetime)) {
+        APP_LOG(lwm2m, ERROR, "cannot configure servers");
+        goto finish;
+    }
+    if (object_registry_install(anjay, &network)) {
+        APP_LOG(lwm2m, ERROR, "cannot register data model objects");
+        goto finish;
+    }
+
+    {
+        std::thread signal_thread([anjay, signals]() {
+            int signal;
+            sigwait(&signals, &signal);
+            anjay_event_loop_interrupt(anjay);
+        });
+        signal_thread.detach();
+    }
+
+    {
+        const PeriodicUpdateArgs update_args = { anjay,
+                                                 config.persistence_enabled };
+        periodic_update(anjay_get_scheduler(anjay), &update_args);
+    }
+
+    {
+        const avs_time_duration_t max_wait = avs_time_duration_from_scalar(
+                MBED_CONF_APP_EVENT_LOOP_MAX_WAIT_MS, AVS_TIME_MS);
+        if (!anjay_event_loop_run(anjay, max_wait)) {
+            result = EXIT_SUCCESS;
+        }
+    }
+    if (config.persistence_enabled && persist_anjay_if_required(anjay)) {
+        APP_LOG(lwm2m, ERROR, "couldn't persist Anjay's state");
+    }
+
+finish:
+    object_registry_uninstall(anjay);
+    anjay_delete(anjay);
+    return result;
+}
@@ -0,0 +1,239 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "host_sensor_replay.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+thread_local double TIME_OFFSET_MS;
+
+struct SensorName {
+    const char *name;
+    SensorType type;
+    size_t value_count;
+};
+
+const SensorName SENSOR_NAMES[] = {
+    { "barometer", SensorType::BAROMETER, 1 },
+    { "humidity", SensorType::HUMIDITY, 1 },
+    { "accelerometer", SensorType::ACCELEROMETER, 3 },
+    { "magnetometer", SensorType::MAGNETOMETER, 3 }
+};
+
+const SensorName *find_sensor(const std::string &name) {
+    for (const SensorName &entry : SENSOR_NAMES) {
+        if (name == entry.name) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+int parse_double(const std::string &field, double *out) {
+    char *endptr = nullptr;
+    *out = strtod(field.c_str(), &endptr);
+    return field.empty() || *endptr || !std::isfinite(*out) ? -1 : 0;
+}
+
+std::string trim(const std::string &value) {
+    const size_t first = value.find_first_not_of(" \t\r");
+    if (first == std::string::npos) {
+        return std::string();
+    }
+    return value.substr(first, value.find_last_not_of(" \t\r") - first + 1);
+}
+
+} // namespace
+
+ReplaySensorBackend::ReplaySensorBackend()
+        : first_timestamp_ms_(0.0),
+          last_timestamp_ms_(0.0),
+          speed_(1.0),
+          loop_(false),
+          start_(std::chrono::steady_clock::now()),
+          seek_ms_(-1.0),
+          read_count_(0) {}
+
+int ReplaySensorBackend::load(const std::string &path,
+                              double speed,
+                              bool loop) {
+    if (!(speed > 0.0)) {
+        fprintf(stderr, "%s: invalid replay speed: %g\n", path.c_str(),
+                speed);
+        return -1;
+    }
+    std::ifstream stream(path);
+    if (!stream) {
+        fprintf(stderr, "%s: cannot open trace\n", path.c_str());
+        return -1;
+    }
+
+    std::vector<Sample> samples[SENSOR_TYPE_COUNT];
+    std::string line;
+    for (size_t line_no = 1; std::getline(stream, line); ++line_no) {
+        line = trim(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::vector<std::string> fields;
+        std::istringstream line_stream(line);
+        for (std::string field; std::getline(line_stream, field, ',');) {
+            fields.push_back(trim(field));
+        }
+
+        const SensorName *sensor =
+                fields.size() >= 2 ? find_sensor(fields[1]) : nullptr;
+        Sample sample = {};
+        double value;
+        bool valid = sensor && fields.size() == 2 + sensor->value_count
+                     && !parse_double(fields[0], &sample.timestamp_ms)
+                     && sample.timestamp_ms >= 0.0;
+        for (size_t i = 0; valid && i < sensor->value_count; ++i) {
+            valid = !parse_double(fields[2 + i], &value);
+            sample.values[i] = (float) value;
+        }
+        if (!valid) {
+            fprintf(stderr, "%s:%zu: invalid reading: %s\n", path.c_str(),
+                    line_no, line.c_str());
+            return -1;
+        }
+        samples[(size_t) sensor->type].push_back(sample);
+    }
+    if (stream.bad()) {
+        fprintf(stderr, "%s: cannot read trace\n", path.c_str());
+        return -1;
+    }
+
+    bool empty = true;
+    for (size_t i = 0; i < SENSOR_TYPE_COUNT; ++i) {
+        std::stable_sort(samples[i].begin(), samples[i].end(),
+                         [](const Sample &a, const Sample &b) {
+                             return a.timestamp_ms < b.timestamp_ms;
+                         });
+        if (!samples[i].empty()) {
+            first_timestamp_ms_ =
+                    empty ? samples[i].front().timestamp_ms
+                          : std::min(first_timestamp_ms_,
+                                     samples[i].front().timestamp_ms);
+            last_timestamp_ms_ =
+                    empty ? samples[i].back().timestamp_ms
+                          : std::max(last_timestamp_ms_,
+                                     samples[i].back().timestamp_ms);
+            empty = false;
+        }
+        samples_[i] = std::move(samples[i]);
+    }
+    speed_ = speed;
+    loop_ = loop;
+    start_ = std::chrono::steady_clock::now();
+    seek_ms_ = -1.0;
+    read_count_ = 0;
+    return 0;
+}
+
+void ReplaySensorBackend::set_thread_time_offset(double offset_ms) {
+    TIME_OFFSET_MS = offset_ms;
+}
+
+void ReplaySensorBackend::seek(double timestamp_ms) {
+    seek_ms_ = std::max(timestamp_ms, 0.0);
+}
+
+double ReplaySensorBackend::first_timestamp_ms() const {
+    return first_timestamp_ms_;
+}
+
+double ReplaySensorBackend::last_timestamp_ms() const {
+    return last_timestamp_ms_;
+}
+
+uint64_t ReplaySensorBackend::read_count() const {
+    return read_count_;
+}
+
+const ReplaySensorBackend::Sample *
+ReplaySensorBackend::current(SensorType type) const {
+    const std::vector<Sample> &samples = samples_[(size_t) type];
+    if (samples.empty()) {
+        return nullptr;
+    }
+    double trace_ms = seek_ms_;
+    if (trace_ms < 0.0) {
+        // The trace starts with its first reading, whatever its timestamp is
+        trace_ms = first_timestamp_ms_
+                   + std::chrono::duration<double, std::milli>(
+                             std::chrono::steady_clock::now() - start_)
+                                     .count()
+                             * speed_
+                   + TIME_OFFSET_MS;
+        const double span_ms = last_timestamp_ms_ - first_timestamp_ms_;
+        if (loop_ && trace_ms > last_timestamp_ms_ && span_ms > 0.0) {
+            trace_ms = first_timestamp_ms_
+                       + std::fmod(trace_ms - first_timestamp_ms_, span_ms);
+        }
+    }
+    auto it = std::upper_bound(samples.begin(), samples.end(), trace_ms,
+                               [](double timestamp_ms, const Sample &sample) {
+                                   return timestamp_ms < sample.timestamp_ms;
+                               });
+    return it == samples.begin() ? &samples.front() : &*(it - 1);
+}
+
+int ReplaySensorBackend::enable(SensorType type) {
+    return samples_[(size_t) type].empty() ? -1 : 0;
+}
+
+int ReplaySensorBackend::disable(SensorType type) {
+    (void) type;
+    return 0;
+}
+
+int ReplaySensorBackend::read_scalar(SensorType type, float *out_value) {
+    if (type != SensorType::BAROMETER && type != SensorType::HUMIDITY) {
+        return -1;
+    }
+    const Sample *sample = current(type);
+    if (!sample) {
+        return -1;
+    }
+    *out_value = sample->values[0];
+    ++read_count_;
+    return 0;
+}
+
+int ReplaySensorBackend::read_axes(SensorType type, int32_t *out_axes) {
+    if (type != SensorType::ACCELEROMETER
+        && type != SensorType::MAGNETOMETER) {
+        return -1;
+    }
+    const Sample *sample = current(type);
+    if (!sample) {
+        return -1;
+    }
+    for (size_t i = 0; i < 3; ++i) {
+        out_axes[i] = (int32_t) std::lround(sample->values[i]);
+    }
+    ++read_count_;
+    return 0;
+}
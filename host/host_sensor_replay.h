@@ -0,0 +1,118 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef HOST_SENSOR_REPLAY_H
+#define HOST_SENSOR_REPLAY_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "sensor_backend.h"
+
+/**
+ * Sensor backend replaying readings recorded in a CSV trace, so that
+ * notification rate, uplink traffic and CPU usage can be measured with the
+ * same input in every run. Each line of the trace holds a single reading:
+ *
+ *   TIMESTAMP_MS,SENSOR,VALUE[,Y,Z]
+ *
+ * where SENSOR is one of: barometer (hPa), humidity (%RH), accelerometer
+ * (X,Y,Z in mg), magnetometer (X,Y,Z in mgauss). Empty lines and lines
+ * starting with '#' are ignored; readings do not need to be sorted.
+ *
+ * A read returns the latest reading whose timestamp has passed. The trace
+ * time starts at the first reading of the trace when it is loaded, and runs
+ * at the replay speed, unless set explicitly with seek(). After the last
+ * reading, the trace either starts over or the last reading is held.
+ * Sensors without any readings in the trace fail to enable, so the
+ * corresponding Objects are not installed.
+ *
+ * Unless seek() is used, the backend is not modified after loading, so a
+ * single instance may be shared by clients running in multiple threads.
+ */
+class ReplaySensorBackend : public SensorBackend {
+    struct Sample {
+        double timestamp_ms;
+        float values[3];
+    };
+
+    std::vector<Sample> samples_[SENSOR_TYPE_COUNT];
+    double first_timestamp_ms_;
+    double last_timestamp_ms_;
+    double speed_;
+    bool loop_;
+    std::chrono::steady_clock::time_point start_;
+    // Negative while replaying in real time
+    double seek_ms_;
+    std::atomic<uint64_t> read_count_;
+
+    const Sample *current(SensorType type) const;
+
+public:
+    ReplaySensorBackend();
+
+    /**
+     * Loads the trace from @p path, replacing any previously loaded one, and
+     * restarts the replay.
+     *
+     * @param speed Replay speed; 2.0 replays the trace twice as fast as it
+     *              was recorded.
+     * @param loop  Whether to start over after the last reading.
+     *
+     * @returns 0 on success, negative value in case of error.
+     */
+    int load(const std::string &path, double speed, bool loop);
+
+    /**
+     * Shifts the replay for the calling thread by @p offset_ms of trace
+     * time, so that clients sharing the trace do not report the same
+     * readings at the same time.
+     */
+    static void set_thread_time_offset(double offset_ms);
+
+    /**
+     * Stops replaying in real time; until the next load(), reads return the
+     * readings at @p timestamp_ms of the trace. Lets a single-threaded
+     * driver step through the trace deterministically.
+     */
+    void seek(double timestamp_ms);
+
+    /**
+     * @returns Timestamp of the first reading in the trace.
+     */
+    double first_timestamp_ms() const;
+
+    /**
+     * @returns Timestamp of the last reading in the trace.
+     */
+    double last_timestamp_ms() const;
+
+    /**
+     * @returns Number of successful reads since the trace has been loaded.
+     */
+    uint64_t read_count() const;
+
+    int enable(SensorType type) override;
+    int disable(SensorType type) override;
+    int read_scalar(SensorType type, float *out_value) override;
+    int read_axes(SensorType type, int32_t *out_axes) override;
+};
+
+#endif // HOST_SENSOR_REPLAY_H
@@ -0,0 +1,223 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Cost of a single log call for the calling thread, with the console
+ * emulated by a pipe that is drained at the rate of a UART (-b, in baud, 10
+ * bits per byte). Compares the previous log handler, which printed every
+ * message synchronously, with deferred_log_write() for messages that are
+ * buffered (INFO) and for errors, which are printed synchronously after
+ * flushing the buffer. Messages are logged in bursts of -n messages, with
+ * the console drained between the bursts; the results are printed to
+ * stderr.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+#include "deferred_log.h"
+
+namespace {
+
+struct BenchConfig {
+    unsigned messages = 200;
+    unsigned baud = 115200;
+    size_t message_size = 80;
+};
+
+/**
+ * Replaces stdout with a pipe that is read at the given baud rate.
+ */
+class SlowConsole {
+    int saved_stdout_;
+    int read_fd_;
+    std::atomic<uint64_t> drained_;
+    std::thread reader_;
+
+    void read_loop(unsigned baud) {
+        char buf[16];
+        while (true) {
+            const ssize_t size = read(read_fd_, buf, sizeof(buf));
+            if (size <= 0) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(
+                    (uint64_t) size * 10 * 1000000 / baud));
+            drained_ += (uint64_t) size;
+        }
+    }
+
+public:
+    explicit SlowConsole(unsigned baud)
+            : saved_stdout_(dup(STDOUT_FILENO)),
+              read_fd_(-1),
+              drained_(0) {
+        int fds[2];
+        if (pipe(fds)) {
+            abort();
+        }
+        // The smallest buffer the kernel allows
+        fcntl(fds[1], F_SETPIPE_SZ, 4096);
+        fflush(stdout);
+        dup2(fds[1], STDOUT_FILENO);
+        close(fds[1]);
+        read_fd_ = fds[0];
+        // Like the console on the device
+        setvbuf(stdout, nullptr, _IOLBF, BUFSIZ);
+        reader_ = std::thread(&SlowConsole::read_loop, this, baud);
+    }
+
+    ~SlowConsole() {
+        fflush(stdout);
+        dup2(saved_stdout_, STDOUT_FILENO);
+        close(saved_stdout_);
+        reader_.join();
+        close(read_fd_);
+    }
+
+    // Waits until nothing has been drained for a while, i.e. the log
+    // thread has printed everything
+    void drain() {
+        fflush(stdout);
+        uint64_t drained;
+        do {
+            drained = drained_;
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        } while (drained_ != drained);
+    }
+};
+
+enum class Mode { SYNCHRONOUS, DEFERRED, DEFERRED_ERROR };
+
+const char *mode_name(Mode mode) {
+    switch (mode) {
+    case Mode::SYNCHRONOUS:
+        return "printf";
+    case Mode::DEFERRED:
+        return "deferred";
+    case Mode::DEFERRED_ERROR:
+        return "deferred-error";
+    }
+    return "";
+}
+
+// The previous log handler
+void log_synchronously(const char *message) {
+    printf("%s\n", message);
+}
+
+struct Result {
+    double mean_us;
+    double max_us;
+    uint32_t dropped;
+};
+
+Result run_burst(Mode mode, const BenchConfig &config, const char *message) {
+    const uint32_t dropped_before = deferred_log_dropped();
+    double total_us = 0;
+    double max_us = 0;
+    for (unsigned i = 0; i < config.messages; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        switch (mode) {
+        case Mode::SYNCHRONOUS:
+            log_synchronously(message);
+            break;
+        case Mode::DEFERRED:
+            deferred_log_write(AVS_LOG_INFO, message);
+            break;
+        case Mode::DEFERRED_ERROR:
+            deferred_log_write(AVS_LOG_ERROR, message);
+            break;
+        }
+        const double us = std::chrono::duration<double, std::micro>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count();
+        total_us += us;
+        max_us = std::max(max_us, us);
+    }
+    return Result{ total_us / config.messages, max_us,
+                   deferred_log_dropped() - dropped_before };
+}
+
+void print_usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [-n MESSAGES] [-b BAUD] [-s MESSAGE_SIZE]\n"
+            "\n"
+            "  -n  messages per burst (default: 200)\n"
+            "  -b  emulated console speed (default: 115200)\n"
+            "  -s  message length in bytes (default: 80)\n",
+            argv0);
+}
+
+int parse_args(int argc, char **argv, BenchConfig *config) {
+    int opt;
+    while ((opt = getopt(argc, argv, "n:b:s:h")) != -1) {
+        switch (opt) {
+        case 'n':
+            config->messages = (unsigned) strtoul(optarg, nullptr, 0);
+            break;
+        case 'b':
+            config->baud = (unsigned) strtoul(optarg, nullptr, 0);
+            break;
+        case 's':
+            config->message_size = strtoul(optarg, nullptr, 0);
+            break;
+        default:
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+    if (!config->messages || !config->baud || !config->message_size) {
+        print_usage(argv[0]);
+        return -1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    BenchConfig config;
+    if (parse_args(argc, argv, &config)) {
+        return EXIT_FAILURE;
+    }
+    const std::string message(config.message_size, 'x');
+
+    fprintf(stderr, "%u messages of %zu B per burst, console at %u baud\n",
+            config.messages, config.message_size, config.baud);
+    fprintf(stderr, "%-16s %12s %12s %8s\n", "mode", "mean us", "max us",
+            "dropped");
+    SlowConsole console(config.baud);
+    if (deferred_log_start()) {
+        return EXIT_FAILURE;
+    }
+    for (Mode mode :
+         { Mode::SYNCHRONOUS, Mode::DEFERRED, Mode::DEFERRED_ERROR }) {
+        const Result r = run_burst(mode, config, message.c_str());
+        fprintf(stderr, "%-16s %12.1f %12.1f %8u\n", mode_name(mode),
+                r.mean_us, r.max_us, r.dropped);
+        console.drain();
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,399 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/**
+ * Compares the cost of observing the sensor Objects with one observation per
+ * Resource against a single LwM2M 1.1 Composite-Observe of all of them. The
+ * client replays a sensor trace, stepped deterministically one sampling
+ * period at a time, and the tool plays the role of the LwM2M Server over a
+ * loopback UDP socket, counting notifications, their size and the CPU time
+ * spent per sampling period.
+ *
+ * All sensor Objects are sampled within a single scheduler job, so that the
+ * values changed in the same period are carried by a single composite
+ * notification; the exit code is non-zero if the composite observation
+ * receives more notifications than there are sampling periods.
+ */
+
+#include <cinttypes>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include <CellularNetwork.h>
+
+#include <anjay/access_control.h>
+#include <anjay/anjay.h>
+#include <anjay/security.h>
+#include <anjay/server.h>
+#include <avsystem/commons/avs_log.h>
+#include <avsystem/commons/avs_time.h>
+
+#include "host_coap.h"
+#include "host_common.h"
+#include "host_sensor_replay.h"
+#include "object_registry.h"
+
+namespace {
+
+double thread_cpu_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Limit of scheduler passes needed to flush the notifications of a single
+// sampling period; jobs may schedule further jobs to be run immediately
+constexpr size_t MAX_FLUSH_PASSES = 16;
+
+struct SensorPaths {
+    SensorType type;
+    anjay_oid_t oid;
+    std::vector<anjay_rid_t> rids;
+};
+
+const SensorPaths SENSOR_PATHS[] = {
+    { SensorType::HUMIDITY, 3304, { 5700 } },
+    { SensorType::BAROMETER, 3315, { 5700 } },
+    { SensorType::MAGNETOMETER, 3314, { 5702, 5703, 5704 } },
+    { SensorType::ACCELEROMETER, 3313, { 5702, 5703, 5704 } }
+};
+
+enum class Mode { PER_RESOURCE, COMPOSITE };
+
+struct BenchConfig {
+    std::string sensor_trace;
+    uint32_t tick_ms = MBED_CONF_APP_SENSOR_SAMPLE_PERIOD_MS;
+};
+
+struct Result {
+    const char *name;
+    size_t observations;
+    size_t ticks;
+    uint64_t notifications;
+    uint64_t notification_bytes;
+    // Spent updating the Objects and sending the notifications
+    double cpu_ns;
+};
+
+struct ObservedResource {
+    anjay_oid_t oid;
+    anjay_rid_t rid;
+
+    std::string to_string() const {
+        return "/" + std::to_string(oid) + "/0/" + std::to_string(rid);
+    }
+};
+
+std::vector<uint8_t> make_write_attributes_request(anjay_oid_t oid) {
+    return coap_serialize(
+            COAP_CODE_PUT,
+            { coap_string_option(COAP_OPT_URI_PATH, std::to_string(oid)),
+              coap_string_option(COAP_OPT_URI_QUERY, "pmin=0") });
+}
+
+std::vector<uint8_t> make_observe_request(const ObservedResource &resource) {
+    return coap_serialize(
+            COAP_CODE_GET,
+            { coap_string_option(COAP_OPT_URI_PATH,
+                                 std::to_string(resource.oid)),
+              coap_string_option(COAP_OPT_URI_PATH, "0"),
+              coap_string_option(COAP_OPT_URI_PATH,
+                                 std::to_string(resource.rid)),
+              CoapOption{ COAP_OPT_OBSERVE, {} } });
+}
+
+/**
+ * Composite-Observe: FETCH on the root path, with the observed paths listed
+ * in a SenML CBOR payload, i.e. an array of maps with the Name (0) label.
+ */
+std::vector<uint8_t>
+make_composite_observe_request(const std::vector<ObservedResource> &resources) {
+    std::vector<uint8_t> payload;
+    payload.push_back((uint8_t) (0x80 | resources.size()));
+    for (const ObservedResource &resource : resources) {
+        const std::string name = resource.to_string();
+        payload.push_back(0xA1);
+        payload.push_back(0x00);
+        payload.push_back((uint8_t) (0x60 | name.size()));
+        payload.insert(payload.end(), name.begin(), name.end());
+    }
+    return coap_serialize(
+            COAP_CODE_FETCH,
+            { CoapOption{ COAP_OPT_OBSERVE, {} },
+              CoapOption{ COAP_OPT_CONTENT_FORMAT,
+                          coap_encode_uint(COAP_FORMAT_SENML_CBOR) },
+              CoapOption{ COAP_OPT_ACCEPT,
+                          coap_encode_uint(COAP_FORMAT_SENML_CBOR) } },
+            nullptr, payload);
+}
+
+/**
+ * Flushes the notifications triggered by the last sampling and accounts
+ * those received for any of the @p tokens of the observations.
+ */
+void collect_notifications(anjay_t *anjay,
+                           LoopbackServer &server,
+                           const std::set<uint32_t> &tokens,
+                           Result *result) {
+    for (size_t i = 0; i < MAX_FLUSH_PASSES; ++i) {
+        anjay_sched_run(anjay);
+        avs_time_duration_t delay;
+        if (anjay_sched_time_to_next(anjay, &delay)
+            || avs_time_duration_less(AVS_TIME_DURATION_ZERO, delay)) {
+            break;
+        }
+    }
+    // Datagrams sent over the loopback interface are queued immediately
+    CoapView msg;
+    while (!server.receive(&msg, 0)) {
+        if (msg.type == COAP_TYPE_ACK || !tokens.count(coap_token(msg))) {
+            continue;
+        }
+        ++result->notifications;
+        result->notification_bytes += msg.size;
+        if (msg.type == COAP_TYPE_CON) {
+            const std::vector<uint8_t> ack = {
+                (uint8_t) ((COAP_VERSION << 6) | (COAP_TYPE_ACK << 4)),
+                COAP_CODE_EMPTY, (uint8_t) (msg.msg_id >> 8),
+                (uint8_t) msg.msg_id
+            };
+            server.send(ack);
+            server.serve_client(0);
+        }
+    }
+}
+
+/**
+ * Sets up the observations in the given @p mode.
+ *
+ * @returns 0 on success, 1 if the mode is not supported by the Anjay build,
+ *          negative value on error.
+ */
+int observe(LoopbackServer &server,
+            Mode mode,
+            const std::vector<ObservedResource> &resources,
+            std::set<uint32_t> *out_tokens) {
+    std::set<anjay_oid_t> oids;
+    for (const ObservedResource &resource : resources) {
+        oids.insert(resource.oid);
+    }
+    // Notifications shall only be limited by the sampling period
+    for (anjay_oid_t oid : oids) {
+        std::vector<uint8_t> request = make_write_attributes_request(oid);
+        CoapView response;
+        if (server.exchange(&request, &response)
+            || response.code != COAP_CODE_CHANGED) {
+            fprintf(stderr, "cannot set attributes of /%u\n", (unsigned) oid);
+            return -1;
+        }
+    }
+
+    std::vector<std::vector<uint8_t>> requests;
+    if (mode == Mode::COMPOSITE) {
+        requests.push_back(make_composite_observe_request(resources));
+    } else {
+        for (const ObservedResource &resource : resources) {
+            requests.push_back(make_observe_request(resource));
+        }
+    }
+    for (std::vector<uint8_t> &request : requests) {
+        CoapView response;
+        if (server.exchange(&request, &response)) {
+            fprintf(stderr, "no response to Observe\n");
+            return -1;
+        }
+        if (response.code != COAP_CODE_CONTENT) {
+            return mode == Mode::COMPOSITE ? 1 : -1;
+        }
+        out_tokens->insert(coap_token(response));
+    }
+    return 0;
+}
+
+/**
+ * @returns 0 on success, 1 if the mode is not supported by the Anjay build,
+ *          negative value on error.
+ */
+int run_mode(ReplaySensorBackend &replay,
+             const BenchConfig &config,
+             Mode mode,
+             Result *out) {
+    std::vector<ObservedResource> resources;
+    for (const SensorPaths &sensor : SENSOR_PATHS) {
+        if (!replay.enable(sensor.type)) {
+            for (anjay_rid_t rid : sensor.rids) {
+                resources.push_back(ObservedResource{ sensor.oid, rid });
+            }
+        }
+    }
+    if (resources.empty()) {
+        fprintf(stderr, "%s: no sensor readings\n",
+                config.sensor_trace.c_str());
+        return -1;
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->name = mode == Mode::COMPOSITE ? "composite" : "per-resource";
+    replay.seek(replay.first_timestamp_ms());
+
+    anjay_configuration_t anjay_config;
+    memset(&anjay_config, 0, sizeof(anjay_config));
+    anjay_config.endpoint_name = "observe-bench";
+    // Same as on the device
+    anjay_config.in_buffer_size = MBED_CONF_APP_COAP_IN_BUFFER_SIZE;
+    anjay_config.out_buffer_size = MBED_CONF_APP_COAP_OUT_BUFFER_SIZE;
+    anjay_config.msg_cache_size = MBED_CONF_APP_COAP_MSG_CACHE_SIZE;
+    anjay_config.disable_legacy_server_initiated_bootstrap = true;
+
+    anjay_t *anjay = anjay_new(&anjay_config);
+    if (!anjay) {
+        fprintf(stderr, "could not create anjay object\n");
+        return -1;
+    }
+
+    int result = -1;
+    mbed::CellularNetwork network;
+    LoopbackServer server(anjay);
+    std::set<uint32_t> tokens;
+    uint16_t port;
+    if (server.open(&port)) {
+        fprintf(stderr, "could not open the server socket\n");
+        goto finish;
+    }
+    if (anjay_security_object_install(anjay)
+        || anjay_server_object_install(anjay)
+        || anjay_access_control_install(anjay)
+        || host_configure_nosec_server(
+                   anjay, ("coap://127.0.0.1:" + std::to_string(port)).c_str(),
+                   false, 86400)
+        || object_registry_install(anjay, &network)) {
+        fprintf(stderr, "could not set up the data model\n");
+        goto finish;
+    }
+    if (server.wait_for_registration()) {
+        fprintf(stderr, "the client did not register\n");
+        goto finish;
+    }
+    if ((result = observe(server, mode, resources, &tokens))) {
+        goto finish;
+    }
+    out->observations = tokens.size();
+
+    for (double t = replay.first_timestamp_ms();
+         t <= replay.last_timestamp_ms(); t += config.tick_ms) {
+        replay.seek(t);
+        const double cpu_before = thread_cpu_ns();
+        object_registry_update(anjay);
+        collect_notifications(anjay, server, tokens, out);
+        out->cpu_ns += thread_cpu_ns() - cpu_before;
+        ++out->ticks;
+    }
+
+finish:
+    object_registry_uninstall(anjay);
+    anjay_delete(anjay);
+    return result;
+}
+
+void print_usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s -S SENSOR_TRACE [-t SAMPLE_PERIOD_MS]\n"
+            "\n"
+            "  -S  sensor trace to replay, see anjay-mbedos-client-host -h\n"
+            "  -t  sampling period in milliseconds of trace time\n"
+            "      (default: %d)\n",
+            argv0, MBED_CONF_APP_SENSOR_SAMPLE_PERIOD_MS);
+}
+
+int parse_args(int argc, char **argv, BenchConfig *config) {
+    int opt;
+    while ((opt = getopt(argc, argv, "S:t:h")) != -1) {
+        switch (opt) {
+        case 'S':
+            config->sensor_trace = optarg;
+            break;
+        case 't':
+            config->tick_ms = (uint32_t) strtoul(optarg, nullptr, 10);
+            if (!config->tick_ms) {
+                fprintf(stderr, "invalid sample period: %s\n", optarg);
+                return -1;
+            }
+            break;
+        default:
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+    if (config->sensor_trace.empty()) {
+        print_usage(argv[0]);
+        return -1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    BenchConfig config;
+    if (parse_args(argc, argv, &config)) {
+        return EXIT_FAILURE;
+    }
+    avs_log_set_default_level(AVS_LOG_WARNING);
+
+    ReplaySensorBackend replay;
+    if (replay.load(config.sensor_trace, 1.0, false)) {
+        return EXIT_FAILURE;
+    }
+    sensor_backend_set(replay);
+
+    printf("%-14s %12s %8s %14s %12s %10s %8s %10s\n", "mode",
+           "observations", "periods", "notifications", "notif/period",
+           "bytes", "B/notif", "us/period");
+    int result = EXIT_SUCCESS;
+    for (Mode mode : { Mode::PER_RESOURCE, Mode::COMPOSITE }) {
+        Result r;
+        const int status = run_mode(replay, config, mode, &r);
+        if (status < 0) {
+            return EXIT_FAILURE;
+        }
+        if (status > 0) {
+            printf("%-14s %12s\n", r.name, "unsupported");
+            continue;
+        }
+        printf("%-14s %12zu %8zu %14" PRIu64 " %12.2f %10" PRIu64
+               " %8.1f %10.1f\n",
+               r.name, r.observations, r.ticks, r.notifications,
+               (double) r.notifications / r.ticks, r.notification_bytes,
+               r.notifications
+                       ? (double) r.notification_bytes / r.notifications
+                       : 0.0,
+               r.cpu_ns / 1000.0 / r.ticks);
+        if (mode == Mode::COMPOSITE && r.notifications > r.ticks) {
+            printf("Composite notifications have not been coalesced within "
+                   "sampling periods\n");
+            result = EXIT_FAILURE;
+        }
+    }
+    return result;
+}
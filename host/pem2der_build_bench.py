@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+#
+# Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+import contextlib
+"""
+Build-time benchmark of the compile-time PEM decoding
+(anjay-mbed-fota/anjay_mbed_fota_conversions.h).
+
+For every input size, generates a translation unit that decodes a PEM chain
+of DER SEQUENCEs of that total size with pem2der(), and reports the time the
+compiler needs to check it (-fsyntax-only), minus the time needed for the
+same translation unit without the decoding. Pass --header to measure another
+version of the header, e.g. one extracted with git show.
+"""
+import argparse
+import base64
+import os
+import random
+import subprocess
+import sys
+import tempfile
+import time
+
+DEFAULT_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                              '..', 'anjay-mbed-fota',
+                              'anjay_mbed_fota_conversions.h')
+
+# Typical size of a DER-encoded certificate
+ELEMENT_SIZE = 512
+
+
+def der_sequence(content):
+    assert len(content) < 0x10000
+    return bytes([0x30, 0x82, len(content) >> 8, len(content) & 0xFF]) + content
+
+
+def make_pem_chain(total_size, rng):
+    pem = ''
+    remaining = total_size
+    while remaining > 0:
+        size = min(ELEMENT_SIZE, remaining)
+        element = der_sequence(bytes(rng.getrandbits(8)
+                                     for _ in range(max(size - 4, 0))))
+        remaining -= len(element)
+        encoded = base64.b64encode(element).decode()
+        lines = [encoded[i:i + 64] for i in range(0, len(encoded), 64)]
+        pem += ('-----BEGIN CERTIFICATE-----\n' + '\n'.join(lines)
+                + '\n-----END CERTIFICATE-----\n')
+    return pem
+
+
+def make_source(header, pem, decode):
+    literal = '\n'.join('"%s\\n"' % line for line in pem.splitlines())
+    source = '#include <cstdint>\n#include "%s"\n' % header
+    source += 'constexpr const char PEM[] =\n%s;\n' % literal
+    if decode:
+        source += ('constexpr auto DER = avs::constexpr_conversions::pem2der<'
+                   'sizeof(PEM), PEM>();\n'
+                   'static_assert(DER.size() > 0, "");\n')
+    return source
+
+
+def compile_time(args, source, directory):
+    path = os.path.join(directory, 'bench.cpp')
+    with open(path, 'w') as f:
+        f.write(source)
+    command = ([args.cxx, '-std=c++14', '-fsyntax-only'] + args.cxxflags
+               + [path])
+    best = None
+    for _ in range(args.repeat):
+        start = time.monotonic()
+        result = subprocess.run(command, stdout=subprocess.DEVNULL,
+                                stderr=subprocess.PIPE)
+        elapsed = time.monotonic() - start
+        if result.returncode:
+            sys.stderr.write(result.stderr.decode())
+            return None
+        best = elapsed if best is None else min(best, elapsed)
+    return best
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument('--header', default=DEFAULT_HEADER,
+                        help='Version of anjay_mbed_fota_conversions.h to measure')
+    parser.add_argument('--cxx', default=os.environ.get('CXX', 'c++'),
+                        help='Compiler to use (default: $CXX or c++)')
+    parser.add_argument('--sizes', default='512,2048,8192',
+                        help='Comma-separated DER sizes of the chains, in bytes')
+    parser.add_argument('--repeat', type=int, default=3,
+                        help='Number of compilations, the fastest one is reported')
+    parser.add_argument('--cxxflags', nargs=argparse.REMAINDER, default=[],
+                        help='Additional compiler flags, e.g. constexpr limits')
+    args = parser.parse_args()
+
+    header = os.path.abspath(args.header)
+    rng = random.Random(0)
+    print('%10s %10s %12s' % ('DER bytes', 'PEM bytes', 'decode ms'))
+    with tempfile.TemporaryDirectory() as directory:
+        for size in (int(s) for s in args.sizes.split(',')):
+            pem = make_pem_chain(size, rng)
+            baseline = compile_time(args, make_source(header, pem, False),
+                                    directory)
+            decoding = compile_time(args, make_source(header, pem, True),
+                                    directory)
+            if baseline is None or decoding is None:
+                print('%10d %10d %12s' % (size, len(pem), 'failed'))
+                continue
+            print('%10d %10d %12.1f' % (size, len(pem),
+                                        (decoding - baseline) * 1000))
+
+
+if __name__ == '__main__':
+    main()
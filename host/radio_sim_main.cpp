@@ -0,0 +1,246 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Estimates how long the radio is on per hour for a given traffic profile,
+ * with and without LwM2M Queue Mode, using the same CoAP transmission
+ * parameters and lifetimes as the client.
+ *
+ * The radio is modelled in three states:
+ * - connected, for a fixed time after the start of every exchange (i.e. the
+ *   transmission itself and the RRC inactivity timer of the network),
+ * - idle, monitoring paging; without Queue Mode PSM is disabled and the radio
+ *   never leaves this state, in Queue Mode it stays in it for the PSM active
+ *   time, i.e. MAX_TRANSMIT_WAIT, after the connection is released,
+ * - PSM, i.e. off.
+ *
+ * Exchanges are the uplink messages of the traffic profile (periodic, and/or
+ * read from a file) and Registration Updates, sent once per half of the
+ * lifetime.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#include "coap_params.h"
+
+namespace {
+
+// As set by configure_servers_from_config() in main.cpp
+constexpr double NON_QUEUE_MODE_LIFETIME_S = 50.0;
+
+struct SimConfig {
+    double send_period_s = MBED_CONF_APP_SEND_INTERVAL_MS / 1000.0;
+    std::string exchange_file;
+    double connected_s = 10.0;
+    double hours = 24.0;
+};
+
+struct Result {
+    double exchanges;
+    double connected_s;
+    double idle_s;
+    double psm_s;
+    double wakeups;
+};
+
+typedef std::vector<std::pair<double, double>> Intervals;
+
+// Sum of lengths of the union of the intervals, and the number of its
+// disjoint components
+std::pair<double, size_t> union_length(Intervals intervals) {
+    std::sort(intervals.begin(), intervals.end());
+    double length = 0.0;
+    size_t components = 0;
+    double start = 0.0;
+    double end = -1.0;
+    for (const auto &interval : intervals) {
+        if (interval.first > end) {
+            if (end >= start) {
+                length += end - start;
+            }
+            start = interval.first;
+            ++components;
+        }
+        end = std::max(end, interval.second);
+    }
+    if (end >= start) {
+        length += end - start;
+    }
+    return std::make_pair(length, components);
+}
+
+std::vector<double> exchange_times(const SimConfig &config,
+                                   const std::vector<double> &from_file,
+                                   double lifetime_s) {
+    const double duration_s = config.hours * 3600.0;
+    std::vector<double> times = from_file;
+    if (config.send_period_s > 0.0) {
+        for (double t = 0.0; t < duration_s; t += config.send_period_s) {
+            times.push_back(t);
+        }
+    }
+    for (double t = 0.0; t < duration_s; t += lifetime_s / 2.0) {
+        times.push_back(t);
+    }
+    times.erase(std::remove_if(times.begin(), times.end(),
+                               [&](double t) {
+                                   return t < 0.0 || t >= duration_s;
+                               }),
+                times.end());
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+    return times;
+}
+
+Result simulate(const SimConfig &config,
+                const std::vector<double> &from_file,
+                bool queue_mode) {
+    const double duration_s = config.hours * 3600.0;
+    const double lifetime_s = queue_mode ? MBED_CONF_APP_QUEUE_MODE_LIFETIME_S
+                                         : NON_QUEUE_MODE_LIFETIME_S;
+    const double active_time_s = coap_max_transmit_wait_s();
+    const std::vector<double> times =
+            exchange_times(config, from_file, lifetime_s);
+
+    Intervals connected;
+    Intervals on;
+    for (double t : times) {
+        const double connected_end =
+                std::min(duration_s, t + config.connected_s);
+        connected.emplace_back(t, connected_end);
+        on.emplace_back(t, std::min(duration_s, connected_end + active_time_s));
+    }
+    const double connected_s = union_length(connected).first;
+
+    Result result;
+    result.exchanges = (double) times.size();
+    result.connected_s = connected_s;
+    if (queue_mode) {
+        const std::pair<double, size_t> on_s = union_length(on);
+        result.idle_s = on_s.first - connected_s;
+        result.psm_s = duration_s - on_s.first;
+        result.wakeups = (double) on_s.second;
+    } else {
+        result.idle_s = duration_s - connected_s;
+        result.psm_s = 0.0;
+        result.wakeups = 0.0;
+    }
+    return result;
+}
+
+int load_exchange_file(const std::string &path, std::vector<double> *out) {
+    FILE *file = fopen(path.c_str(), "r");
+    if (!file) {
+        fprintf(stderr, "cannot open %s\n", path.c_str());
+        return -1;
+    }
+    char line[128];
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        char *end;
+        const double t = strtod(line, &end);
+        if (end == line) {
+            fprintf(stderr, "invalid line in %s: %s", path.c_str(), line);
+            fclose(file);
+            return -1;
+        }
+        out->push_back(t);
+    }
+    fclose(file);
+    return 0;
+}
+
+void print_usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [-p SEND_PERIOD_S] [-f EXCHANGE_FILE] "
+            "[-c CONNECTED_S] [-H HOURS]\n"
+            "\n"
+            "  -p  period of uplink exchanges in seconds, 0 for none\n"
+            "      (default: %g)\n"
+            "  -f  file with additional exchange times, in seconds from the\n"
+            "      start, one per line\n"
+            "  -c  time in seconds the radio stays connected after the start\n"
+            "      of an exchange (default: %g)\n"
+            "  -H  simulated time in hours (default: %g)\n",
+            argv0, SimConfig().send_period_s, SimConfig().connected_s,
+            SimConfig().hours);
+}
+
+int parse_args(int argc, char **argv, SimConfig *config) {
+    int opt;
+    while ((opt = getopt(argc, argv, "p:f:c:H:h")) != -1) {
+        switch (opt) {
+        case 'p':
+            config->send_period_s = strtod(optarg, nullptr);
+            break;
+        case 'f':
+            config->exchange_file = optarg;
+            break;
+        case 'c':
+            config->connected_s = strtod(optarg, nullptr);
+            break;
+        case 'H':
+            config->hours = strtod(optarg, nullptr);
+            break;
+        default:
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+    if (config->send_period_s < 0.0 || config->connected_s < 0.0
+        || config->hours <= 0.0) {
+        print_usage(argv[0]);
+        return -1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    SimConfig config;
+    if (parse_args(argc, argv, &config)) {
+        return EXIT_FAILURE;
+    }
+    std::vector<double> from_file;
+    if (!config.exchange_file.empty()
+        && load_exchange_file(config.exchange_file, &from_file)) {
+        return EXIT_FAILURE;
+    }
+
+    printf("PSM active time (MAX_TRANSMIT_WAIT): %d s\n",
+           coap_max_transmit_wait_s());
+    printf("%-12s %12s %12s %12s %12s %12s %12s\n", "binding", "exchanges/h",
+           "connected/h", "idle/h", "radio on/h", "psm/h", "wakeups/h");
+    for (bool queue_mode : { false, true }) {
+        const Result r = simulate(config, from_file, queue_mode);
+        const double hours = config.hours;
+        printf("%-12s %12.1f %11.1fs %11.1fs %11.1fs %11.1fs %12.1f\n",
+               queue_mode ? "UQ" : "U", r.exchanges / hours,
+               r.connected_s / hours, r.idle_s / hours,
+               (r.connected_s + r.idle_s) / hours, r.psm_s / hours,
+               r.wakeups / hours);
+    }
+    return EXIT_SUCCESS;
+}
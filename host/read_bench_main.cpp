@@ -0,0 +1,552 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * Microbenchmark of the data model read path: Read requests are issued to the
+ * application Objects through the complete Anjay stack, so that the cost of
+ * both the Object handlers (resource_read() etc.) and of the payload encoding
+ * is measured. The benchmark itself plays the role of the LwM2M Server over a
+ * loopback UDP socket, and drives the client synchronously with anjay_serve()
+ * on the same thread, so that every allocation made while handling a request
+ * is accounted to it.
+ *
+ * Results can be saved with -o and compared against a saved baseline with -b;
+ * the exit code is non-zero if any case is slower or allocates more than the
+ * baseline by more than the tolerance.
+ *
+ * The largest request and response messages and the use of block-wise
+ * transfers are reported as well, to validate the CoAP buffer sizes
+ * configured in mbed_app.json; the exit code is also non-zero if any
+ * response message does not fit in coap_out_buffer_size.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include <CellularNetwork.h>
+
+#include <anjay/access_control.h>
+#include <anjay/anjay.h>
+#include <anjay/security.h>
+#include <anjay/server.h>
+#include <avsystem/commons/avs_log.h>
+
+#include "host_alloc_stats.h"
+#include "host_coap.h"
+#include "host_common.h"
+#include "object_registry.h"
+
+namespace {
+
+constexpr size_t WARMUP_ITERATIONS = 10;
+
+struct Path {
+    anjay_oid_t oid;
+    anjay_iid_t iid;
+    anjay_rid_t rid;
+
+    std::string to_string() const {
+        std::string result = "/" + std::to_string(oid);
+        if (iid != ANJAY_ID_INVALID) {
+            result += "/" + std::to_string(iid);
+        }
+        if (rid != ANJAY_ID_INVALID) {
+            result += "/" + std::to_string(rid);
+        }
+        return result;
+    }
+};
+
+struct Format {
+    const char *name;
+    uint16_t content_format;
+};
+
+constexpr Format PLAINTEXT = { "text", 0 };
+constexpr Format TLV = { "tlv", 11542 };
+constexpr Format SENML_CBOR = { "senml-cbor", 112 };
+
+constexpr anjay_iid_t NO_IID = ANJAY_ID_INVALID;
+constexpr anjay_rid_t NO_RID = ANJAY_ID_INVALID;
+
+const Path PATHS[] = {
+    { 3, 0, 0 },              // Device: Manufacturer
+    { 3, 0, 13 },             // Device: Current Time
+    { 3, 0, NO_RID },         // Device instance
+    { 3, NO_IID, NO_RID },    // Device object
+    { 4, 0, 2 },              // Connectivity Monitoring: Radio Signal Strength
+    { 4, 0, NO_RID },         // Connectivity Monitoring instance
+    { 4, NO_IID, NO_RID },    // Connectivity Monitoring object
+    { 3315, 0, 5700 },        // Barometer: Sensor Value
+    { 3315, 0, NO_RID },      // Barometer instance
+    { 3315, NO_IID, NO_RID }, // Barometer object
+    { 26242, 0, NO_RID }      // System Health instance, the largest one
+};
+
+// Read of a nonexistent Resource: the cost of the transport and of request
+// dispatching, common to all the other cases
+constexpr Path BASELINE_PATH = { 3, 0, 65000 };
+
+struct BenchConfig {
+    size_t iterations = 1000;
+    std::string filter;
+    std::string output_file;
+    std::string baseline_file;
+    double tolerance_percent = 20.0;
+};
+
+struct Result {
+    std::string name;
+    double ns_per_op;
+    double allocs_per_op;
+    double bytes_per_op;
+    size_t response_size;
+    size_t blocks;
+    size_t max_request_msg_size;
+    size_t max_response_msg_size;
+};
+
+// Sizes of the messages exchanged in a single Read
+struct ReadStats {
+    size_t payload_size;
+    size_t blocks;
+    size_t max_request_msg_size;
+    size_t max_response_msg_size;
+};
+
+struct ReadCase {
+    std::string name;
+    Path path;
+    Format format;
+    uint8_t expected_code;
+    // Serialized requests for consecutive blocks of the response, built
+    // during the warm-up
+    std::vector<std::vector<uint8_t>> block_requests;
+};
+
+std::vector<uint8_t> make_read_request(const ReadCase &c, uint32_t block) {
+    std::vector<CoapOption> options;
+    options.push_back(
+            coap_string_option(COAP_OPT_URI_PATH, std::to_string(c.path.oid)));
+    if (c.path.iid != ANJAY_ID_INVALID) {
+        options.push_back(coap_string_option(
+                COAP_OPT_URI_PATH, std::to_string(c.path.iid)));
+    }
+    if (c.path.rid != ANJAY_ID_INVALID) {
+        options.push_back(coap_string_option(
+                COAP_OPT_URI_PATH, std::to_string(c.path.rid)));
+    }
+    options.push_back(CoapOption{ COAP_OPT_ACCEPT,
+                                  coap_encode_uint(c.format.content_format) });
+    if (block) {
+        // SZX 6, i.e. 1024-byte blocks; Anjay answers with the block size it
+        // actually uses
+        options.push_back(CoapOption{ COAP_OPT_BLOCK2,
+                                      coap_encode_uint((block << 4) | 6) });
+    }
+    return coap_serialize(COAP_CODE_GET, std::move(options));
+}
+
+class Bench {
+    LoopbackServer server_;
+
+public:
+    explicit Bench(anjay_t *anjay) : server_(anjay) {}
+
+    int open_server(uint16_t *out_port) {
+        return server_.open(out_port);
+    }
+
+    int wait_for_registration() {
+        return server_.wait_for_registration();
+    }
+
+    /**
+     * Performs a complete Read, following block-wise transfers if the
+     * response does not fit in a single message.
+     *
+     * @returns CoAP code of the (last) response, or 0 in case of a transport
+     *          error.
+     */
+    uint8_t read(ReadCase &c, ReadStats *out_stats) {
+        *out_stats = ReadStats{};
+        for (uint32_t block = 0;; ++block) {
+            if (block == c.block_requests.size()) {
+                c.block_requests.push_back(make_read_request(c, block));
+            }
+            CoapView response;
+            if (server_.exchange(&c.block_requests[block], &response)) {
+                return 0;
+            }
+            out_stats->payload_size += response.payload_size;
+            out_stats->blocks = block + 1;
+            out_stats->max_request_msg_size =
+                    std::max(out_stats->max_request_msg_size,
+                             c.block_requests[block].size());
+            out_stats->max_response_msg_size =
+                    std::max(out_stats->max_response_msg_size, response.size);
+            bool more_blocks = false;
+            coap_for_each_option(response, [&](uint16_t number,
+                                               const uint8_t *value,
+                                               size_t size) {
+                if (number == COAP_OPT_BLOCK2) {
+                    more_blocks = coap_decode_uint(value, size) & 0x08;
+                    return true;
+                }
+                return false;
+            });
+            if (response.code != COAP_CODE_CONTENT || !more_blocks) {
+                return response.code;
+            }
+        }
+    }
+};
+
+const char *code_name(uint8_t code) {
+    switch (code) {
+    case 0:
+        return "no response";
+    case COAP_CODE_NOT_FOUND:
+        return "4.04 Not Found";
+    case COAP_CODE_NOT_ACCEPTABLE:
+        return "4.06 Not Acceptable";
+    default:
+        return "unexpected response";
+    }
+}
+
+/**
+ * @returns 0 on success, 1 if the case is not supported by the Anjay build
+ *          (e.g. the content format), negative value on error.
+ */
+int run_case(Bench &bench,
+             const BenchConfig &config,
+             ReadCase &c,
+             Result *out) {
+    ReadStats stats;
+    for (size_t i = 0; i < WARMUP_ITERATIONS; ++i) {
+        const uint8_t code = bench.read(c, &stats);
+        if (code == COAP_CODE_NOT_ACCEPTABLE
+            && c.expected_code != COAP_CODE_NOT_ACCEPTABLE) {
+            return 1;
+        }
+        if (code != c.expected_code) {
+            fprintf(stderr, "%s: %s\n", c.name.c_str(), code_name(code));
+            return -1;
+        }
+    }
+
+    const HostAllocStats alloc_before = host_alloc_stats_get();
+    const auto time_before = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < config.iterations; ++i) {
+        if (bench.read(c, &stats) != c.expected_code) {
+            fprintf(stderr, "%s: request failed\n", c.name.c_str());
+            return -1;
+        }
+    }
+    const auto time_after = std::chrono::steady_clock::now();
+    const HostAllocStats alloc_after = host_alloc_stats_get();
+
+    out->name = c.name;
+    out->ns_per_op =
+            (double) std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    time_after - time_before)
+                    .count()
+            / config.iterations;
+    out->allocs_per_op = (double) (alloc_after.allocation_count
+                                   - alloc_before.allocation_count)
+                         / config.iterations;
+    out->bytes_per_op = (double) (alloc_after.allocated_bytes
+                                  - alloc_before.allocated_bytes)
+                        / config.iterations;
+    out->response_size = stats.payload_size;
+    out->blocks = stats.blocks;
+    out->max_request_msg_size = stats.max_request_msg_size;
+    out->max_response_msg_size = stats.max_response_msg_size;
+    return 0;
+}
+
+int save_results(const std::string &file, const std::vector<Result> &results) {
+    FILE *out = fopen(file.c_str(), "w");
+    if (!out) {
+        return -1;
+    }
+    fprintf(out, "case,ns_per_op,allocs_per_op,bytes_per_op\n");
+    for (const Result &result : results) {
+        fprintf(out, "%s,%.1f,%.2f,%.1f\n", result.name.c_str(),
+                result.ns_per_op, result.allocs_per_op, result.bytes_per_op);
+    }
+    return fclose(out) ? -1 : 0;
+}
+
+int load_baseline(const std::string &file, std::map<std::string, Result> *out) {
+    std::ifstream in(file);
+    if (!in) {
+        return -1;
+    }
+    std::string line;
+    std::getline(in, line); // header
+    while (std::getline(in, line)) {
+        char name[128];
+        Result result{};
+        if (sscanf(line.c_str(), "%127[^,],%lf,%lf,%lf", name,
+                   &result.ns_per_op, &result.allocs_per_op,
+                   &result.bytes_per_op)
+            != 4) {
+            return -1;
+        }
+        result.name = name;
+        (*out)[result.name] = result;
+    }
+    return 0;
+}
+
+/**
+ * @returns Number of cases that regressed against the baseline.
+ */
+size_t compare_with_baseline(const std::vector<Result> &results,
+                             const std::map<std::string, Result> &baseline,
+                             double tolerance_percent) {
+    const double factor = 1.0 + tolerance_percent / 100.0;
+    size_t regressions = 0;
+    for (const Result &result : results) {
+        auto it = baseline.find(result.name);
+        if (it == baseline.end()) {
+            continue;
+        }
+        const Result &base = it->second;
+        if (result.ns_per_op > base.ns_per_op * factor) {
+            printf("REGRESSION %s: %.0f ns/op, baseline %.0f ns/op\n",
+                   result.name.c_str(), result.ns_per_op, base.ns_per_op);
+            ++regressions;
+        }
+        if (result.bytes_per_op > base.bytes_per_op * factor) {
+            printf("REGRESSION %s: %.0f B/op allocated, baseline %.0f B/op\n",
+                   result.name.c_str(), result.bytes_per_op,
+                   base.bytes_per_op);
+            ++regressions;
+        }
+    }
+    return regressions;
+}
+
+void print_usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [-n ITERATIONS] [-f FILTER] [-o OUTPUT_CSV]\n"
+            "          [-b BASELINE_CSV] [-t TOLERANCE_PERCENT]\n"
+            "\n"
+            "  -n  iterations of every case (default: 1000)\n"
+            "  -f  only run cases whose name contains FILTER\n"
+            "  -o  save the results to OUTPUT_CSV\n"
+            "  -b  compare the results with BASELINE_CSV, saved earlier with\n"
+            "      -o, and fail if any case regressed\n"
+            "  -t  allowed regression, in percent (default: 20)\n",
+            argv0);
+}
+
+int parse_args(int argc, char **argv, BenchConfig *config) {
+    int opt;
+    while ((opt = getopt(argc, argv, "n:f:o:b:t:h")) != -1) {
+        switch (opt) {
+        case 'n':
+            config->iterations = strtoul(optarg, nullptr, 10);
+            if (!config->iterations) {
+                fprintf(stderr, "invalid number of iterations: %s\n",
+                        optarg);
+                return -1;
+            }
+            break;
+        case 'f':
+            config->filter = optarg;
+            break;
+        case 'o':
+            config->output_file = optarg;
+            break;
+        case 'b':
+            config->baseline_file = optarg;
+            break;
+        case 't':
+            config->tolerance_percent = atof(optarg);
+            break;
+        default:
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int run_all(Bench &bench,
+            const BenchConfig &config,
+            std::vector<Result> *out_results) {
+    std::vector<ReadCase> cases;
+    cases.push_back(ReadCase{ BASELINE_PATH.to_string() + " (not found)",
+                              BASELINE_PATH, PLAINTEXT, COAP_CODE_NOT_FOUND,
+                              {} });
+    for (const Path &path : PATHS) {
+        // Plain text can only represent a single Resource
+        if (path.rid != ANJAY_ID_INVALID) {
+            cases.push_back(ReadCase{ path.to_string() + " " + PLAINTEXT.name,
+                                      path, PLAINTEXT, COAP_CODE_CONTENT,
+                                      {} });
+        }
+        for (const Format &format : { TLV, SENML_CBOR }) {
+            cases.push_back(ReadCase{ path.to_string() + " " + format.name,
+                                      path, format, COAP_CODE_CONTENT, {} });
+        }
+    }
+
+    printf("%-32s %10s %10s %10s %10s %8s\n", "case", "ns/op", "allocs/op",
+           "B/op", "resp [B]", "blocks");
+    for (ReadCase &c : cases) {
+        if (c.name.find(config.filter) == std::string::npos) {
+            continue;
+        }
+        Result result;
+        const int status = run_case(bench, config, c, &result);
+        if (status < 0) {
+            return -1;
+        }
+        if (status > 0) {
+            printf("%-32s %10s\n", c.name.c_str(), "unsupported");
+            continue;
+        }
+        printf("%-32s %10.0f %10.2f %10.0f %10zu %8zu\n", c.name.c_str(),
+               result.ns_per_op, result.allocs_per_op, result.bytes_per_op,
+               result.response_size, result.blocks);
+        out_results->push_back(result);
+    }
+    return 0;
+}
+
+/**
+ * Prints the largest messages exchanged and the use of block-wise transfers
+ * against the configured CoAP buffer sizes.
+ *
+ * @returns 0 if all response messages fit in the outgoing buffer, -1
+ *          otherwise.
+ */
+int report_message_sizes(const std::vector<Result> &results,
+                         const anjay_configuration_t &anjay_config) {
+    size_t max_request = 0;
+    size_t max_response = 0;
+    size_t blockwise_cases = 0;
+    for (const Result &result : results) {
+        max_request = std::max(max_request, result.max_request_msg_size);
+        max_response = std::max(max_response, result.max_response_msg_size);
+        if (result.blocks > 1) {
+            ++blockwise_cases;
+        }
+    }
+    printf("\nlargest request:  %zu B (coap_in_buffer_size %zu B)\n"
+           "largest response: %zu B (coap_out_buffer_size %zu B)\n"
+           "block-wise:       %zu of %zu cases\n",
+           max_request, anjay_config.in_buffer_size, max_response,
+           anjay_config.out_buffer_size, blockwise_cases, results.size());
+    if (max_response > anjay_config.out_buffer_size) {
+        fprintf(stderr, "response larger than coap_out_buffer_size\n");
+        return -1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    BenchConfig config;
+    if (parse_args(argc, argv, &config)) {
+        return EXIT_FAILURE;
+    }
+    avs_log_set_default_level(AVS_LOG_WARNING);
+
+    anjay_configuration_t anjay_config;
+    memset(&anjay_config, 0, sizeof(anjay_config));
+    anjay_config.endpoint_name = "read-bench";
+    // Same as on the device
+    anjay_config.in_buffer_size = MBED_CONF_APP_COAP_IN_BUFFER_SIZE;
+    anjay_config.out_buffer_size = MBED_CONF_APP_COAP_OUT_BUFFER_SIZE;
+    anjay_config.msg_cache_size = MBED_CONF_APP_COAP_MSG_CACHE_SIZE;
+    anjay_config.disable_legacy_server_initiated_bootstrap = true;
+
+    anjay_t *anjay = anjay_new(&anjay_config);
+    if (!anjay) {
+        fprintf(stderr, "could not create anjay object\n");
+        return EXIT_FAILURE;
+    }
+
+    int result = EXIT_FAILURE;
+    mbed::CellularNetwork network;
+    Bench bench(anjay);
+    std::vector<Result> results;
+    uint16_t port;
+    if (bench.open_server(&port)) {
+        fprintf(stderr, "could not open the server socket\n");
+        goto finish;
+    }
+    if (anjay_security_object_install(anjay)
+        || anjay_server_object_install(anjay)
+        || anjay_access_control_install(anjay)
+        || host_configure_nosec_server(
+                   anjay, ("coap://127.0.0.1:" + std::to_string(port)).c_str(),
+                   false, 86400)
+        || object_registry_install(anjay, &network)) {
+        fprintf(stderr, "could not set up the data model\n");
+        goto finish;
+    }
+    if (bench.wait_for_registration()) {
+        fprintf(stderr, "the client did not register\n");
+        goto finish;
+    }
+    if (run_all(bench, config, &results)
+        || report_message_sizes(results, anjay_config)) {
+        goto finish;
+    }
+
+    if (!config.output_file.empty()
+        && save_results(config.output_file, results)) {
+        fprintf(stderr, "could not save the results to %s\n",
+                config.output_file.c_str());
+        goto finish;
+    }
+    if (!config.baseline_file.empty()) {
+        std::map<std::string, Result> baseline;
+        if (load_baseline(config.baseline_file, &baseline)) {
+            fprintf(stderr, "could not load the baseline from %s\n",
+                    config.baseline_file.c_str());
+            goto finish;
+        }
+        if (compare_with_baseline(results, baseline,
+                                  config.tolerance_percent)) {
+            goto finish;
+        }
+    }
+    result = EXIT_SUCCESS;
+
+finish:
+    object_registry_uninstall(anjay);
+    anjay_delete(anjay);
+    return result;
+}
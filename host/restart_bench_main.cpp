@@ -0,0 +1,207 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Heap fragmentation over repeated restarts of the LwM2M client. Every
+ * restart creates the Anjay object and the application Objects, updates them
+ * a few times and releases everything, like the device does when the
+ * configuration changes or the connection is lost.
+ *
+ * Other modules of the device (network stack, modem driver) keep their own
+ * allocations across restarts; this is emulated by allocating a block of
+ * pseudo-random size during every run that is only freed a few restarts
+ * later. The tool is built twice: anjay-mbedos-restart-bench with the
+ * Objects in static storage and anjay-mbedos-restart-bench-heap with
+ * APP_OBJECTS_ON_HEAP, i.e. allocating them on every restart (see
+ * static_object_storage.h). Heap usage is accounted with host_alloc_stats,
+ * and the free memory held by the allocator with mallinfo2() (glibc only).
+ */
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <malloc.h>
+#include <unistd.h>
+
+#include <CellularNetwork.h>
+
+#include <anjay/access_control.h>
+#include <anjay/anjay.h>
+#include <anjay/security.h>
+#include <anjay/server.h>
+#include <avsystem/commons/avs_log.h>
+
+#include "host_alloc_stats.h"
+#include "host_common.h"
+#include "object_registry.h"
+
+namespace {
+
+struct BenchConfig {
+    unsigned restarts = 1000;
+    unsigned updates = 10;
+    size_t retained = 4;
+};
+
+class RetainedBlocks {
+    std::deque<void *> blocks_;
+    size_t max_blocks_;
+    uint32_t state_;
+
+public:
+    explicit RetainedBlocks(size_t max_blocks)
+            : blocks_(), max_blocks_(max_blocks), state_(0x12345678) {}
+
+    ~RetainedBlocks() {
+        for (void *block : blocks_) {
+            free(block);
+        }
+    }
+
+    void allocate() {
+        state_ = state_ * 1103515245 + 12345;
+        blocks_.push_back(malloc(32 + (state_ >> 16) % 480));
+        if (blocks_.size() > max_blocks_) {
+            free(blocks_.front());
+            blocks_.pop_front();
+        }
+    }
+};
+
+int run_client(const BenchConfig &config, RetainedBlocks &retained) {
+    anjay_configuration_t anjay_config;
+    memset(&anjay_config, 0, sizeof(anjay_config));
+    anjay_config.endpoint_name = "restart-bench";
+    // Same as on the device
+    anjay_config.in_buffer_size = MBED_CONF_APP_COAP_IN_BUFFER_SIZE;
+    anjay_config.out_buffer_size = MBED_CONF_APP_COAP_OUT_BUFFER_SIZE;
+    anjay_config.msg_cache_size = MBED_CONF_APP_COAP_MSG_CACHE_SIZE;
+    anjay_config.disable_legacy_server_initiated_bootstrap = true;
+
+    anjay_t *anjay = anjay_new(&anjay_config);
+    if (!anjay) {
+        fprintf(stderr, "could not create anjay object\n");
+        return -1;
+    }
+
+    int result = -1;
+    mbed::CellularNetwork network;
+    // The server is never contacted, as the scheduler is not run
+    if (anjay_security_object_install(anjay)
+        || anjay_server_object_install(anjay)
+        || anjay_access_control_install(anjay)
+        || host_configure_nosec_server(anjay, "coap://127.0.0.1:5683", false,
+                                       86400)
+        || object_registry_install(anjay, &network)) {
+        fprintf(stderr, "could not set up the data model\n");
+        goto finish;
+    }
+    retained.allocate();
+    for (unsigned i = 0; i < config.updates; ++i) {
+        object_registry_update(anjay);
+    }
+    result = 0;
+
+finish:
+    object_registry_uninstall(anjay);
+    anjay_delete(anjay);
+    return result;
+}
+
+bool is_checkpoint(unsigned restart, unsigned restarts) {
+    if (restart == restarts) {
+        return true;
+    }
+    while (restart % 10 == 0) {
+        restart /= 10;
+    }
+    return restart == 1;
+}
+
+void print_usage(const char *argv0) {
+    fprintf(stderr,
+            "Usage: %s [-n RESTARTS] [-u UPDATES] [-k RETAINED]\n"
+            "\n"
+            "  -n  number of restarts of the client (default: 1000)\n"
+            "  -u  Object updates per run (default: 10)\n"
+            "  -k  number of blocks of other modules kept allocated\n"
+            "      across restarts (default: 4)\n",
+            argv0);
+}
+
+int parse_args(int argc, char **argv, BenchConfig *config) {
+    int opt;
+    while ((opt = getopt(argc, argv, "n:u:k:h")) != -1) {
+        switch (opt) {
+        case 'n':
+            config->restarts = (unsigned) strtoul(optarg, nullptr, 0);
+            break;
+        case 'u':
+            config->updates = (unsigned) strtoul(optarg, nullptr, 0);
+            break;
+        case 'k':
+            config->retained = strtoul(optarg, nullptr, 0);
+            break;
+        default:
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+    if (!config->restarts) {
+        print_usage(argv[0]);
+        return -1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    BenchConfig config;
+    if (parse_args(argc, argv, &config)) {
+        return EXIT_FAILURE;
+    }
+    avs_log_set_default_level(AVS_LOG_WARNING);
+
+#ifdef APP_OBJECTS_ON_HEAP
+    printf("Objects allocated on the heap on every restart\n");
+#else  // APP_OBJECTS_ON_HEAP
+    printf("Objects constructed in static storage\n");
+#endif // APP_OBJECTS_ON_HEAP
+    printf("%8s %12s %12s %10s %10s %12s %10s\n", "restart", "allocs/run",
+           "in use B", "peak B", "arena B", "free B", "free chunks");
+
+    RetainedBlocks retained(config.retained);
+    for (unsigned restart = 1; restart <= config.restarts; ++restart) {
+        const HostAllocStats before = host_alloc_stats_get();
+        if (run_client(config, retained)) {
+            return EXIT_FAILURE;
+        }
+        if (!is_checkpoint(restart, config.restarts)) {
+            continue;
+        }
+        const HostAllocStats after = host_alloc_stats_get();
+        const struct mallinfo2 info = mallinfo2();
+        printf("%8u %12" PRIu64 " %12" PRId64 " %10" PRId64 " %10zu %12zu "
+               "%10zu\n",
+               restart, after.allocation_count - before.allocation_count,
+               after.current_bytes, after.peak_bytes, info.arena,
+               info.fordblks, info.ordblks + info.smblks);
+    }
+    return EXIT_SUCCESS;
+}
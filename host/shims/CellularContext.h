@@ -0,0 +1,48 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef HOST_CELLULAR_CONTEXT_H
+#define HOST_CELLULAR_CONTEXT_H
+
+#include <string>
+
+#include "SocketAddress.h"
+#include "nsapi_types.h"
+
+namespace mbed {
+
+/**
+ * Fake of the Mbed OS cellular context, reporting fixed addresses.
+ */
+class CellularContext {
+    std::string ip_address_;
+    std::string gateway_;
+
+public:
+    CellularContext();
+
+    static CellularContext *get_default_instance();
+
+    void set_addresses(const char *ip_address, const char *gateway);
+
+    nsapi_error_t get_ip_address(SocketAddress *address);
+    nsapi_error_t get_gateway(SocketAddress *address);
+};
+
+} // namespace mbed
+
+#endif // HOST_CELLULAR_CONTEXT_H
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef HOST_CELLULAR_NETWORK_H
+#define HOST_CELLULAR_NETWORK_H
+
+#include <cstddef>
+#include <vector>
+
+#include "nsapi_types.h"
+
+namespace mbed {
+
+/**
+ * Fake of the Mbed OS cellular network, replaying a scripted sequence of
+ * signal quality readings.
+ */
+class CellularNetwork {
+    std::vector<int> rssi_script_;
+    size_t rssi_index_;
+
+public:
+    enum { SignalQualityUnknown = 99 };
+
+    enum RadioAccessTechnology {
+        RAT_GSM,
+        RAT_GSM_COMPACT,
+        RAT_UTRAN,
+        RAT_EGPRS,
+        RAT_HSDPA,
+        RAT_HSUPA,
+        RAT_HSDPA_HSUPA,
+        RAT_E_UTRAN,
+        RAT_CATM1,
+        RAT_NB1,
+        RAT_UNKNOWN,
+        RAT_MAX = 11
+    };
+
+    CellularNetwork();
+
+    /**
+     * Sets the RSSI values (in dBm) returned by subsequent calls to
+     * get_signal_quality(), cyclically.
+     */
+    void set_signal_quality_script(std::vector<int> rssi_dbm);
+
+    nsapi_error_t get_signal_quality(int &rssi, int *ber = nullptr);
+};
+
+} // namespace mbed
+
+#endif // HOST_CELLULAR_NETWORK_H
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOST_EVENT_QUEUE_H
+#define HOST_EVENT_QUEUE_H
+
+#include <chrono>
+#include <functional>
+
+namespace events {
+
+/**
+ * Event queue with the subset of the Mbed OS EventQueue API used by the
+ * application. Events are run by whichever thread dispatches the queue.
+ *
+ * In addition to real time dispatching, the queue may be driven in
+ * simulated time with advance(), so that tests do not have to wait for
+ * delayed events.
+ */
+class EventQueue {
+public:
+    using duration = std::chrono::duration<int, std::milli>;
+
+private:
+    struct Impl;
+    Impl *impl_;
+
+    EventQueue(const EventQueue &) = delete;
+    EventQueue &operator=(const EventQueue &) = delete;
+
+    int post(duration delay, duration period, std::function<void()> task);
+
+    template <typename F, typename... Args>
+    static std::function<void()> make_task(F f, Args... args) {
+        return [=]() { f(args...); };
+    }
+
+    template <typename T, typename R, typename... MethodArgs, typename... Args>
+    static std::function<void()> make_task(T *obj,
+                                           R (T::*method)(MethodArgs...),
+                                           Args... args) {
+        return [=]() { (obj->*method)(args...); };
+    }
+
+public:
+    EventQueue();
+    ~EventQueue();
+
+    /**
+     * @returns Identifier of the event, or 0 if it could not be posted.
+     */
+    template <typename F, typename... Args>
+    int call(F f, Args... args) {
+        return post(duration(0), duration(-1), make_task(f, args...));
+    }
+
+    template <typename Rep, typename Period, typename F, typename... Args>
+    int call_in(std::chrono::duration<Rep, Period> delay, F f, Args... args) {
+        return post(std::chrono::duration_cast<duration>(delay), duration(-1),
+                    make_task(f, args...));
+    }
+
+    template <typename Rep, typename Period, typename F, typename... Args>
+    int call_every(std::chrono::duration<Rep, Period> period,
+                   F f,
+                   Args... args) {
+        const duration ms = std::chrono::duration_cast<duration>(period);
+        return post(ms, ms, make_task(f, args...));
+    }
+
+    bool cancel(int id);
+
+    /**
+     * Dispatches events for @p ms of real time, or forever if @p ms is
+     * negative, until break_dispatch() is called.
+     */
+    void dispatch_for(duration ms);
+    void dispatch_forever();
+    void break_dispatch();
+
+    /**
+     * Host only: moves the clock of the queue forward by @p ms, running all
+     * the events that become due on the way, in order, without sleeping.
+     * Must not be used while the queue is dispatched by another thread.
+     */
+    void advance(duration ms);
+
+    /**
+     * Host only: number of events waiting to be run.
+     */
+    size_t pending() const;
+};
+
+} // namespace events
+
+/**
+ * Queue dispatched by a thread started on the first call, like the Mbed OS
+ * shared event queue.
+ */
+events::EventQueue *mbed_event_queue();
+
+#endif // HOST_EVENT_QUEUE_H
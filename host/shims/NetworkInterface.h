@@ -0,0 +1,93 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOST_NETWORK_INTERFACE_H
+#define HOST_NETWORK_INTERFACE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "EventQueue.h"
+#include "nsapi_types.h"
+
+/**
+ * Fake of the Mbed OS network interface, replaying a scripted sequence of
+ * connection attempts. Status changes are reported through the attached
+ * callback from the event queue set with set_event_queue(), like the network
+ * stack reports them from its own context.
+ */
+class NetworkInterface {
+public:
+    struct ConnectStep {
+        // Returned by connect()
+        nsapi_error_t result;
+        // Reported after the delay, unless result is an error
+        nsapi_connection_status_t status;
+        std::chrono::milliseconds delay;
+    };
+
+private:
+    events::EventQueue *queue_;
+    mbed::Callback<void(nsapi_event_t, intptr_t)> status_cb_;
+    std::vector<ConnectStep> script_;
+    size_t script_index_;
+    nsapi_connection_status_t status_;
+    unsigned connect_count_;
+    int pending_event_;
+
+    NetworkInterface(const NetworkInterface &) = delete;
+    NetworkInterface &operator=(const NetworkInterface &) = delete;
+
+    void report_status(nsapi_connection_status_t status);
+
+public:
+    NetworkInterface();
+
+    static NetworkInterface *get_default_instance();
+
+    /**
+     * Sets the queue from which status changes are reported;
+     * mbed_event_queue() is used by default.
+     */
+    void set_event_queue(events::EventQueue *queue);
+
+    /**
+     * Sets the outcomes of subsequent connect() calls; the last one is
+     * repeated once the script is exhausted. By default, the link is up 10 ms
+     * after every connect().
+     */
+    void set_connect_script(std::vector<ConnectStep> script);
+
+    /**
+     * Reports the link as lost, like the network stack does when the
+     * coverage is lost.
+     */
+    void drop_link();
+
+    unsigned connect_count() const {
+        return connect_count_;
+    }
+
+    void attach(mbed::Callback<void(nsapi_event_t, intptr_t)> status_cb);
+    nsapi_error_t set_blocking(bool blocking);
+    nsapi_error_t connect();
+    nsapi_error_t disconnect();
+    nsapi_connection_status_t get_connection_status() const;
+};
+
+#endif // HOST_NETWORK_INTERFACE_H
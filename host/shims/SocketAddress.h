@@ -0,0 +1,39 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef HOST_SOCKET_ADDRESS_H
+#define HOST_SOCKET_ADDRESS_H
+
+#include <string>
+
+class SocketAddress {
+    std::string ip_address_;
+
+public:
+    SocketAddress() = default;
+
+    bool set_ip_address(const char *addr) {
+        ip_address_ = addr ? addr : "";
+        return !ip_address_.empty();
+    }
+
+    const char *get_ip_address() const {
+        return ip_address_.empty() ? nullptr : ip_address_.c_str();
+    }
+};
+
+#endif // HOST_SOCKET_ADDRESS_H
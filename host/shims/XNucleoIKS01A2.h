@@ -0,0 +1,83 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef HOST_XNUCLEOIKS01A2_H
+#define HOST_XNUCLEOIKS01A2_H
+
+#include <cstdint>
+
+/**
+ * Fake of the X-NUCLEO-IKS01A2 sensor board driver, generating slowly
+ * varying synthetic readings. Only the methods used by the application are
+ * provided; all of them return 0 on success, like the real driver.
+ */
+
+#define LSM303AGR_ACC_WHO_AM_I 0x33
+#define LSM303AGR_MAG_WHO_AM_I 0x40
+
+typedef enum { D14, D15 } PinName;
+
+class LPS22HBSensor {
+public:
+    int enable();
+    int disable();
+    int get_pressure(float *pfData);
+};
+
+class HTS221Sensor {
+public:
+    int read_id(uint8_t *id);
+    int enable();
+    int disable();
+    int get_humidity(float *pfData);
+};
+
+class LSM303AGRMagSensor {
+public:
+    int read_id(uint8_t *id);
+    int enable();
+    int disable();
+    int get_m_axes(int32_t *pData);
+};
+
+class LSM303AGRAccSensor {
+public:
+    int read_id(uint8_t *id);
+    int enable();
+    int disable();
+    int get_x_axes(int32_t *pData);
+};
+
+/**
+ * Shifts the synthetic readings of the calling thread in time, so that
+ * clients of the fleet simulator do not all report identical values.
+ */
+void host_sensors_set_time_offset(double offset_s);
+
+class XNucleoIKS01A2 {
+    XNucleoIKS01A2();
+
+public:
+    static XNucleoIKS01A2 *instance(PinName sda, PinName scl);
+
+    HTS221Sensor *ht_sensor;
+    LPS22HBSensor *pt_sensor;
+    LSM303AGRMagSensor *magnetometer;
+    LSM303AGRAccSensor *accelerometer;
+};
+
+#endif // HOST_XNUCLEOIKS01A2_H
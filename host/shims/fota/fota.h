@@ -0,0 +1,215 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOST_FOTA_H
+#define HOST_FOTA_H
+
+/**
+ * Fake of the FOTA library of mbed-cloud-client, declaring only what
+ * anjay-mbed-fota uses. The library is configured like on the device
+ * (external downloader, multicast node mode, a single component), with
+ * FOTA_TEST_MANIFEST_BYPASS_VALIDATION: manifests are not signed, see
+ * host_fota.h for their format. The other headers of the library include this
+ * one.
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define FOTA_COMPONENT_MAX_NAME_SIZE 9
+#define FOTA_COMPONENT_MAX_SEMVER_STR_SIZE 16
+#define FOTA_CRYPTO_HASH_SIZE 32
+#define FOTA_ENCRYPT_KEY_SIZE 16
+#define FOTA_GUID_SIZE 16
+
+#define FOTA_FW_HEADER_MAGIC 0x5c0253a3
+#define FOTA_CANDIDATE_READY_MAGIC 0xe3ad1d0a
+#define FOTA_HEADER_HAS_CANDIDATE_READY 1
+
+enum {
+    FOTA_STATUS_SUCCESS = 0,
+    FOTA_STATUS_FW_UPDATE_OK = -18,
+    FOTA_STATUS_MANIFEST_INVALID_URI = -20,
+    FOTA_STATUS_MANIFEST_MALFORMED = -21,
+    FOTA_STATUS_MANIFEST_SIGNATURE_INVALID = -22,
+    FOTA_STATUS_DOWNLOAD_FRAGMENT_FAILED = -23,
+    FOTA_STATUS_MANIFEST_PAYLOAD_UNSUPPORTED = -24,
+    FOTA_STATUS_MANIFEST_PAYLOAD_CORRUPTED = -25,
+    FOTA_STATUS_MANIFEST_VERSION_REJECTED = -26,
+    FOTA_STATUS_MANIFEST_SCHEMA_UNSUPPORTED = -27,
+    FOTA_STATUS_MANIFEST_CUSTOM_DATA_TOO_BIG = -28,
+    FOTA_STATUS_MANIFEST_WRONG_VENDOR_ID = -29,
+    FOTA_STATUS_MANIFEST_WRONG_CLASS_ID = -30,
+    FOTA_STATUS_MANIFEST_PRECURSOR_MISMATCH = -31,
+    FOTA_STATUS_INSUFFICIENT_STORAGE = -32,
+    FOTA_STATUS_OUT_OF_MEMORY = -33,
+    FOTA_STATUS_STORAGE_WRITE_FAILED = -34,
+    FOTA_STATUS_STORAGE_READ_FAILED = -35,
+    FOTA_STATUS_INSTALL_AUTH_NOT_GRANTED = -36,
+    FOTA_STATUS_DOWNLOAD_AUTH_NOT_GRANTED = -37,
+    FOTA_STATUS_UNEXPECTED_COMPONENT = -38,
+    FOTA_STATUS_FW_INSTALLATION_FAILED = -39,
+    FOTA_STATUS_INTERNAL_ERROR = -40,
+    FOTA_STATUS_INTERNAL_DELTA_ERROR = -41,
+    FOTA_STATUS_INTERNAL_CRYPTO_ERROR = -42,
+    FOTA_STATUS_NOT_FOUND = -43,
+    FOTA_STATUS_MULTICAST_UPDATE_ABORTED = -44,
+    FOTA_STATUS_COMB_PACKAGE_MALFORMED = -45,
+    FOTA_STATUS_COMB_PACKAGE_WRONG_IMAGE_NUM = -46,
+    FOTA_STATUS_COMB_PACKAGE_IMAGE_ID_NAME_TOO_LONG = -47,
+    FOTA_STATUS_COMB_PACKAGE_VENDOR_DATA_TOO_LONG = -48,
+    FOTA_STATUS_RESOURCE_BUSY = -49,
+    FOTA_STATUS_INVALID_ARGUMENT = -50
+};
+
+enum { FOTA_INSTALL_STATE_AUTHORIZE = 1, FOTA_INSTALL_STATE_DEFER };
+
+typedef enum {
+    FOTA_SOURCE_STATE_IDLE,
+    FOTA_SOURCE_STATE_DOWNLOADING,
+    FOTA_SOURCE_STATE_AWAITING_DOWNLOAD_APPROVAL,
+    FOTA_SOURCE_STATE_AWAITING_APPLICATION_APPROVAL,
+    FOTA_SOURCE_STATE_UPDATING,
+    FOTA_SOURCE_STATE_REBOOTING
+} fota_source_state_e;
+
+typedef uint64_t fota_component_version_t;
+
+typedef struct {
+    uint32_t magic;
+    uint64_t fw_size;
+    fota_component_version_t version;
+    uint8_t digest[FOTA_CRYPTO_HASH_SIZE];
+    uint32_t footer;
+} fota_header_info_t;
+
+typedef struct {
+    uint32_t magic;
+    char comp_name[FOTA_COMPONENT_MAX_NAME_SIZE];
+    uint32_t footer;
+} fota_candidate_ready_header_t;
+
+typedef struct {
+    size_t storage_start_addr;
+    size_t storage_size;
+} fota_candidate_config_t;
+
+typedef struct {
+    fota_component_version_t version;
+    size_t payload_size;
+    uint8_t payload_digest[FOTA_CRYPTO_HASH_SIZE];
+} manifest_firmware_info_t;
+
+typedef struct {
+    manifest_firmware_info_t *fw_info;
+} fota_context_t;
+
+typedef struct {
+    bool need_reboot;
+    bool support_delta;
+    int (*curr_fw_read)(uint8_t *buf,
+                        size_t offset,
+                        size_t size,
+                        size_t *num_read);
+    int (*curr_fw_get_digest)(uint8_t *buf);
+} fota_component_desc_info_t;
+
+typedef void (*fota_deferred_data_callabck_t)(void *data, size_t size);
+typedef void (*report_sent_callback_t)(void);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Implemented by the fake library
+bool fota_is_active_update(void);
+fota_context_t *fota_get_context(void);
+void fota_on_manifest(uint8_t *data, size_t size);
+void fota_on_authorize(int32_t param);
+void fota_multicast_node_on_abort(void);
+int fota_ext_downloader_write_image_fragment(const void *data,
+                                             size_t offset,
+                                             size_t size);
+int fota_ext_downloader_on_image_ready(void);
+
+int fota_bd_init(void);
+int fota_bd_get_read_size(size_t *read_size);
+int fota_bd_get_program_size(size_t *prog_size);
+const fota_candidate_config_t *fota_candidate_get_config(void);
+int fota_candidate_read_candidate_ready_header(
+        size_t *addr,
+        size_t bd_read_size,
+        size_t bd_prog_size,
+        fota_candidate_ready_header_t *header);
+int fota_candidate_read_header(size_t *addr,
+                               size_t bd_read_size,
+                               size_t bd_prog_size,
+                               fota_header_info_t *header);
+void fota_candidate_erase(void);
+
+int fota_curr_fw_read_header(fota_header_info_t *header_info);
+int fota_curr_fw_read(uint8_t *buf,
+                      size_t offset,
+                      size_t size,
+                      size_t *num_read);
+int fota_curr_fw_get_digest(uint8_t *buf);
+void fota_component_version_int_to_semver(fota_component_version_t version,
+                                          char *sem_ver);
+int fota_component_add(const fota_component_desc_info_t *comp_desc,
+                       const char *comp_name,
+                       const char *comp_semver);
+
+// Implemented by the application
+void fota_app_on_download_progress(size_t downloaded_size,
+                                   size_t current_chunk_size,
+                                   size_t total_size);
+int fota_app_on_complete(int32_t status);
+int fota_app_on_install_authorization(void);
+int fota_app_on_download_authorization(
+        const manifest_firmware_info_t *candidate_info,
+        fota_component_version_t curr_fw_version);
+int fota_event_handler_defer_with_data(fota_deferred_data_callabck_t cb,
+                                       void *data,
+                                       size_t size);
+int fota_event_cancel(uint8_t event_id);
+void fota_source_enable_auto_observable_resources_reporting(bool enable);
+void report_state_random_delay(bool enable);
+int fota_source_report_update_result(int result);
+int fota_source_report_state(fota_source_state_e state,
+                             report_sent_callback_t on_sent,
+                             report_sent_callback_t on_failure);
+int fota_source_report_state_in_ms(fota_source_state_e state,
+                                   report_sent_callback_t on_sent,
+                                   report_sent_callback_t on_failure,
+                                   size_t in_ms);
+int fota_source_report_update_customer_result(int result);
+int fota_source_firmware_request_fragment(const char *uri, size_t offset);
+int fota_nvm_fw_encryption_key_set(const uint8_t buffer[FOTA_ENCRYPT_KEY_SIZE]);
+int fota_nvm_fw_encryption_key_delete(void);
+int fota_nvm_get_update_certificate(uint8_t *buffer,
+                                    size_t size,
+                                    size_t *bytes_read);
+int fota_nvm_get_vendor_id(uint8_t buffer[FOTA_GUID_SIZE]);
+int fota_nvm_get_class_id(uint8_t buffer[FOTA_GUID_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_FOTA_H
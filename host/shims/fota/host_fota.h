@@ -0,0 +1,85 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOST_FOTA_CONTROL_H
+#define HOST_FOTA_CONTROL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Control of the fake FOTA library, for tests and benchmarks.
+ *
+ * The candidate storage is emulated in memory. Programming is done in units
+ * of program_size bytes: a write that covers a unit only partially reads it
+ * back and programs it as a whole (read-modify-write). Time spent by the
+ * device is not waited for, but accounted in HostFotaStats::busy_us, using
+ * the timings from HostFotaConfig.
+ */
+struct HostFotaConfig {
+    size_t storage_size = 1024 * 1024;
+    size_t program_size = 256;
+    // Defaults are in the range of SPI NOR flash memories
+    double program_op_us = 50.0;
+    double program_byte_us = 2.5;
+    double read_byte_us = 0.1;
+};
+
+struct HostFotaStats {
+    // Program operations, and bytes programmed by them
+    uint32_t programs;
+    uint64_t programmed_bytes;
+    // Program units written partially, each read back before programming
+    uint32_t read_modify_writes;
+    uint64_t read_bytes;
+    uint32_t erases;
+    double busy_us;
+};
+
+/**
+ * Erases the candidate storage, aborts any update in progress and resets the
+ * statistics.
+ */
+void host_fota_reset(const HostFotaConfig &config = HostFotaConfig());
+
+const HostFotaStats &host_fota_stats();
+
+void host_fota_reset_stats();
+
+/**
+ * @returns Whether installation of the candidate has been authorized; on the
+ *          device, the library reboots into the bootloader at this point.
+ */
+bool host_fota_installed();
+
+/**
+ * @returns Contents of the candidate storage, up to the payload size
+ *          declared in the current manifest.
+ */
+std::vector<uint8_t> host_fota_candidate();
+
+void host_fota_sha256(const void *data, size_t size, uint8_t out[32]);
+
+/**
+ * Builds a manifest accepted by the fake library: a DER SEQUENCE of the
+ * payload size (INTEGER) and its SHA-256 digest (OCTET STRING), followed by
+ * an OCTET STRING of @p padding bytes that is ignored, if non-zero.
+ */
+std::vector<uint8_t>
+host_fota_manifest(const void *payload, size_t size, size_t padding = 0);
+
+#endif // HOST_FOTA_CONTROL_H
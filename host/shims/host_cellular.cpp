@@ -0,0 +1,69 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <CellularContext.h>
+#include <CellularNetwork.h>
+
+#include <utility>
+
+namespace mbed {
+
+CellularNetwork::CellularNetwork() : rssi_script_{ -73 }, rssi_index_(0) {}
+
+void CellularNetwork::set_signal_quality_script(std::vector<int> rssi_dbm) {
+    rssi_script_ = std::move(rssi_dbm);
+    rssi_index_ = 0;
+}
+
+nsapi_error_t CellularNetwork::get_signal_quality(int &rssi, int *ber) {
+    if (rssi_script_.empty()) {
+        return NSAPI_ERROR_DEVICE_ERROR;
+    }
+    rssi = rssi_script_[rssi_index_];
+    rssi_index_ = (rssi_index_ + 1) % rssi_script_.size();
+    if (ber) {
+        *ber = 0;
+    }
+    return NSAPI_ERROR_OK;
+}
+
+CellularContext::CellularContext()
+        : ip_address_("127.0.0.1"), gateway_("127.0.0.1") {}
+
+CellularContext *CellularContext::get_default_instance() {
+    static CellularContext instance;
+    return &instance;
+}
+
+void CellularContext::set_addresses(const char *ip_address,
+                                    const char *gateway) {
+    ip_address_ = ip_address;
+    gateway_ = gateway;
+}
+
+nsapi_error_t CellularContext::get_ip_address(SocketAddress *address) {
+    return address->set_ip_address(ip_address_.c_str())
+                   ? NSAPI_ERROR_OK
+                   : NSAPI_ERROR_NO_ADDRESS;
+}
+
+nsapi_error_t CellularContext::get_gateway(SocketAddress *address) {
+    return address->set_ip_address(gateway_.c_str()) ? NSAPI_ERROR_OK
+                                                      : NSAPI_ERROR_NO_ADDRESS;
+}
+
+} // namespace mbed
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <mbed.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace events {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Event {
+    int id;
+    Clock::time_point due;
+    EventQueue::duration period;
+    std::function<void()> task;
+};
+
+} // namespace
+
+struct EventQueue::Impl {
+    mutable std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<Event> events;
+    int next_id = 1;
+    bool break_requested = false;
+    // Added to the real time by advance()
+    Clock::duration offset{};
+
+    Clock::time_point now() const {
+        return Clock::now() + offset;
+    }
+
+    std::vector<Event>::iterator earliest() {
+        return std::min_element(events.begin(), events.end(),
+                                [](const Event &a, const Event &b) {
+                                    return a.due < b.due;
+                                });
+    }
+
+    // Takes the event out of the queue, or puts it back with a new due time
+    // if it is periodic; called with the mutex held
+    std::function<void()> take(std::vector<Event>::iterator it) {
+        std::function<void()> task = it->task;
+        if (it->period.count() >= 0) {
+            it->due += std::max(it->period, duration(1));
+        } else {
+            events.erase(it);
+        }
+        return task;
+    }
+};
+
+EventQueue::EventQueue() : impl_(new Impl) {}
+
+// Not released, see ~Mutex()
+EventQueue::~EventQueue() {}
+
+int EventQueue::post(duration delay,
+                     duration period,
+                     std::function<void()> task) {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    const int id = impl_->next_id++;
+    impl_->events.push_back(Event{ id,
+                                   impl_->now() + std::max(delay, duration(0)),
+                                   period, std::move(task) });
+    impl_->cond.notify_all();
+    return id;
+}
+
+bool EventQueue::cancel(int id) {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    auto it = std::find_if(impl_->events.begin(), impl_->events.end(),
+                           [id](const Event &event) { return event.id == id; });
+    if (it == impl_->events.end()) {
+        return false;
+    }
+    impl_->events.erase(it);
+    return true;
+}
+
+void EventQueue::dispatch_for(duration ms) {
+    std::unique_lock<std::mutex> lock(impl_->mutex);
+    const bool forever = ms.count() < 0;
+    const Clock::time_point deadline = impl_->now() + ms;
+    impl_->break_requested = false;
+    while (!impl_->break_requested && (forever || impl_->now() < deadline)) {
+        auto it = impl_->earliest();
+        if (it != impl_->events.end() && it->due <= impl_->now()) {
+            std::function<void()> task = impl_->take(it);
+            lock.unlock();
+            task();
+            lock.lock();
+            continue;
+        }
+        Clock::time_point wake_time = deadline;
+        if (it != impl_->events.end() && (forever || it->due < deadline)) {
+            wake_time = it->due;
+        }
+        if (forever && it == impl_->events.end()) {
+            impl_->cond.wait(lock);
+        } else {
+            impl_->cond.wait_until(lock, wake_time - impl_->offset);
+        }
+    }
+}
+
+void EventQueue::dispatch_forever() {
+    dispatch_for(duration(-1));
+}
+
+void EventQueue::break_dispatch() {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    impl_->break_requested = true;
+    impl_->cond.notify_all();
+}
+
+void EventQueue::advance(duration ms) {
+    std::unique_lock<std::mutex> lock(impl_->mutex);
+    const Clock::time_point target = impl_->now() + ms;
+    while (true) {
+        auto it = impl_->earliest();
+        if (it == impl_->events.end() || it->due > target) {
+            break;
+        }
+        if (it->due > impl_->now()) {
+            impl_->offset += it->due - impl_->now();
+        }
+        std::function<void()> task = impl_->take(it);
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+    if (target > impl_->now()) {
+        impl_->offset += target - impl_->now();
+    }
+}
+
+size_t EventQueue::pending() const {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    return impl_->events.size();
+}
+
+} // namespace events
+
+events::EventQueue *mbed_event_queue() {
+    static events::EventQueue *queue = []() {
+        events::EventQueue *queue = new events::EventQueue();
+        std::thread([queue]() { queue->dispatch_forever(); }).detach();
+        return queue;
+    }();
+    return queue;
+}
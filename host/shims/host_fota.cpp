@@ -0,0 +1,507 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fota.h"
+#include "host_fota.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+// SHA-256, as specified in FIPS 180-4
+class Sha256 {
+    uint32_t state_[8];
+    uint8_t block_[64];
+    size_t block_fill_;
+    uint64_t total_size_;
+
+    static uint32_t rotr(uint32_t x, unsigned n) {
+        return (x >> n) | (x << (32 - n));
+    }
+
+    void process_block() {
+        static const uint32_t K[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b,
+            0x59f111f1, 0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01,
+            0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7,
+            0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+            0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152,
+            0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+            0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+            0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819,
+            0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116, 0x1e376c08,
+            0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f,
+            0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+            0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+        };
+        uint32_t w[64];
+        for (size_t i = 0; i < 16; ++i) {
+            w[i] = (uint32_t) block_[4 * i] << 24
+                   | (uint32_t) block_[4 * i + 1] << 16
+                   | (uint32_t) block_[4 * i + 2] << 8
+                   | (uint32_t) block_[4 * i + 3];
+        }
+        for (size_t i = 16; i < 64; ++i) {
+            const uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18)
+                                ^ (w[i - 15] >> 3);
+            const uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19)
+                                ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        uint32_t v[8];
+        std::copy(state_, state_ + 8, v);
+        for (size_t i = 0; i < 64; ++i) {
+            const uint32_t s1 = rotr(v[4], 6) ^ rotr(v[4], 11) ^ rotr(v[4], 25);
+            const uint32_t ch = (v[4] & v[5]) ^ (~v[4] & v[6]);
+            const uint32_t t1 = v[7] + s1 + ch + K[i] + w[i];
+            const uint32_t s0 = rotr(v[0], 2) ^ rotr(v[0], 13) ^ rotr(v[0], 22);
+            const uint32_t maj = (v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]);
+            std::copy_backward(v, v + 7, v + 8);
+            v[4] += t1;
+            v[0] = t1 + s0 + maj;
+        }
+        for (size_t i = 0; i < 8; ++i) {
+            state_[i] += v[i];
+        }
+    }
+
+public:
+    Sha256()
+            : state_{ 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                      0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 },
+              block_(),
+              block_fill_(0),
+              total_size_(0) {}
+
+    void update(const void *data, size_t size) {
+        const uint8_t *bytes = (const uint8_t *) data;
+        total_size_ += size;
+        while (size) {
+            const size_t chunk = std::min(size, sizeof(block_) - block_fill_);
+            memcpy(block_ + block_fill_, bytes, chunk);
+            block_fill_ += chunk;
+            bytes += chunk;
+            size -= chunk;
+            if (block_fill_ == sizeof(block_)) {
+                process_block();
+                block_fill_ = 0;
+            }
+        }
+    }
+
+    void finish(uint8_t out[FOTA_CRYPTO_HASH_SIZE]) {
+        const uint64_t total_bits = total_size_ * 8;
+        const uint8_t pad = 0x80;
+        update(&pad, 1);
+        const uint8_t zero = 0;
+        while (block_fill_ != sizeof(block_) - 8) {
+            update(&zero, 1);
+        }
+        uint8_t length[8];
+        for (size_t i = 0; i < 8; ++i) {
+            length[i] = (uint8_t) (total_bits >> (56 - 8 * i));
+        }
+        update(length, sizeof(length));
+        for (size_t i = 0; i < 8; ++i) {
+            for (size_t j = 0; j < 4; ++j) {
+                out[4 * i + j] = (uint8_t) (state_[i] >> (24 - 8 * j));
+            }
+        }
+    }
+};
+
+enum class State {
+    IDLE,
+    AWAITING_DOWNLOAD_AUTHORIZATION,
+    DOWNLOADING,
+    AWAITING_INSTALL_AUTHORIZATION,
+    INSTALLED
+};
+
+struct FakeFota {
+    HostFotaConfig config;
+    HostFotaStats stats;
+    std::vector<uint8_t> storage;
+    State state;
+    manifest_firmware_info_t fw_info;
+    fota_context_t context;
+    size_t image_size;
+};
+
+FakeFota &fake() {
+    static FakeFota instance = [] {
+        FakeFota fota{};
+        fota.storage.assign(fota.config.storage_size, 0xFF);
+        fota.context.fw_info = &fota.fw_info;
+        return fota;
+    }();
+    return instance;
+}
+
+const fota_component_version_t CURRENT_VERSION = 1;
+
+// Reads a DER header; only single-byte tags are used in the manifest
+bool read_der_header(const uint8_t **data,
+                     const uint8_t *end,
+                     uint8_t *out_tag,
+                     size_t *out_length) {
+    if (end - *data < 2) {
+        return false;
+    }
+    *out_tag = *(*data)++;
+    uint8_t length = *(*data)++;
+    if (length < 0x80) {
+        *out_length = length;
+    } else {
+        size_t length_bytes = length & 0x7F;
+        if (!length_bytes || length_bytes > sizeof(size_t)
+            || (size_t) (end - *data) < length_bytes) {
+            return false;
+        }
+        *out_length = 0;
+        while (length_bytes--) {
+            *out_length = (*out_length << 8) | *(*data)++;
+        }
+    }
+    return *out_length <= (size_t) (end - *data);
+}
+
+bool parse_manifest(const uint8_t *data,
+                    size_t size,
+                    manifest_firmware_info_t *out_info) {
+    const uint8_t *end = data + size;
+    uint8_t tag;
+    size_t length;
+    if (!read_der_header(&data, end, &tag, &length) || tag != 0x30) {
+        return false;
+    }
+    end = data + length;
+    if (!read_der_header(&data, end, &tag, &length) || tag != 0x02
+        || !length || length > sizeof(uint32_t)) {
+        return false;
+    }
+    out_info->payload_size = 0;
+    while (length--) {
+        out_info->payload_size = (out_info->payload_size << 8) | *data++;
+    }
+    if (!read_der_header(&data, end, &tag, &length) || tag != 0x04
+        || length != FOTA_CRYPTO_HASH_SIZE) {
+        return false;
+    }
+    memcpy(out_info->payload_digest, data, FOTA_CRYPTO_HASH_SIZE);
+    out_info->version = CURRENT_VERSION + 1;
+    return true;
+}
+
+void account_read(size_t size) {
+    FakeFota &fota = fake();
+    fota.stats.read_bytes += size;
+    fota.stats.busy_us += size * fota.config.read_byte_us;
+}
+
+void program_storage(size_t offset, const void *data, size_t size) {
+    FakeFota &fota = fake();
+    const size_t unit = fota.config.program_size;
+    const size_t start = offset / unit * unit;
+    const size_t end = (offset + size + unit - 1) / unit * unit;
+    const bool head_partial = offset != start;
+    const bool tail_partial = offset + size != end;
+    const size_t partial_units =
+            (head_partial ? 1 : 0) + (tail_partial ? 1 : 0)
+            - (head_partial && tail_partial && end - start == unit ? 1 : 0);
+    fota.stats.read_modify_writes += (uint32_t) partial_units;
+    account_read(partial_units * unit);
+    memcpy(fota.storage.data() + offset, data, size);
+    ++fota.stats.programs;
+    fota.stats.programmed_bytes += end - start;
+    fota.stats.busy_us += fota.config.program_op_us
+                          + (end - start) * fota.config.program_byte_us;
+}
+
+void read_storage(size_t offset, void *out, size_t size) {
+    FakeFota &fota = fake();
+    memcpy(out, fota.storage.data() + offset, size);
+    account_read(size);
+}
+
+void on_install_authorization_deferred(void *data, size_t size) {
+    (void) data;
+    (void) size;
+    fota_app_on_install_authorization();
+}
+
+} // namespace
+
+void host_fota_reset(const HostFotaConfig &config) {
+    FakeFota &fota = fake();
+    fota.config = config;
+    fota.storage.assign(config.storage_size, 0xFF);
+    fota.state = State::IDLE;
+    fota.fw_info = manifest_firmware_info_t();
+    fota.image_size = 0;
+    host_fota_reset_stats();
+}
+
+const HostFotaStats &host_fota_stats() {
+    return fake().stats;
+}
+
+void host_fota_reset_stats() {
+    fake().stats = HostFotaStats();
+}
+
+bool host_fota_installed() {
+    return fake().state == State::INSTALLED;
+}
+
+std::vector<uint8_t> host_fota_candidate() {
+    const FakeFota &fota = fake();
+    return std::vector<uint8_t>(fota.storage.begin(),
+                                fota.storage.begin()
+                                        + std::min(fota.fw_info.payload_size,
+                                                   fota.storage.size()));
+}
+
+void host_fota_sha256(const void *data, size_t size, uint8_t out[32]) {
+    Sha256 sha;
+    sha.update(data, size);
+    sha.finish(out);
+}
+
+std::vector<uint8_t>
+host_fota_manifest(const void *payload, size_t size, size_t padding) {
+    std::vector<uint8_t> content;
+    content.push_back(0x02);
+    uint8_t size_bytes[sizeof(uint32_t) + 1];
+    size_t size_length = 0;
+    for (uint64_t value = size; value || !size_length; value >>= 8) {
+        size_bytes[size_length++] = (uint8_t) value;
+    }
+    if (size_bytes[size_length - 1] & 0x80) {
+        // Keep the INTEGER positive
+        size_bytes[size_length++] = 0;
+    }
+    content.push_back((uint8_t) size_length);
+    while (size_length) {
+        content.push_back(size_bytes[--size_length]);
+    }
+    content.push_back(0x04);
+    content.push_back(FOTA_CRYPTO_HASH_SIZE);
+    uint8_t digest[FOTA_CRYPTO_HASH_SIZE];
+    host_fota_sha256(payload, size, digest);
+    content.insert(content.end(), digest, digest + sizeof(digest));
+
+    auto append_length = [](std::vector<uint8_t> &out, size_t length) {
+        if (length < 0x80) {
+            out.push_back((uint8_t) length);
+        } else if (length <= 0xFF) {
+            out.push_back(0x81);
+            out.push_back((uint8_t) length);
+        } else {
+            assert(length <= 0xFFFF);
+            out.push_back(0x82);
+            out.push_back((uint8_t) (length >> 8));
+            out.push_back((uint8_t) length);
+        }
+    };
+    if (padding) {
+        content.push_back(0x04);
+        append_length(content, padding);
+        content.insert(content.end(), padding, 0xA5);
+    }
+    std::vector<uint8_t> manifest;
+    manifest.push_back(0x30);
+    append_length(manifest, content.size());
+    manifest.insert(manifest.end(), content.begin(), content.end());
+    return manifest;
+}
+
+bool fota_is_active_update(void) {
+    const State state = fake().state;
+    return state != State::IDLE && state != State::INSTALLED;
+}
+
+fota_context_t *fota_get_context(void) {
+    return &fake().context;
+}
+
+void fota_on_manifest(uint8_t *data, size_t size) {
+    FakeFota &fota = fake();
+    if (fota.state != State::IDLE) {
+        return;
+    }
+    manifest_firmware_info_t info{};
+    if (!parse_manifest(data, size, &info)) {
+        fota_source_report_update_result(-FOTA_STATUS_MANIFEST_MALFORMED);
+        return;
+    }
+    if (info.payload_size > fota.storage.size()) {
+        fota_source_report_update_result(-FOTA_STATUS_INSUFFICIENT_STORAGE);
+        return;
+    }
+    fota.fw_info = info;
+    fota.image_size = 0;
+    fota.state = State::AWAITING_DOWNLOAD_AUTHORIZATION;
+    fota_source_report_state(FOTA_SOURCE_STATE_AWAITING_DOWNLOAD_APPROVAL,
+                             nullptr, nullptr);
+    if (fota_app_on_download_authorization(&fota.fw_info, CURRENT_VERSION)) {
+        fota.state = State::IDLE;
+    }
+}
+
+void fota_on_authorize(int32_t param) {
+    FakeFota &fota = fake();
+    if (param != FOTA_INSTALL_STATE_AUTHORIZE) {
+        return;
+    }
+    if (fota.state == State::AWAITING_DOWNLOAD_AUTHORIZATION) {
+        fota_candidate_erase();
+        fota.state = State::DOWNLOADING;
+        fota_source_report_state(FOTA_SOURCE_STATE_DOWNLOADING, nullptr,
+                                 nullptr);
+    } else if (fota.state == State::AWAITING_INSTALL_AUTHORIZATION) {
+        fota.state = State::INSTALLED;
+        fota_source_report_state(FOTA_SOURCE_STATE_REBOOTING, nullptr,
+                                 nullptr);
+    }
+}
+
+void fota_multicast_node_on_abort(void) {
+    fake().state = State::IDLE;
+}
+
+int fota_ext_downloader_write_image_fragment(const void *data,
+                                             size_t offset,
+                                             size_t size) {
+    FakeFota &fota = fake();
+    if (fota.state != State::DOWNLOADING) {
+        return FOTA_STATUS_INTERNAL_ERROR;
+    }
+    if (offset + size > fota.fw_info.payload_size) {
+        return FOTA_STATUS_MANIFEST_PAYLOAD_CORRUPTED;
+    }
+    program_storage(offset, data, size);
+    fota.image_size = std::max(fota.image_size, offset + size);
+    fota_app_on_download_progress(fota.image_size, size,
+                                  fota.fw_info.payload_size);
+    return FOTA_STATUS_SUCCESS;
+}
+
+int fota_ext_downloader_on_image_ready(void) {
+    FakeFota &fota = fake();
+    if (fota.state != State::DOWNLOADING) {
+        return FOTA_STATUS_INTERNAL_ERROR;
+    }
+    if (fota.image_size != fota.fw_info.payload_size) {
+        return FOTA_STATUS_MANIFEST_PAYLOAD_CORRUPTED;
+    }
+    // Like the library, verify the candidate as stored
+    Sha256 sha;
+    uint8_t buf[256];
+    for (size_t offset = 0; offset < fota.image_size; offset += sizeof(buf)) {
+        const size_t chunk = std::min(sizeof(buf), fota.image_size - offset);
+        read_storage(offset, buf, chunk);
+        sha.update(buf, chunk);
+    }
+    uint8_t digest[FOTA_CRYPTO_HASH_SIZE];
+    sha.finish(digest);
+    if (memcmp(digest, fota.fw_info.payload_digest, sizeof(digest)) != 0) {
+        return FOTA_STATUS_MANIFEST_PAYLOAD_CORRUPTED;
+    }
+    fota.state = State::AWAITING_INSTALL_AUTHORIZATION;
+    return fota_event_handler_defer_with_data(
+            on_install_authorization_deferred, nullptr, 0);
+}
+
+int fota_bd_init(void) {
+    return FOTA_STATUS_SUCCESS;
+}
+
+int fota_bd_get_read_size(size_t *read_size) {
+    *read_size = 1;
+    return FOTA_STATUS_SUCCESS;
+}
+
+int fota_bd_get_program_size(size_t *prog_size) {
+    *prog_size = fake().config.program_size;
+    return FOTA_STATUS_SUCCESS;
+}
+
+const fota_candidate_config_t *fota_candidate_get_config(void) {
+    static fota_candidate_config_t config;
+    config.storage_start_addr = 0;
+    config.storage_size = fake().storage.size();
+    return &config;
+}
+
+int fota_candidate_read_candidate_ready_header(
+        size_t *addr,
+        size_t bd_read_size,
+        size_t bd_prog_size,
+        fota_candidate_ready_header_t *header) {
+    // Candidates are never left for the bootloader on the host
+    return FOTA_STATUS_NOT_FOUND;
+}
+
+int fota_candidate_read_header(size_t *addr,
+                               size_t bd_read_size,
+                               size_t bd_prog_size,
+                               fota_header_info_t *header) {
+    return FOTA_STATUS_NOT_FOUND;
+}
+
+void fota_candidate_erase(void) {
+    FakeFota &fota = fake();
+    std::fill(fota.storage.begin(), fota.storage.end(), 0xFF);
+    fota.image_size = 0;
+    ++fota.stats.erases;
+}
+
+int fota_curr_fw_read_header(fota_header_info_t *header_info) {
+    *header_info = fota_header_info_t();
+    header_info->magic = FOTA_FW_HEADER_MAGIC;
+    header_info->version = CURRENT_VERSION;
+    header_info->footer = FOTA_FW_HEADER_MAGIC;
+    return FOTA_STATUS_SUCCESS;
+}
+
+int fota_curr_fw_read(uint8_t *buf,
+                      size_t offset,
+                      size_t size,
+                      size_t *num_read) {
+    // The running firmware is empty
+    *num_read = 0;
+    return FOTA_STATUS_SUCCESS;
+}
+
+int fota_curr_fw_get_digest(uint8_t *buf) {
+    host_fota_sha256(nullptr, 0, buf);
+    return FOTA_STATUS_SUCCESS;
+}
+
+void fota_component_version_int_to_semver(fota_component_version_t version,
+                                          char *sem_ver) {
+    snprintf(sem_ver, FOTA_COMPONENT_MAX_SEMVER_STR_SIZE, "0.0.%llu",
+             (unsigned long long) version);
+}
+
+int fota_component_add(const fota_component_desc_info_t *comp_desc,
+                       const char *comp_name,
+                       const char *comp_semver) {
+    return FOTA_STATUS_SUCCESS;
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <kvstore_global_api/kvstore_global_api.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <map>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+namespace {
+
+std::string ROOT = ".";
+bool IN_MEMORY;
+
+thread_local std::map<std::string, std::vector<uint8_t>> MEMORY_STORE;
+
+std::string key_path(const char *full_name_key) {
+    std::string name = full_name_key;
+    std::replace(name.begin(), name.end(), '/', '_');
+    return ROOT + "/" + name;
+}
+
+} // namespace
+
+void host_kvstore_set_root(const char *path) {
+    ROOT = path;
+}
+
+void host_kvstore_set_in_memory() {
+    IN_MEMORY = true;
+}
+
+int kv_set(const char *full_name_key,
+           const void *buffer,
+           size_t size,
+           uint32_t create_flags) {
+    (void) create_flags;
+    if (!full_name_key || (!buffer && size)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+    if (IN_MEMORY) {
+        const uint8_t *data = static_cast<const uint8_t *>(buffer);
+        MEMORY_STORE[full_name_key].assign(data, data + size);
+        return MBED_SUCCESS;
+    }
+    // Written to a temporary file first, so that an interrupted write does
+    // not corrupt the previous value
+    const std::string path = key_path(full_name_key);
+    const std::string tmp_path = path + ".tmp";
+    FILE *file = fopen(tmp_path.c_str(), "wb");
+    if (!file) {
+        return MBED_ERROR_WRITE_FAILED;
+    }
+    const bool written = fwrite(buffer, 1, size, file) == size;
+    if (fclose(file) || !written || rename(tmp_path.c_str(), path.c_str())) {
+        remove(tmp_path.c_str());
+        return MBED_ERROR_WRITE_FAILED;
+    }
+    return MBED_SUCCESS;
+}
+
+int kv_get(const char *full_name_key,
+           void *buffer,
+           size_t buffer_size,
+           size_t *actual_size) {
+    if (!full_name_key || (!buffer && buffer_size)) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+    if (IN_MEMORY) {
+        auto it = MEMORY_STORE.find(full_name_key);
+        if (it == MEMORY_STORE.end()) {
+            return MBED_ERROR_ITEM_NOT_FOUND;
+        }
+        const size_t read = std::min(buffer_size, it->second.size());
+        memcpy(buffer, it->second.data(), read);
+        if (actual_size) {
+            *actual_size = read;
+        }
+        return MBED_SUCCESS;
+    }
+    FILE *file = fopen(key_path(full_name_key).c_str(), "rb");
+    if (!file) {
+        return errno == ENOENT ? MBED_ERROR_ITEM_NOT_FOUND
+                               : MBED_ERROR_READ_FAILED;
+    }
+    const size_t read = fread(buffer, 1, buffer_size, file);
+    const bool failed = ferror(file);
+    fclose(file);
+    if (failed) {
+        return MBED_ERROR_READ_FAILED;
+    }
+    if (actual_size) {
+        *actual_size = read;
+    }
+    return MBED_SUCCESS;
+}
+
+int kv_get_info(const char *full_name_key, kv_info_t *info) {
+    if (!full_name_key || !info) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+    if (IN_MEMORY) {
+        auto it = MEMORY_STORE.find(full_name_key);
+        if (it == MEMORY_STORE.end()) {
+            return MBED_ERROR_ITEM_NOT_FOUND;
+        }
+        info->size = it->second.size();
+        info->flags = 0;
+        return MBED_SUCCESS;
+    }
+    struct stat st;
+    if (stat(key_path(full_name_key).c_str(), &st)) {
+        return errno == ENOENT ? MBED_ERROR_ITEM_NOT_FOUND
+                               : MBED_ERROR_READ_FAILED;
+    }
+    info->size = (size_t) st.st_size;
+    info->flags = 0;
+    return MBED_SUCCESS;
+}
+
+int kv_remove(const char *full_name_key) {
+    if (!full_name_key) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+    if (IN_MEMORY) {
+        return MEMORY_STORE.erase(full_name_key) ? MBED_SUCCESS
+                                                  : MBED_ERROR_ITEM_NOT_FOUND;
+    }
+    if (remove(key_path(full_name_key).c_str())) {
+        return errno == ENOENT ? MBED_ERROR_ITEM_NOT_FOUND
+                               : MBED_ERROR_WRITE_FAILED;
+    }
+    return MBED_SUCCESS;
+}
+
+int kv_reset(const char *kvstore_path) {
+    if (!kvstore_path) {
+        return MBED_ERROR_INVALID_ARGUMENT;
+    }
+    const std::string prefix = kvstore_path;
+    if (IN_MEMORY) {
+        auto it = MEMORY_STORE.lower_bound(prefix);
+        while (it != MEMORY_STORE.end()
+               && it->first.compare(0, prefix.size(), prefix) == 0) {
+            it = MEMORY_STORE.erase(it);
+        }
+        return MBED_SUCCESS;
+    }
+    std::string file_prefix = prefix;
+    std::replace(file_prefix.begin(), file_prefix.end(), '/', '_');
+    DIR *dir = opendir(ROOT.c_str());
+    if (!dir) {
+        return MBED_ERROR_WRITE_FAILED;
+    }
+    int result = MBED_SUCCESS;
+    while (const dirent *entry = readdir(dir)) {
+        if (strncmp(entry->d_name, file_prefix.c_str(), file_prefix.size())
+                    == 0
+            && remove((ROOT + "/" + entry->d_name).c_str())) {
+            result = MBED_ERROR_WRITE_FAILED;
+        }
+    }
+    closedir(dir);
+    return result;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <mbed.h>
+
+#include <utility>
+
+NetworkInterface::NetworkInterface()
+        : queue_(),
+          status_cb_(),
+          script_{ { NSAPI_ERROR_OK, NSAPI_STATUS_GLOBAL_UP,
+                     std::chrono::milliseconds(10) } },
+          script_index_(0),
+          status_(NSAPI_STATUS_DISCONNECTED),
+          connect_count_(0),
+          pending_event_(0) {}
+
+NetworkInterface *NetworkInterface::get_default_instance() {
+    static NetworkInterface instance;
+    return &instance;
+}
+
+void NetworkInterface::set_event_queue(events::EventQueue *queue) {
+    queue_ = queue;
+}
+
+void NetworkInterface::set_connect_script(std::vector<ConnectStep> script) {
+    script_ = std::move(script);
+    script_index_ = 0;
+}
+
+void NetworkInterface::report_status(nsapi_connection_status_t status) {
+    pending_event_ = 0;
+    status_ = status;
+    if (status_cb_) {
+        status_cb_(NSAPI_EVENT_CONNECTION_STATUS_CHANGE, status);
+    }
+}
+
+void NetworkInterface::drop_link() {
+    report_status(NSAPI_STATUS_DISCONNECTED);
+}
+
+void NetworkInterface::attach(
+        mbed::Callback<void(nsapi_event_t, intptr_t)> status_cb) {
+    status_cb_ = std::move(status_cb);
+}
+
+// Blocking mode is not emulated: connect() always returns immediately
+nsapi_error_t NetworkInterface::set_blocking(bool blocking) {
+    (void) blocking;
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t NetworkInterface::connect() {
+    ++connect_count_;
+    if (status_ == NSAPI_STATUS_GLOBAL_UP) {
+        return NSAPI_ERROR_IS_CONNECTED;
+    }
+    if (pending_event_) {
+        return NSAPI_ERROR_BUSY;
+    }
+    if (script_.empty()) {
+        return NSAPI_ERROR_UNSUPPORTED;
+    }
+    const ConnectStep step = script_[script_index_];
+    if (script_index_ + 1 < script_.size()) {
+        ++script_index_;
+    }
+    if (step.result != NSAPI_ERROR_OK) {
+        return step.result;
+    }
+    events::EventQueue *queue = queue_ ? queue_ : mbed_event_queue();
+    report_status(NSAPI_STATUS_CONNECTING);
+    pending_event_ = queue->call_in(step.delay, this,
+                                    &NetworkInterface::report_status,
+                                    step.status);
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t NetworkInterface::disconnect() {
+    if (pending_event_) {
+        (queue_ ? queue_ : mbed_event_queue())->cancel(pending_event_);
+        pending_event_ = 0;
+    }
+    if (status_ != NSAPI_STATUS_DISCONNECTED) {
+        report_status(NSAPI_STATUS_DISCONNECTED);
+    }
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_connection_status_t NetworkInterface::get_connection_status() const {
+    return status_;
+}
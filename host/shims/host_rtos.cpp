@@ -0,0 +1,230 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <mbed.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <poll.h>
+
+namespace rtos {
+
+struct Mutex::Impl {
+    std::recursive_mutex mutex;
+};
+
+Mutex::Mutex() : impl_(new Impl) {}
+
+// Not released: the application only uses synchronization primitives of
+// static storage duration, which on the device are never destroyed, and
+// detached threads (e.g. the deferred log one) may still wait on them while
+// the process exits; destroying a condition variable that is waited on
+// blocks forever in glibc
+Mutex::~Mutex() {}
+
+void Mutex::lock() {
+    impl_->mutex.lock();
+}
+
+bool Mutex::trylock() {
+    return impl_->mutex.try_lock();
+}
+
+void Mutex::unlock() {
+    impl_->mutex.unlock();
+}
+
+struct EventFlags::Impl {
+    std::mutex mutex;
+    std::condition_variable cond;
+    uint32_t flags = 0;
+
+    uint32_t wait(uint32_t flags, uint32_t millisec, bool clear, bool all) {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto ready = [&]() {
+            return all ? (this->flags & flags) == flags
+                       : (this->flags & flags) != 0;
+        };
+        if (millisec == osWaitForever) {
+            cond.wait(lock, ready);
+        } else if (!cond.wait_for(lock, std::chrono::milliseconds(millisec),
+                                  ready)) {
+            return osFlagsErrorTimeout;
+        }
+        const uint32_t result = this->flags;
+        if (clear) {
+            this->flags &= ~flags;
+        }
+        return result;
+    }
+};
+
+EventFlags::EventFlags() : impl_(new Impl) {}
+
+// See ~Mutex()
+EventFlags::~EventFlags() {}
+
+uint32_t EventFlags::set(uint32_t flags) {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    impl_->flags |= flags;
+    impl_->cond.notify_all();
+    return impl_->flags;
+}
+
+uint32_t EventFlags::clear(uint32_t flags) {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    const uint32_t result = impl_->flags;
+    impl_->flags &= ~flags;
+    return result;
+}
+
+uint32_t EventFlags::get() const {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    return impl_->flags;
+}
+
+uint32_t EventFlags::wait_any(uint32_t flags, uint32_t millisec, bool clear) {
+    return impl_->wait(flags, millisec, clear, false);
+}
+
+uint32_t EventFlags::wait_all(uint32_t flags, uint32_t millisec, bool clear) {
+    return impl_->wait(flags, millisec, clear, true);
+}
+
+uint32_t
+EventFlags::wait_any_for(uint32_t flags,
+                         std::chrono::duration<uint32_t, std::milli> rel_time,
+                         bool clear) {
+    return impl_->wait(flags, rel_time.count(), clear, false);
+}
+
+struct Thread::Impl {
+    std::string name;
+    std::thread thread;
+};
+
+Thread::Thread(osPriority priority,
+               uint32_t stack_size,
+               unsigned char *stack_mem,
+               const char *name)
+        : impl_(new Impl) {
+    (void) priority;
+    (void) stack_size;
+    (void) stack_mem;
+    if (name) {
+        impl_->name = name;
+    }
+}
+
+Thread::~Thread() {
+    if (impl_->thread.joinable()) {
+        impl_->thread.detach();
+    }
+    delete impl_;
+}
+
+osStatus Thread::start(mbed::Callback<void()> task) {
+    if (impl_->thread.joinable()) {
+        return osError;
+    }
+    impl_->thread = std::thread(std::move(task));
+    return osOK;
+}
+
+osStatus Thread::join() {
+    if (!impl_->thread.joinable()) {
+        return osError;
+    }
+    impl_->thread.join();
+    return osOK;
+}
+
+const char *Thread::get_name() const {
+    return impl_->name.c_str();
+}
+
+namespace Kernel {
+
+namespace {
+
+const std::chrono::steady_clock::time_point START_TIME =
+        std::chrono::steady_clock::now();
+
+} // namespace
+
+Clock::time_point Clock::now() {
+    return time_point(std::chrono::duration_cast<duration>(
+            std::chrono::steady_clock::now() - START_TIME));
+}
+
+} // namespace Kernel
+
+namespace ThisThread {
+
+void sleep_for(Kernel::Clock::duration_u32 rel_time) {
+    std::this_thread::sleep_for(rel_time);
+}
+
+} // namespace ThisThread
+
+} // namespace rtos
+
+namespace mbed {
+
+ssize_t FileHandle::read(void *buffer, size_t size) {
+    return ::read(fd_, buffer, size);
+}
+
+bool FileHandle::readable() {
+    pollfd pfd = { fd_, POLLIN, 0 };
+    return poll(&pfd, 1, 0) == 1;
+}
+
+int FileHandle::enable_input(bool enabled) {
+    (void) enabled;
+    return 0;
+}
+
+FileHandle *mbed_file_handle(int fd) {
+    static FileHandle stdin_handle(STDIN_FILENO);
+    static FileHandle stdout_handle(STDOUT_FILENO);
+    static FileHandle stderr_handle(STDERR_FILENO);
+    static FileHandle *const handles[] = { &stdin_handle, &stdout_handle,
+                                           &stderr_handle };
+    assert(fd >= 0 && fd < (int) (sizeof(handles) / sizeof(*handles)));
+    return handles[fd];
+}
+
+} // namespace mbed
+
+uint32_t us_ticker_read() {
+    return (uint32_t) std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now()
+                   - rtos::Kernel::START_TIME)
+            .count();
+}
+
+void system_reset(void) {
+    fprintf(stderr, "system_reset() called, exiting\n");
+    fflush(NULL);
+    exit(EXIT_SUCCESS);
+}
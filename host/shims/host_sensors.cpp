@@ -0,0 +1,139 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <XNucleoIKS01A2.h>
+
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+constexpr uint8_t HTS221_ID = 0xBC;
+
+thread_local double TIME_OFFSET_S;
+
+// Seconds since the first reading, shifted by the offset of the thread
+double elapsed_s() {
+    static const std::chrono::steady_clock::time_point START =
+            std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                         - START)
+                   .count()
+           + TIME_OFFSET_S;
+}
+
+// Smooth periodic signal with the given period, in range [-1, 1]
+double wave(double period_s, double phase = 0.0) {
+    return std::sin(2.0 * M_PI * elapsed_s() / period_s + phase);
+}
+
+void get_axes(int32_t *data, double amplitude, double period_s) {
+    for (int i = 0; i < 3; ++i) {
+        data[i] = (int32_t) std::lround(amplitude
+                                        * wave(period_s, 2.0 * M_PI * i / 3));
+    }
+}
+
+} // namespace
+
+int LPS22HBSensor::enable() {
+    return 0;
+}
+
+int LPS22HBSensor::disable() {
+    return 0;
+}
+
+int LPS22HBSensor::get_pressure(float *pfData) {
+    // hPa; quantized like the real sensor, so that not every reading differs
+    *pfData = std::round((1013.25 + 2.0 * wave(600.0)) * 100.0f) / 100.0f;
+    return 0;
+}
+
+int HTS221Sensor::read_id(uint8_t *id) {
+    *id = HTS221_ID;
+    return 0;
+}
+
+int HTS221Sensor::enable() {
+    return 0;
+}
+
+int HTS221Sensor::disable() {
+    return 0;
+}
+
+int HTS221Sensor::get_humidity(float *pfData) {
+    // % rH
+    *pfData = std::round((45.0 + 10.0 * wave(900.0)) * 10.0f) / 10.0f;
+    return 0;
+}
+
+int LSM303AGRMagSensor::read_id(uint8_t *id) {
+    *id = LSM303AGR_MAG_WHO_AM_I;
+    return 0;
+}
+
+int LSM303AGRMagSensor::enable() {
+    return 0;
+}
+
+int LSM303AGRMagSensor::disable() {
+    return 0;
+}
+
+int LSM303AGRMagSensor::get_m_axes(int32_t *pData) {
+    // mgauss
+    get_axes(pData, 400.0, 120.0);
+    return 0;
+}
+
+int LSM303AGRAccSensor::read_id(uint8_t *id) {
+    *id = LSM303AGR_ACC_WHO_AM_I;
+    return 0;
+}
+
+int LSM303AGRAccSensor::enable() {
+    return 0;
+}
+
+int LSM303AGRAccSensor::disable() {
+    return 0;
+}
+
+int LSM303AGRAccSensor::get_x_axes(int32_t *pData) {
+    // mg
+    get_axes(pData, 1000.0, 60.0);
+    return 0;
+}
+
+void host_sensors_set_time_offset(double offset_s) {
+    TIME_OFFSET_S = offset_s;
+}
+
+XNucleoIKS01A2::XNucleoIKS01A2()
+        : ht_sensor(new HTS221Sensor),
+          pt_sensor(new LPS22HBSensor),
+          magnetometer(new LSM303AGRMagSensor),
+          accelerometer(new LSM303AGRAccSensor) {}
+
+XNucleoIKS01A2 *XNucleoIKS01A2::instance(PinName sda, PinName scl) {
+    (void) sda;
+    (void) scl;
+    static XNucleoIKS01A2 instance;
+    return &instance;
+}
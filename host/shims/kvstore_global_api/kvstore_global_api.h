@@ -0,0 +1,76 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef HOST_KVSTORE_GLOBAL_API_H
+#define HOST_KVSTORE_GLOBAL_API_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * File-backed implementation of the Mbed OS global KVStore API. Each key is
+ * stored in a separate file in the directory set with
+ * host_kvstore_set_root(), with slashes in the key replaced by underscores,
+ * unless host_kvstore_set_in_memory() has been called.
+ */
+
+#define MBED_SUCCESS 0
+#define MBED_ERROR_INVALID_ARGUMENT 257
+#define MBED_ERROR_INVALID_SIZE 258
+#define MBED_ERROR_ITEM_NOT_FOUND 279
+#define MBED_ERROR_READ_FAILED 265
+#define MBED_ERROR_WRITE_FAILED 266
+#define MBED_ERROR_INVALID_DATA_DETECTED 289
+
+typedef struct info {
+    size_t size;
+    uint32_t flags;
+} kv_info_t;
+
+/**
+ * Sets the directory in which the values are stored; current working
+ * directory is used by default.
+ */
+void host_kvstore_set_root(const char *path);
+
+/**
+ * Keeps the values in memory instead of files, separately for each thread.
+ * Used by the fleet simulator, in which every client runs in its own thread
+ * and shall not see the persisted state of the others.
+ */
+void host_kvstore_set_in_memory();
+
+int kv_set(const char *full_name_key,
+           const void *buffer,
+           size_t size,
+           uint32_t create_flags);
+
+int kv_get(const char *full_name_key,
+           void *buffer,
+           size_t buffer_size,
+           size_t *actual_size);
+
+int kv_get_info(const char *full_name_key, kv_info_t *info);
+
+int kv_remove(const char *full_name_key);
+
+/**
+ * Removes all the keys starting with @p kvstore_path, e.g. "/kv/".
+ */
+int kv_reset(const char *kvstore_path);
+
+#endif // HOST_KVSTORE_GLOBAL_API_H
@@ -0,0 +1,258 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef HOST_MBED_H
+#define HOST_MBED_H
+
+/**
+ * Minimal subset of the Mbed OS API used by the application sources, built
+ * on top of the C++ standard library, for the host build.
+ */
+
+// Standard headers that the real mbed.h pulls in, and the application
+// sources rely on
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+
+#include <poll.h>
+#include <unistd.h>
+
+#include "mbed_power_mgmt.h"
+#include "mbed_preprocessor.h"
+
+typedef enum { osOK = 0, osError = -1 } osStatus;
+
+constexpr uint32_t osFlagsError = 0x80000000U;
+constexpr uint32_t osFlagsErrorTimeout = 0xFFFFFFFEU;
+
+typedef enum {
+    osPriorityLow = 8,
+    osPriorityBelowNormal = 16,
+    osPriorityNormal = 24,
+    osPriorityAboveNormal = 32,
+    osPriorityHigh = 40
+} osPriority;
+
+constexpr uint32_t osWaitForever = UINT32_MAX;
+
+namespace mbed {
+
+template <typename F>
+using Callback = std::function<F>;
+
+template <typename F>
+Callback<F> callback(F *func) {
+    return Callback<F>(func);
+}
+
+template <typename R, typename... Args, typename BoundArg>
+Callback<R(Args...)> callback(R (*func)(BoundArg *, Args...), BoundArg *arg) {
+    return [func, arg](Args... args) { return func(arg, args...); };
+}
+
+template <typename T, typename R, typename... Args>
+Callback<R(Args...)> callback(T *obj, R (T::*method)(Args...)) {
+    return [obj, method](Args... args) { return (obj->*method)(args...); };
+}
+
+/**
+ * Console streams of the process. Only the standard descriptors are
+ * supported.
+ */
+class FileHandle {
+    int fd_;
+
+    FileHandle(const FileHandle &) = delete;
+    FileHandle &operator=(const FileHandle &) = delete;
+
+public:
+    explicit FileHandle(int fd) : fd_(fd) {}
+
+    ssize_t read(void *buffer, size_t size);
+    bool readable();
+    int enable_input(bool enabled);
+};
+
+FileHandle *mbed_file_handle(int fd);
+
+template <typename Lockable>
+class ScopedLock {
+    Lockable &lockable_;
+
+    ScopedLock(const ScopedLock &) = delete;
+    ScopedLock &operator=(const ScopedLock &) = delete;
+
+public:
+    explicit ScopedLock(Lockable &lockable) : lockable_(lockable) {
+        lockable_.lock();
+    }
+
+    ~ScopedLock() {
+        lockable_.unlock();
+    }
+};
+
+} // namespace mbed
+
+namespace rtos {
+
+class Mutex {
+    struct Impl;
+    Impl *impl_;
+
+    Mutex(const Mutex &) = delete;
+    Mutex &operator=(const Mutex &) = delete;
+
+public:
+    Mutex();
+    ~Mutex();
+
+    void lock();
+    bool trylock();
+    void unlock();
+};
+
+class EventFlags {
+    struct Impl;
+    Impl *impl_;
+
+    EventFlags(const EventFlags &) = delete;
+    EventFlags &operator=(const EventFlags &) = delete;
+
+public:
+    EventFlags();
+    ~EventFlags();
+
+    uint32_t set(uint32_t flags);
+    uint32_t clear(uint32_t flags = 0x7fffffff);
+    uint32_t get() const;
+    uint32_t wait_any(uint32_t flags,
+                      uint32_t millisec = osWaitForever,
+                      bool clear = true);
+    uint32_t wait_all(uint32_t flags,
+                      uint32_t millisec = osWaitForever,
+                      bool clear = true);
+    uint32_t wait_any_for(uint32_t flags,
+                          std::chrono::duration<uint32_t, std::milli> rel_time,
+                          bool clear = true);
+};
+
+/**
+ * Runs the task on a std::thread. Priority and stack size are ignored. A
+ * thread that is still running when the object is destroyed is detached.
+ */
+class Thread {
+    struct Impl;
+    Impl *impl_;
+
+    Thread(const Thread &) = delete;
+    Thread &operator=(const Thread &) = delete;
+
+public:
+    Thread(osPriority priority = osPriorityNormal,
+           uint32_t stack_size = 0,
+           unsigned char *stack_mem = nullptr,
+           const char *name = nullptr);
+    ~Thread();
+
+    osStatus start(mbed::Callback<void()> task);
+    osStatus join();
+    const char *get_name() const;
+};
+
+namespace Kernel {
+
+/**
+ * Monotonic clock counting milliseconds since the process was started, like
+ * the RTOS kernel clock counts them since reset.
+ */
+struct Clock {
+    using duration = std::chrono::milliseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<Clock>;
+    using duration_u32 = std::chrono::duration<uint32_t, period>;
+    static constexpr bool is_steady = true;
+
+    static time_point now();
+};
+
+} // namespace Kernel
+
+namespace ThisThread {
+
+void sleep_for(Kernel::Clock::duration_u32 rel_time);
+
+} // namespace ThisThread
+
+} // namespace rtos
+
+typedef mbed::ScopedLock<rtos::Mutex> ScopedMutexLock;
+
+/**
+ * Microseconds since the process was started, wrapping around like the
+ * hardware ticker does.
+ */
+uint32_t us_ticker_read();
+
+inline bool core_util_atomic_cas_u32(volatile uint32_t *ptr,
+                                     uint32_t *expected_current_value,
+                                     uint32_t desired_value) {
+    return __atomic_compare_exchange_n(ptr, expected_current_value,
+                                       desired_value, false, __ATOMIC_SEQ_CST,
+                                       __ATOMIC_SEQ_CST);
+}
+
+inline uint32_t core_util_atomic_load_u32(const volatile uint32_t *ptr) {
+    return __atomic_load_n(ptr, __ATOMIC_SEQ_CST);
+}
+
+inline uint64_t core_util_atomic_load_u64(const volatile uint64_t *ptr) {
+    return __atomic_load_n(ptr, __ATOMIC_SEQ_CST);
+}
+
+inline bool core_util_atomic_load_bool(const volatile bool *ptr) {
+    return __atomic_load_n(ptr, __ATOMIC_SEQ_CST);
+}
+
+inline void core_util_atomic_store_bool(volatile bool *ptr, bool value) {
+    __atomic_store_n(ptr, value, __ATOMIC_SEQ_CST);
+}
+
+inline uint32_t core_util_atomic_incr_u32(volatile uint32_t *ptr,
+                                          uint32_t delta) {
+    return __atomic_add_fetch(ptr, delta, __ATOMIC_SEQ_CST);
+}
+
+inline uint64_t core_util_atomic_incr_u64(volatile uint64_t *ptr,
+                                          uint64_t delta) {
+    return __atomic_add_fetch(ptr, delta, __ATOMIC_SEQ_CST);
+}
+
+using namespace mbed;
+using namespace rtos;
+using namespace std::chrono_literals;
+
+#include "EventQueue.h"
+#include "NetworkInterface.h"
+
+#endif // HOST_MBED_H
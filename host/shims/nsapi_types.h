@@ -0,0 +1,49 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef HOST_NSAPI_TYPES_H
+#define HOST_NSAPI_TYPES_H
+
+#include <cstdint>
+
+typedef int nsapi_error_t;
+
+enum nsapi_error {
+    NSAPI_ERROR_OK = 0,
+    NSAPI_ERROR_UNSUPPORTED = -3002,
+    NSAPI_ERROR_NO_CONNECTION = -3004,
+    NSAPI_ERROR_NO_MEMORY = -3007,
+    NSAPI_ERROR_NO_ADDRESS = -3010,
+    NSAPI_ERROR_DEVICE_ERROR = -3012,
+    NSAPI_ERROR_IN_PROGRESS = -3013,
+    NSAPI_ERROR_ALREADY = -3014,
+    NSAPI_ERROR_IS_CONNECTED = -3015,
+    NSAPI_ERROR_BUSY = -3020
+};
+
+typedef enum nsapi_connection_status {
+    NSAPI_STATUS_LOCAL_UP = 0,
+    NSAPI_STATUS_GLOBAL_UP = 1,
+    NSAPI_STATUS_DISCONNECTED = 2,
+    NSAPI_STATUS_CONNECTING = 3
+} nsapi_connection_status_t;
+
+typedef enum nsapi_event {
+    NSAPI_EVENT_CONNECTION_STATUS_CHANGE = 0
+} nsapi_event_t;
+
+#endif // HOST_NSAPI_TYPES_H
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <unistd.h>
+
+#include <kvstore_global_api/kvstore_global_api.h>
+
+#include "device_config_serial_menu.h"
+#include "host_test.h"
+
+namespace {
+
+// Points the KVStore at a fresh temporary directory, removed along with the
+// stored keys when the test is done
+class TempKvStore {
+    std::string dir_;
+
+public:
+    TempKvStore() {
+        char path[] = "/tmp/anjay-mbedos-config-test-XXXXXX";
+        HOST_CHECK(mkdtemp(path));
+        dir_ = path;
+        host_kvstore_set_root(dir_.c_str());
+    }
+
+    ~TempKvStore() {
+        HOST_CHECK_EQ(kv_reset("/kv/"), MBED_SUCCESS);
+        HOST_CHECK(!rmdir(dir_.c_str()));
+        host_kvstore_set_root(".");
+    }
+
+    TempKvStore(const TempKvStore &) = delete;
+    TempKvStore &operator=(const TempKvStore &) = delete;
+};
+
+// Replaces stdin with a pipe containing the given input; the write end is
+// left open, so that reading past the input blocks like on a serial port
+void set_stdin(const char *input) {
+    int fds[2];
+    HOST_CHECK(!pipe(fds));
+    HOST_CHECK(write(fds[1], input, strlen(input)) == (ssize_t) strlen(input));
+    dup2(fds[0], STDIN_FILENO);
+    close(fds[0]);
+}
+
+} // namespace
+
+HOST_TEST(config_round_trip) {
+    TempKvStore kvstore;
+
+    Lwm2mConfig stored;
+    stored.rg_server_config.server_uri = "coaps://127.0.0.1:5684";
+    stored.rg_server_config.security_mode = ANJAY_SECURITY_PSK;
+    stored.rg_server_config.psk_identity = "identity";
+    stored.rg_server_config.psk_key = "key";
+    stored.persistence_enabled = true;
+    stored.queue_mode_enabled = true;
+    stored.log_level = AVS_LOG_DEBUG;
+    stored.modem_config.apn = "internet";
+    stored.modem_config.rat = mbed::CellularNetwork::RAT_CATM1;
+    Lwm2mConfigPersistence persistence;
+    HOST_CHECK_EQ(persistence.persistence(
+                          Lwm2mConfigPersistence::Direction::STORE, stored),
+                  0);
+
+    Lwm2mConfig restored;
+    HOST_CHECK_EQ(persistence.persistence(
+                          Lwm2mConfigPersistence::Direction::RESTORE,
+                          restored),
+                  0);
+    HOST_CHECK(restored.rg_server_config.server_uri
+               == stored.rg_server_config.server_uri);
+    HOST_CHECK_EQ(restored.rg_server_config.security_mode,
+                  ANJAY_SECURITY_PSK);
+    HOST_CHECK(restored.rg_server_config.psk_identity == "identity");
+    HOST_CHECK(restored.rg_server_config.psk_key == "key");
+    HOST_CHECK(restored.persistence_enabled);
+    HOST_CHECK(restored.queue_mode_enabled);
+    HOST_CHECK_EQ(restored.log_level, AVS_LOG_DEBUG);
+    HOST_CHECK(restored.modem_config == stored.modem_config);
+}
+
+HOST_TEST(restore_from_empty_store_fails) {
+    TempKvStore kvstore;
+
+    Lwm2mConfig config;
+    Lwm2mConfigPersistence persistence;
+    HOST_CHECK_EQ(persistence.persistence(
+                          Lwm2mConfigPersistence::Direction::RESTORE, config),
+                  MBED_ERROR_ITEM_NOT_FOUND);
+}
+
+// Configuration stored by a version without Queue Mode support
+HOST_TEST(restore_config_without_queue_mode_key) {
+    TempKvStore kvstore;
+
+    Lwm2mConfig stored;
+    stored.rg_server_config.server_uri = "coap://127.0.0.1:5683";
+    stored.queue_mode_enabled = !Lwm2mConfig().queue_mode_enabled;
+    stored.log_level = AVS_LOG_WARNING;
+    stored.modem_config.apn = "internet";
+    stored.modem_config.username = "user";
+    stored.modem_config.password = "password";
+    stored.modem_config.sim_pin_code = "1234";
+    stored.modem_config.rat = mbed::CellularNetwork::RAT_NB1;
+    Lwm2mConfigPersistence persistence;
+    HOST_CHECK_EQ(persistence.persistence(
+                          Lwm2mConfigPersistence::Direction::STORE, stored),
+                  0);
+    HOST_CHECK_EQ(kv_remove("/kv/queue_mode_enabled"), MBED_SUCCESS);
+
+    Lwm2mConfig restored;
+    HOST_CHECK_EQ(persistence.persistence(
+                          Lwm2mConfigPersistence::Direction::RESTORE,
+                          restored),
+                  0);
+    HOST_CHECK(restored.rg_server_config.server_uri
+               == stored.rg_server_config.server_uri);
+    HOST_CHECK_EQ(restored.queue_mode_enabled,
+                  Lwm2mConfig().queue_mode_enabled);
+    HOST_CHECK_EQ(restored.log_level, AVS_LOG_WARNING);
+    HOST_CHECK(restored.modem_config == stored.modem_config);
+}
+
+HOST_TEST(menu_shown_on_key_press) {
+    set_stdin("x");
+    HOST_CHECK(should_show_menu(avs_time_duration_from_scalar(1, AVS_TIME_S)));
+}
+
+HOST_TEST(menu_not_shown_without_input) {
+    set_stdin("");
+    HOST_CHECK(!should_show_menu(
+            avs_time_duration_from_scalar(100, AVS_TIME_MS)));
+}
+
+int main() {
+    return host_test_run_all();
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <mbed.h>
+
+#include "connection_manager.h"
+#include "host_test.h"
+
+namespace {
+
+using Ms = events::EventQueue::duration;
+using Step = NetworkInterface::ConnectStep;
+
+constexpr int MIN_DELAY_MS = MBED_CONF_APP_NETWORK_RETRY_MIN_DELAY_MS;
+constexpr int CONNECT_TIMEOUT_MS = MBED_CONF_APP_NETWORK_CONNECT_TIMEOUT_MS;
+
+/**
+ * Connection manager driving a scripted interface on its own event queue,
+ * in simulated time, with the link changes it reports recorded.
+ */
+struct Fixture {
+    events::EventQueue queue;
+    NetworkInterface netif;
+    ConnectionManager manager;
+    std::vector<bool> link_changes;
+
+    explicit Fixture(std::vector<Step> script) {
+        netif.set_event_queue(&queue);
+        netif.set_connect_script(std::move(script));
+        manager.set_link_callback(
+                [this](bool up) { link_changes.push_back(up); });
+        HOST_CHECK(!manager.start(&netif, &queue));
+        queue.advance(Ms(0));
+    }
+
+    /**
+     * Advances the simulated time in 1 ms steps until the number of
+     * connect() calls reaches @p count, at most by @p limit_ms.
+     *
+     * @returns Time advanced, in milliseconds, or -1 on timeout.
+     */
+    int advance_until_connect_count(unsigned count, int limit_ms) {
+        int ms = 0;
+        for (; netif.connect_count() < count; ++ms) {
+            if (ms == limit_ms) {
+                return -1;
+            }
+            queue.advance(Ms(1));
+        }
+        return ms;
+    }
+};
+
+} // namespace
+
+HOST_TEST(retries_with_exponential_backoff) {
+    Fixture fixture({ { NSAPI_ERROR_NO_CONNECTION, NSAPI_STATUS_DISCONNECTED,
+                        Ms(0) } });
+    HOST_CHECK_EQ(fixture.netif.connect_count(), 1u);
+
+    // Half of each delay is random
+    for (int delay_ms = MIN_DELAY_MS; delay_ms <= 8 * MIN_DELAY_MS;
+         delay_ms *= 2) {
+        const unsigned count = fixture.netif.connect_count();
+        const int waited_ms =
+                fixture.advance_until_connect_count(count + 1, delay_ms);
+        HOST_CHECK(waited_ms >= delay_ms / 2);
+        HOST_CHECK(waited_ms <= delay_ms);
+    }
+    HOST_CHECK(!fixture.manager.link_up());
+    HOST_CHECK(fixture.link_changes.empty());
+}
+
+HOST_TEST(backoff_is_reset_once_link_is_up) {
+    Fixture fixture({ { NSAPI_ERROR_NO_CONNECTION, NSAPI_STATUS_DISCONNECTED,
+                        Ms(0) },
+                      { NSAPI_ERROR_NO_CONNECTION, NSAPI_STATUS_DISCONNECTED,
+                        Ms(0) },
+                      { NSAPI_ERROR_OK, NSAPI_STATUS_GLOBAL_UP, Ms(10) } });
+    HOST_CHECK(fixture.advance_until_connect_count(3, 3 * MIN_DELAY_MS) > 0);
+    fixture.queue.advance(Ms(10));
+    HOST_CHECK(fixture.manager.link_up());
+    HOST_CHECK(fixture.manager.link_up());
+
+    fixture.netif.drop_link();
+    fixture.queue.advance(Ms(0));
+    HOST_CHECK(!fixture.manager.link_up());
+    HOST_CHECK(fixture.advance_until_connect_count(4, MIN_DELAY_MS) > 0);
+    fixture.queue.advance(Ms(10));
+    HOST_CHECK(fixture.manager.link_up());
+    HOST_CHECK(fixture.link_changes
+               == std::vector<bool>({ true, false, true }));
+}
+
+HOST_TEST(connection_attempt_times_out) {
+    Fixture fixture({ { NSAPI_ERROR_OK, NSAPI_STATUS_GLOBAL_UP,
+                        Ms(2 * CONNECT_TIMEOUT_MS) },
+                      { NSAPI_ERROR_OK, NSAPI_STATUS_GLOBAL_UP, Ms(10) } });
+    fixture.queue.advance(Ms(CONNECT_TIMEOUT_MS));
+    HOST_CHECK_EQ(fixture.netif.connect_count(), 1u);
+    HOST_CHECK_EQ(fixture.netif.get_connection_status(),
+                  NSAPI_STATUS_DISCONNECTED);
+    HOST_CHECK(fixture.advance_until_connect_count(2, MIN_DELAY_MS) > 0);
+    fixture.queue.advance(Ms(10));
+    HOST_CHECK(fixture.manager.link_up());
+    HOST_CHECK(fixture.link_changes == std::vector<bool>({ true }));
+}
+
+HOST_TEST(stop_takes_link_down_and_cancels_retries) {
+    Fixture fixture({ { NSAPI_ERROR_OK, NSAPI_STATUS_GLOBAL_UP, Ms(10) } });
+    fixture.queue.advance(Ms(10));
+    HOST_CHECK(fixture.manager.link_up());
+
+    // stop() waits for the queue, which is only dispatched by advance()
+    std::atomic<bool> stopped{ false };
+    std::thread stopper([&]() {
+        fixture.manager.stop();
+        stopped = true;
+    });
+    while (!stopped) {
+        fixture.queue.advance(Ms(1));
+        std::this_thread::yield();
+    }
+    stopper.join();
+
+    HOST_CHECK(!fixture.manager.link_up());
+    HOST_CHECK(fixture.link_changes == std::vector<bool>({ true, false }));
+    const unsigned connect_count = fixture.netif.connect_count();
+    fixture.queue.advance(Ms(10 * MIN_DELAY_MS));
+    HOST_CHECK_EQ(fixture.netif.connect_count(), connect_count);
+}
+
+int main() {
+    return host_test_run_all();
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include "der_stream_validator.h"
+#include "host_test.h"
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+enum class Outcome { INCOMPLETE, COMPLETE, INVALID };
+
+struct Result {
+    Outcome outcome;
+    size_t consumed;
+};
+
+// Feeds the data in chunks that end at the given split points
+Result validate(const Bytes &data, const std::vector<size_t> &splits = {}) {
+    DerStreamValidator validator;
+    Result result{ Outcome::INCOMPLETE, 0 };
+    size_t offset = 0;
+    for (size_t i = 0; i <= splits.size(); ++i) {
+        const size_t end = i < splits.size() ? splits[i] : data.size();
+        size_t consumed = 0;
+        if (validator.feed(data.data() + offset, end - offset, &consumed)) {
+            result.outcome = Outcome::INVALID;
+            return result;
+        }
+        result.consumed += consumed;
+        if (validator.complete()) {
+            result.outcome = Outcome::COMPLETE;
+            return result;
+        }
+        offset = end;
+    }
+    return result;
+}
+
+Bytes tlv(uint8_t tag, const Bytes &content) {
+    Bytes result{ tag };
+    const size_t size = content.size();
+    if (size < 0x80) {
+        result.push_back((uint8_t) size);
+    } else if (size < 0x100) {
+        result.insert(result.end(), { 0x81, (uint8_t) size });
+    } else {
+        result.insert(result.end(),
+                      { 0x82, (uint8_t) (size >> 8), (uint8_t) size });
+    }
+    result.insert(result.end(), content.begin(), content.end());
+    return result;
+}
+
+Bytes concat(const Bytes &a, const Bytes &b) {
+    Bytes result = a;
+    result.insert(result.end(), b.begin(), b.end());
+    return result;
+}
+
+// Shaped like a manifest: a SEQUENCE of an INTEGER, a nested SEQUENCE with a
+// context-specific element, an OCTET STRING with long form length and an
+// element with a high tag number
+Bytes make_manifest() {
+    const Bytes nested = tlv(0x30, concat(tlv(0x02, { 0x01 }),
+                                          tlv(0xA0, tlv(0x0C, { 'v', '1' }))));
+    Bytes high_tag = { 0x9F, 0x81, 0x01, 0x02, 0xAB, 0xCD };
+    Bytes content = concat(tlv(0x02, { 0x01, 0x00, 0x00 }), nested);
+    content = concat(content, tlv(0x04, Bytes(300, 0x5A)));
+    content = concat(content, high_tag);
+    return tlv(0x30, content);
+}
+
+} // namespace
+
+HOST_TEST(valid_manifest_is_complete) {
+    const Bytes manifest = make_manifest();
+    const Result result = validate(manifest);
+    HOST_CHECK(result.outcome == Outcome::COMPLETE);
+    HOST_CHECK_EQ(result.consumed, manifest.size());
+
+    DerStreamValidator validator;
+    size_t consumed = 0;
+    HOST_CHECK_EQ(validator.feed(manifest.data(), 4, &consumed), 0);
+    HOST_CHECK_EQ(validator.total_size(), manifest.size());
+}
+
+HOST_TEST(trailing_data_is_not_consumed) {
+    const Bytes manifest = make_manifest();
+    const Result result = validate(concat(manifest, { 0x01, 0x02, 0x03 }));
+    HOST_CHECK(result.outcome == Outcome::COMPLETE);
+    HOST_CHECK_EQ(result.consumed, manifest.size());
+}
+
+HOST_TEST(split_at_every_byte_boundary) {
+    const Bytes manifest = concat(make_manifest(), { 0xFF });
+    for (size_t split = 0; split <= manifest.size(); ++split) {
+        const Result result = validate(manifest, { split });
+        HOST_CHECK(result.outcome == Outcome::COMPLETE);
+        HOST_CHECK_EQ(result.consumed, manifest.size() - 1);
+    }
+    std::vector<size_t> every_byte;
+    for (size_t split = 1; split < manifest.size(); ++split) {
+        every_byte.push_back(split);
+    }
+    const Result result = validate(manifest, every_byte);
+    HOST_CHECK(result.outcome == Outcome::COMPLETE);
+    HOST_CHECK_EQ(result.consumed, manifest.size() - 1);
+}
+
+HOST_TEST(truncated_manifest_is_incomplete) {
+    const Bytes manifest = make_manifest();
+    for (size_t size = 0; size < manifest.size(); ++size) {
+        const Bytes truncated(manifest.begin(), manifest.begin() + size);
+        const Result result = validate(truncated);
+        HOST_CHECK(result.outcome == Outcome::INCOMPLETE);
+        HOST_CHECK_EQ(result.consumed, size);
+    }
+}
+
+HOST_TEST(outer_element_must_be_sequence) {
+    HOST_CHECK(validate({ 0x04, 0x01, 0x00 }).outcome == Outcome::INVALID);
+    HOST_CHECK(validate({ 0x31, 0x00 }).outcome == Outcome::INVALID);
+}
+
+HOST_TEST(over_long_length_is_rejected) {
+    // Long form where the short one would do
+    HOST_CHECK(validate({ 0x30, 0x81, 0x05, 0x02, 0x01, 0x00, 0x05, 0x00 })
+                       .outcome
+               == Outcome::INVALID);
+    // Leading zero byte
+    HOST_CHECK(validate({ 0x30, 0x82, 0x00, 0x90 }).outcome
+               == Outcome::INVALID);
+    // Indefinite length
+    HOST_CHECK(validate({ 0x30, 0x80, 0x00, 0x00 }).outcome
+               == Outcome::INVALID);
+    // More length bytes than supported
+    HOST_CHECK(validate({ 0x30, 0x85, 0x01, 0x00, 0x00, 0x00, 0x00 }).outcome
+               == Outcome::INVALID);
+    // Leading zero group of a high tag number
+    HOST_CHECK(validate({ 0x30, 0x04, 0x1F, 0x80, 0x01, 0x00 }).outcome
+               == Outcome::INVALID);
+}
+
+HOST_TEST(nested_length_must_fit_in_parent) {
+    // INTEGER declared longer than the remaining contents of the SEQUENCE
+    HOST_CHECK(validate({ 0x30, 0x03, 0x02, 0x02, 0x00 }).outcome
+               == Outcome::INVALID);
+    // Nested SEQUENCE overflowing its parent, which ends before it does
+    HOST_CHECK(validate({ 0x30, 0x05, 0x30, 0x04, 0x02, 0x01, 0x00, 0x00 })
+                       .outcome
+               == Outcome::INVALID);
+    // Long form length of a nested element past the parent
+    HOST_CHECK(validate({ 0x30, 0x04, 0x04, 0x82, 0x01, 0x00 }).outcome
+               == Outcome::INVALID);
+    // End-of-contents octets inside a definite length SEQUENCE
+    HOST_CHECK(validate({ 0x30, 0x02, 0x00, 0x00 }).outcome
+               == Outcome::INVALID);
+}
+
+HOST_TEST(deep_nesting_is_accepted) {
+    Bytes element = tlv(0x05, {});
+    for (size_t i = 0; i < DerStreamValidator::MAX_DEPTH + 4; ++i) {
+        element = tlv(0x30, element);
+    }
+    const Result result = validate(element);
+    HOST_CHECK(result.outcome == Outcome::COMPLETE);
+    HOST_CHECK_EQ(result.consumed, element.size());
+}
+
+int main() {
+    return host_test_run_all();
+}
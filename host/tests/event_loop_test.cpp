@@ -0,0 +1,206 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <anjay/anjay.h>
+#include <avsystem/commons/avs_sched.h>
+
+#include "event_loop.h"
+#include "host_test.h"
+#include "latency_histogram.h"
+#include "wakeup_stats.h"
+
+namespace {
+
+struct JobArgs {
+    EventLoop *event_loop;
+    bool interrupt;
+};
+
+avs_time_monotonic_t START_TIME;
+std::vector<int64_t> JOB_TIMES_MS;
+
+int64_t elapsed_ms() {
+    int64_t result;
+    avs_time_duration_to_scalar(
+            &result, AVS_TIME_MS,
+            avs_time_monotonic_diff(avs_time_monotonic_now(), START_TIME));
+    return result;
+}
+
+void job(avs_sched_t *sched, const void *args_) {
+    (void) sched;
+    const JobArgs *args = (const JobArgs *) args_;
+    JOB_TIMES_MS.push_back(elapsed_ms());
+    if (args->interrupt) {
+        args->event_loop->interrupt();
+    }
+}
+
+void schedule_job(anjay_t *anjay,
+                  EventLoop *event_loop,
+                  int delay_ms,
+                  bool interrupt) {
+    const JobArgs args = { event_loop, interrupt };
+    HOST_CHECK(!AVS_SCHED_DELAYED(
+            anjay_get_scheduler(anjay), nullptr,
+            avs_time_duration_from_scalar(delay_ms, AVS_TIME_MS), job, &args,
+            sizeof(args)));
+}
+
+anjay_t *create_anjay() {
+    anjay_configuration_t config;
+    memset(&config, 0, sizeof(config));
+    config.endpoint_name = "event-loop-test";
+    anjay_t *anjay = anjay_new(&config);
+    HOST_CHECK(anjay);
+    // Jobs scheduled by Anjay itself on startup
+    anjay_sched_run(anjay);
+    return anjay;
+}
+
+/**
+ * Counts wakeups of each event loop cause since construction.
+ */
+class WakeupCounter {
+    uint32_t packets_;
+    uint32_t jobs_;
+    uint32_t timeouts_;
+
+public:
+    WakeupCounter()
+            : packets_(wakeup_stats_count(WakeupCause::INCOMING_PACKET)),
+              jobs_(wakeup_stats_count(WakeupCause::SCHEDULED_JOB)),
+              timeouts_(wakeup_stats_count(WakeupCause::LOOP_TIMEOUT)) {}
+
+    uint32_t packets() const {
+        return wakeup_stats_count(WakeupCause::INCOMING_PACKET) - packets_;
+    }
+
+    uint32_t jobs() const {
+        return wakeup_stats_count(WakeupCause::SCHEDULED_JOB) - jobs_;
+    }
+
+    uint32_t timeouts() const {
+        return wakeup_stats_count(WakeupCause::LOOP_TIMEOUT) - timeouts_;
+    }
+};
+
+void start_run() {
+    JOB_TIMES_MS.clear();
+    START_TIME = avs_time_monotonic_now();
+}
+
+} // namespace
+
+HOST_TEST(wait_time_is_limited_by_next_job_and_max_wait) {
+    anjay_t *anjay = create_anjay();
+    EventLoop unlimited(anjay, -1);
+    EventLoop limited(anjay, 100);
+
+    schedule_job(anjay, &unlimited, 300, false);
+    HOST_CHECK(unlimited.wait_time_ms() > 200);
+    HOST_CHECK(unlimited.wait_time_ms() <= 300);
+    HOST_CHECK_EQ(limited.wait_time_ms(), 100);
+
+    schedule_job(anjay, &unlimited, 50, false);
+    HOST_CHECK(limited.wait_time_ms() <= 50);
+    anjay_delete(anjay);
+}
+
+HOST_TEST(sleeps_until_next_job) {
+    anjay_t *anjay = create_anjay();
+    EventLoop event_loop(anjay, -1);
+    // Spaced widely enough for the jobs not to become due together even if
+    // the loop wakes up late, e.g. under load or valgrind
+    schedule_job(anjay, &event_loop, 20, false);
+    schedule_job(anjay, &event_loop, 220, false);
+    schedule_job(anjay, &event_loop, 420, true);
+
+    latency_histograms_reset();
+    const WakeupCounter wakeups;
+    start_run();
+    HOST_CHECK_EQ(event_loop.run(), 0);
+
+    HOST_CHECK_EQ(JOB_TIMES_MS.size(), 3u);
+    const int64_t due_ms[] = { 20, 220, 420 };
+    for (size_t i = 0; i < JOB_TIMES_MS.size() && i < 3; ++i) {
+        HOST_CHECK(JOB_TIMES_MS[i] >= due_ms[i]);
+        HOST_CHECK(JOB_TIMES_MS[i] < due_ms[i] + 200);
+    }
+    // One wakeup per job, none in between
+    HOST_CHECK_EQ(wakeups.jobs(), 3u);
+    HOST_CHECK_EQ(wakeups.timeouts(), 0u);
+    HOST_CHECK_EQ(wakeups.packets(), 0u);
+
+    // Every job is timed, along with how late the loop woke up for it
+    const LatencyHistogram runs =
+            latency_histogram_snapshot(LatencyHistogramId::SCHED_RUN);
+    HOST_CHECK_EQ(runs.count(), 3u);
+    const LatencyHistogram lag =
+            latency_histogram_snapshot(LatencyHistogramId::EVENT_LOOP_LAG);
+    HOST_CHECK_EQ(lag.count(), 3u);
+    HOST_CHECK(lag.max_us() < 200000);
+    anjay_delete(anjay);
+}
+
+HOST_TEST(max_wait_wakeups_are_accounted) {
+    anjay_t *anjay = create_anjay();
+    EventLoop event_loop(anjay, 20);
+    schedule_job(anjay, &event_loop, 110, true);
+
+    const WakeupCounter wakeups;
+    start_run();
+    HOST_CHECK_EQ(event_loop.run(), 0);
+
+    HOST_CHECK_EQ(JOB_TIMES_MS.size(), 1u);
+    HOST_CHECK_EQ(wakeups.jobs(), 1u);
+    // After 20, 40, 60, 80 and 100 ms at most; fewer if the loop wakes up
+    // late
+    HOST_CHECK(wakeups.timeouts() >= 1);
+    HOST_CHECK(wakeups.timeouts() <= 5);
+    anjay_delete(anjay);
+}
+
+HOST_TEST(interrupt_from_other_thread_takes_effect_after_max_wait) {
+    anjay_t *anjay = create_anjay();
+    EventLoop event_loop(anjay, 50);
+    std::thread interrupter([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        event_loop.interrupt();
+    });
+
+    const WakeupCounter wakeups;
+    start_run();
+    HOST_CHECK_EQ(event_loop.run(), 0);
+    interrupter.join();
+
+    // The interrupt is not noticed before the first timeout; more of them
+    // happen if the other thread gets to run late
+    HOST_CHECK(elapsed_ms() >= 50);
+    HOST_CHECK(wakeups.timeouts() >= 1);
+    HOST_CHECK_EQ(wakeups.jobs(), 0u);
+    anjay_delete(anjay);
+}
+
+int main() {
+    return host_test_run_all();
+}
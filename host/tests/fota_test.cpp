@@ -0,0 +1,202 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <anjay/fw_update.h>
+
+#include "fota.h"
+#include "fota_telemetry.h"
+#include "host_alloc_stats.h"
+#include "host_fota.h"
+#include "host_test.h"
+#include "mbed_cloud_fota_wrapper.h"
+
+namespace {
+
+std::vector<uint8_t> make_image(size_t size) {
+    std::vector<uint8_t> image(size);
+    uint32_t state = 0x12345678;
+    for (uint8_t &byte : image) {
+        state = state * 1103515245 + 12345;
+        byte = (uint8_t) (state >> 16);
+    }
+    return image;
+}
+
+// Writes the package in chunks of varying size, like block-wise transfers
+// with a different block size than the program size
+int write_package(MbedCloudFotaFlasher &flasher,
+                  const std::vector<uint8_t> &package,
+                  size_t max_chunk) {
+    size_t offset = 0;
+    size_t chunk = 1;
+    while (offset < package.size()) {
+        const size_t size = std::min(chunk, package.size() - offset);
+        const int result = flasher.write(package.data() + offset, size);
+        if (result) {
+            return result;
+        }
+        offset += size;
+        chunk = chunk % max_chunk + 37;
+    }
+    return 0;
+}
+
+std::vector<uint8_t> make_package(const std::vector<uint8_t> &image) {
+    std::vector<uint8_t> package =
+            host_fota_manifest(image.data(), image.size());
+    package.insert(package.end(), image.begin(), image.end());
+    return package;
+}
+
+} // namespace
+
+HOST_TEST(update_stores_image_and_installs) {
+    host_fota_reset();
+    const std::vector<uint8_t> image = make_image(10000);
+    FotaTelemetry::INSTANCE.download_started();
+    {
+        MbedCloudFotaFlasher flasher;
+        HOST_CHECK_EQ(write_package(flasher, make_package(image), 1024), 0);
+        HOST_CHECK_EQ(flasher.finish(), 0);
+        HOST_CHECK(host_fota_candidate() == image);
+        flasher.flash();
+        HOST_CHECK(host_fota_installed());
+    }
+}
+
+HOST_TEST(corrupted_image_is_rejected) {
+    host_fota_reset();
+    const std::vector<uint8_t> image = make_image(5000);
+    std::vector<uint8_t> package = make_package(image);
+    package.back() ^= 1;
+    FotaTelemetry::INSTANCE.download_started();
+    MbedCloudFotaFlasher flasher;
+    HOST_CHECK_EQ(write_package(flasher, package, 512), 0);
+    HOST_CHECK_EQ(flasher.finish(), (int) ANJAY_FW_UPDATE_ERR_INTEGRITY_FAILURE);
+}
+
+HOST_TEST(truncated_image_is_rejected) {
+    host_fota_reset();
+    const std::vector<uint8_t> image = make_image(5000);
+    std::vector<uint8_t> package = make_package(image);
+    package.resize(package.size() - 100);
+    FotaTelemetry::INSTANCE.download_started();
+    MbedCloudFotaFlasher flasher;
+    HOST_CHECK_EQ(write_package(flasher, package, 512), 0);
+    HOST_CHECK(flasher.finish() != 0);
+    HOST_CHECK(!host_fota_installed());
+}
+
+HOST_TEST(malformed_manifest_is_rejected) {
+    host_fota_reset();
+    // A SEQUENCE of an OCTET STRING, instead of the payload size and digest
+    const uint8_t package[] = { 0x30, 0x03, 0x04, 0x01, 0x00, 0xAA, 0xBB };
+    FotaTelemetry::INSTANCE.download_started();
+    MbedCloudFotaFlasher flasher;
+    HOST_CHECK_EQ(flasher.write(package, sizeof(package)),
+                  (int) ANJAY_FW_UPDATE_ERR_UNSUPPORTED_PACKAGE_TYPE);
+    HOST_CHECK(!host_fota_installed());
+}
+
+HOST_TEST(reset_download_counts_as_failure) {
+    host_fota_reset();
+    const std::vector<uint8_t> image = make_image(5000);
+    const std::vector<uint8_t> package = make_package(image);
+    const uint32_t attempts = FotaTelemetry::INSTANCE.attempts();
+    const uint32_t failures = FotaTelemetry::INSTANCE.failures();
+    FotaTelemetry::INSTANCE.download_started();
+    {
+        MbedCloudFotaFlasher flasher;
+        HOST_CHECK_EQ(flasher.write(package.data(), package.size() / 2), 0);
+        HOST_CHECK(fota_is_active_update());
+    }
+    HOST_CHECK(!fota_is_active_update());
+    HOST_CHECK_EQ(FotaTelemetry::INSTANCE.attempts(), attempts + 1);
+    HOST_CHECK_EQ(FotaTelemetry::INSTANCE.failures(), failures + 1);
+}
+
+HOST_TEST(failure_is_counted_once) {
+    host_fota_reset();
+    const std::vector<uint8_t> image = make_image(5000);
+    std::vector<uint8_t> package = make_package(image);
+    package.back() ^= 1;
+    const uint32_t failures = FotaTelemetry::INSTANCE.failures();
+    FotaTelemetry::INSTANCE.download_started();
+    {
+        MbedCloudFotaFlasher flasher;
+        HOST_CHECK_EQ(write_package(flasher, package, 512), 0);
+        HOST_CHECK(flasher.finish() != 0);
+        // Then reset, like Anjay does after a failed download
+    }
+    HOST_CHECK_EQ(FotaTelemetry::INSTANCE.failures(), failures + 1);
+}
+
+HOST_TEST(finished_download_is_not_a_failure) {
+    host_fota_reset();
+    const std::vector<uint8_t> image = make_image(5000);
+    const uint32_t failures = FotaTelemetry::INSTANCE.failures();
+    FotaTelemetry::INSTANCE.download_started();
+    {
+        MbedCloudFotaFlasher flasher;
+        HOST_CHECK_EQ(write_package(flasher, make_package(image), 512), 0);
+        HOST_CHECK_EQ(flasher.finish(), 0);
+        // Reset after the download has finished, e.g. the update has been
+        // cancelled before the installation
+    }
+    HOST_CHECK_EQ(FotaTelemetry::INSTANCE.failures(), failures);
+}
+
+HOST_TEST(manifest_is_not_stored_on_heap) {
+    host_fota_reset();
+    const std::vector<uint8_t> image = make_image(1000);
+    // Padded close to the limit, so that buffering it on the heap would show
+    const std::vector<uint8_t> manifest =
+            host_fota_manifest(image.data(), image.size(),
+                               MBED_CONF_ANJAY_MBED_FOTA_MAX_MANIFEST_SIZE
+                                       - 64);
+    HOST_CHECK(manifest.size()
+               <= MBED_CONF_ANJAY_MBED_FOTA_MAX_MANIFEST_SIZE);
+    FotaTelemetry::INSTANCE.download_started();
+    MbedCloudFotaFlasher flasher;
+    const HostAllocStats before = host_alloc_stats_get();
+    for (uint8_t byte : manifest) {
+        HOST_CHECK_EQ(flasher.write(&byte, 1), 0);
+    }
+    // Including passing it to fota_on_manifest() and the authorization
+    const HostAllocStats after = host_alloc_stats_get();
+    HOST_CHECK_EQ(after.allocated_bytes - before.allocated_bytes, 0);
+    HOST_CHECK_EQ(after.allocation_count - before.allocation_count, 0);
+}
+
+HOST_TEST(oversized_manifest_is_rejected_after_header) {
+    host_fota_reset();
+    const std::vector<uint8_t> image = make_image(1000);
+    const std::vector<uint8_t> manifest =
+            host_fota_manifest(image.data(), image.size(),
+                               MBED_CONF_ANJAY_MBED_FOTA_MAX_MANIFEST_SIZE);
+    FotaTelemetry::INSTANCE.download_started();
+    MbedCloudFotaFlasher flasher;
+    // Tag and long form length of the outermost SEQUENCE
+    HOST_CHECK(flasher.write(manifest.data(), 4) != 0);
+}
+
+int main() {
+    return host_test_run_all();
+}
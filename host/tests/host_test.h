@@ -0,0 +1,92 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+/**
+ * Minimal unit test support for the host tests: each test executable
+ * registers its test cases with HOST_TEST() and runs them all with
+ * host_test_run_all(), returning a non-zero exit code if any check failed.
+ */
+
+struct HostTestCase {
+    const char *name;
+    std::function<void()> body;
+};
+
+inline std::vector<HostTestCase> &host_test_cases() {
+    static std::vector<HostTestCase> cases;
+    return cases;
+}
+
+inline int &host_test_failures() {
+    static int failures;
+    return failures;
+}
+
+struct HostTestRegistrar {
+    HostTestRegistrar(const char *name, std::function<void()> body) {
+        host_test_cases().push_back(HostTestCase{ name, std::move(body) });
+    }
+};
+
+#define HOST_TEST(Name)                                        \
+    void host_test_##Name();                                   \
+    const HostTestRegistrar host_test_registrar_##Name{        \
+        #Name, host_test_##Name                                \
+    };                                                         \
+    void host_test_##Name()
+
+#define HOST_CHECK(Cond)                                                   \
+    do {                                                                   \
+        if (!(Cond)) {                                                     \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, \
+                    #Cond);                                                \
+            ++host_test_failures();                                        \
+        }                                                                  \
+    } while (0)
+
+#define HOST_CHECK_EQ(Actual, Expected)                                      \
+    do {                                                                     \
+        const auto host_test_actual_ = (Actual);                             \
+        const auto host_test_expected_ = (Expected);                         \
+        if (!(host_test_actual_ == host_test_expected_)) {                   \
+            fprintf(stderr, "%s:%d: check failed: %s == %s (%lld != %lld)\n", \
+                    __FILE__, __LINE__, #Actual, #Expected,                  \
+                    (long long) host_test_actual_,                           \
+                    (long long) host_test_expected_);                        \
+            ++host_test_failures();                                          \
+        }                                                                    \
+    } while (0)
+
+inline int host_test_run_all() {
+    for (const HostTestCase &test_case : host_test_cases()) {
+        const int failures_before = host_test_failures();
+        test_case.body();
+        printf("[%s] %s\n",
+               host_test_failures() == failures_before ? "  OK  " : " FAIL ",
+               test_case.name);
+    }
+    return host_test_failures() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+#endif // HOST_TEST_H
@@ -0,0 +1,186 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <CellularNetwork.h>
+#include <anjay/anjay.h>
+
+#include "accelerometer.h"
+#include "barometer.h"
+#include "conn_monitoring_object.h"
+#include "device_object.h"
+#include "host_test.h"
+#include "humidity.h"
+#include "magnetometer.h"
+#include "object_registry.h"
+#include "system_health_object.h"
+
+namespace {
+
+std::vector<std::string> CALLS;
+std::string FAILING_INSTALL;
+std::vector<anjay_oid_t> OBSERVED_OIDS;
+
+int mock_install(const char *name) {
+    CALLS.push_back(std::string("install ") + name);
+    return FAILING_INSTALL == name ? -1 : 0;
+}
+
+void mock_uninstall(const char *name) {
+    CALLS.push_back(std::string("uninstall ") + name);
+}
+
+void mock_update(const char *name) {
+    CALLS.push_back(std::string("update ") + name);
+}
+
+void reset_mocks() {
+    CALLS.clear();
+    FAILING_INSTALL.clear();
+    OBSERVED_OIDS.clear();
+}
+
+std::vector<std::string> calls(const char *prefix,
+                               const std::vector<const char *> &names) {
+    std::vector<std::string> result;
+    for (const char *name : names) {
+        result.push_back(std::string(prefix) + " " + name);
+    }
+    return result;
+}
+
+int64_t to_ms(avs_time_duration_t duration) {
+    int64_t ms = 0;
+    avs_time_duration_to_scalar(&ms, AVS_TIME_MS, duration);
+    return ms;
+}
+
+// Table order of the Objects compiled into the host build
+const std::vector<const char *> INSTALL_ORDER = {
+    "device",       "system_health", "humidity", "barometer",
+    "magnetometer", "accelerometer", "conn_monitoring"
+};
+
+} // namespace
+
+#define MOCK_OBJECT(Name)                     \
+    int Name##_object_install(anjay_t *) {    \
+        return mock_install(#Name);           \
+    }                                         \
+    void Name##_object_uninstall(anjay_t *) { \
+        mock_uninstall(#Name);                \
+    }
+
+#define MOCK_UPDATE(Name)                  \
+    void Name##_object_update(anjay_t *) { \
+        mock_update(#Name);                \
+    }
+
+MOCK_OBJECT(device)
+MOCK_UPDATE(device)
+MOCK_OBJECT(system_health)
+MOCK_UPDATE(system_health)
+MOCK_OBJECT(humidity)
+MOCK_UPDATE(humidity)
+MOCK_OBJECT(barometer)
+MOCK_UPDATE(barometer)
+MOCK_OBJECT(magnetometer)
+MOCK_UPDATE(magnetometer)
+MOCK_OBJECT(accelerometer)
+MOCK_UPDATE(accelerometer)
+
+int conn_monitoring_object_install(anjay_t *,
+                                   mbed::CellularContext *,
+                                   mbed::CellularNetwork *) {
+    return mock_install("conn_monitoring");
+}
+
+void conn_monitoring_object_uninstall(anjay_t *) {
+    mock_uninstall("conn_monitoring");
+}
+
+anjay_resource_observation_status_t anjay_resource_observation_status(
+        anjay_t *, anjay_oid_t oid, anjay_iid_t, anjay_rid_t) {
+    anjay_resource_observation_status_t status;
+    memset(&status, 0, sizeof(status));
+    for (anjay_oid_t observed : OBSERVED_OIDS) {
+        status.is_observed = status.is_observed || observed == oid;
+    }
+    return status;
+}
+
+HOST_TEST(objects_are_installed_in_table_order) {
+    reset_mocks();
+    mbed::CellularNetwork network;
+    HOST_CHECK_EQ(object_registry_install(nullptr, &network), 0);
+    HOST_CHECK(CALLS == calls("install", INSTALL_ORDER));
+}
+
+HOST_TEST(objects_are_uninstalled_in_reverse_order) {
+    reset_mocks();
+    object_registry_uninstall(nullptr);
+    std::vector<const char *> reverse(INSTALL_ORDER.rbegin(),
+                                      INSTALL_ORDER.rend());
+    HOST_CHECK(CALLS == calls("uninstall", reverse));
+}
+
+HOST_TEST(install_stops_at_first_failure) {
+    reset_mocks();
+    FAILING_INSTALL = "humidity";
+    mbed::CellularNetwork network;
+    HOST_CHECK(object_registry_install(nullptr, &network) != 0);
+    HOST_CHECK(CALLS
+               == calls("install",
+                        { "device", "system_health", "humidity" }));
+}
+
+HOST_TEST(conn_monitoring_requires_network) {
+    reset_mocks();
+    HOST_CHECK_EQ(object_registry_install(nullptr, nullptr), 0);
+    std::vector<const char *> expected(INSTALL_ORDER.begin(),
+                                       INSTALL_ORDER.end() - 1);
+    HOST_CHECK(CALLS == calls("install", expected));
+}
+
+HOST_TEST(objects_are_updated_in_table_order) {
+    reset_mocks();
+    object_registry_update(nullptr);
+    // Connectivity Monitoring has no update function
+    std::vector<const char *> expected(INSTALL_ORDER.begin(),
+                                       INSTALL_ORDER.end() - 1);
+    HOST_CHECK(CALLS == calls("update", expected));
+}
+
+HOST_TEST(update_delay_follows_observed_objects) {
+    reset_mocks();
+    HOST_CHECK_EQ(to_ms(object_registry_next_update_delay(nullptr)),
+                  MBED_CONF_APP_IDLE_UPDATE_PERIOD_MS);
+    // Resources of the Device Object are not polled
+    OBSERVED_OIDS = { 3 };
+    HOST_CHECK_EQ(to_ms(object_registry_next_update_delay(nullptr)),
+                  MBED_CONF_APP_IDLE_UPDATE_PERIOD_MS);
+    // Barometer
+    OBSERVED_OIDS = { 3315 };
+    HOST_CHECK_EQ(to_ms(object_registry_next_update_delay(nullptr)),
+                  MBED_CONF_APP_SENSOR_SAMPLE_PERIOD_MS);
+}
+
+int main() {
+    return host_test_run_all();
+}
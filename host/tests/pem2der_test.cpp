@@ -0,0 +1,179 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "anjay-mbed-fota/anjay_mbed_fota_conversions.h"
+#include "host_test.h"
+
+using namespace avs::constexpr_conversions;
+
+namespace {
+
+// Chain of three certificates, DER-encoded on 374, 376 and 372 bytes, i.e.
+// with one, two and no padding characters at the end of their base64 blocks
+constexpr const char CHAIN_PEM[] =
+        "-----BEGIN CERTIFICATE-----\n"
+        "MIIBcjCCARigAwIBAgIBATAKBggqhkjOPQQDAjAYMRYwFAYDVQQDDA1hbmpheS10\n"
+        "ZXN0LTF4MB4XDTI2MTAxODE5MzE0NVoXDTM2MTAxNTE5MzE0NVowGDEWMBQGA1UE\n"
+        "AwwNYW5qYXktdGVzdC0xeDBZMBMGByqGSM49AgEGCCqGSM49AwEHA0IABDtElK6r\n"
+        "+5eMZR461sejkOpL5BCvu7av4ANQb9T/q8A5wnXZS3Q/mfM4W95iWMXSxcUZsFjj\n"
+        "XK1v9akR6C+8qv+jUzBRMB0GA1UdDgQWBBRSv1zEffiYqIAwccQRZS/aMXg2KjAf\n"
+        "BgNVHSMEGDAWgBRSv1zEffiYqIAwccQRZS/aMXg2KjAPBgNVHRMBAf8EBTADAQH/\n"
+        "MAoGCCqGSM49BAMCA0gAMEUCIQD2fwa0JejUXKho3q9BoykXoo2QAqJTc0cjeSHE\n"
+        "BcvTgAIgTk8UYz/WYfVac9rj//HiBGuaM2JLzGuqZXwFoI+zlLo=\n"
+        "-----END CERTIFICATE-----\n"
+        "-----BEGIN CERTIFICATE-----\n"
+        "MIIBdDCCARqgAwIBAgIBBzAKBggqhkjOPQQDAjAZMRcwFQYDVQQDDA5hbmpheS10\n"
+        "ZXN0LWFiYzAeFw0yNjEwMTgxOTMxNDlaFw0zNjEwMTUxOTMxNDlaMBkxFzAVBgNV\n"
+        "BAMMDmFuamF5LXRlc3QtYWJjMFkwEwYHKoZIzj0CAQYIKoZIzj0DAQcDQgAEXbAd\n"
+        "naL6InaqLtfBtxGLAcDkABM2zxW6FWK75qrDHSyqGAi9KZVPiwgjgWtZatoukrv1\n"
+        "D8XE/6O+RZ5xkqZ4B6NTMFEwHQYDVR0OBBYEFCPGXS74edZwhRf+5mQ7PiSI58B/\n"
+        "MB8GA1UdIwQYMBaAFCPGXS74edZwhRf+5mQ7PiSI58B/MA8GA1UdEwEB/wQFMAMB\n"
+        "Af8wCgYIKoZIzj0EAwIDSAAwRQIgW+Qv5/iG02qPVnX8kP5beIaML47I0M046eD0\n"
+        "23tO/b4CIQDWeM/NiJrvykquj1pQFcd68BMcNfLtPYmqQIURHzjS8g==\n"
+        "-----END CERTIFICATE-----\n"
+        "-----BEGIN CERTIFICATE-----\n"
+        "MIIBcDCCARagAwIBAgIBBDAKBggqhkjOPQQDAjAXMRUwEwYDVQQDDAxhbmpheS10\n"
+        "ZXN0LTQwHhcNMjYxMDE4MTkzMTQ1WhcNMzYxMDE1MTkzMTQ1WjAXMRUwEwYDVQQD\n"
+        "DAxhbmpheS10ZXN0LTQwWTATBgcqhkjOPQIBBggqhkjOPQMBBwNCAARspOo8BCf9\n"
+        "r/OQbGPyVUvsFsMQWrUref9eov6gmx3ftnu8NUmEEP4ZsTa3goJo+6EFpthO51lv\n"
+        "Yw/Weh00PDMjo1MwUTAdBgNVHQ4EFgQU2TS2pM8/7Bol/iKkrK2YCRlxgekwHwYD\n"
+        "VR0jBBgwFoAU2TS2pM8/7Bol/iKkrK2YCRlxgekwDwYDVR0TAQH/BAUwAwEB/zAK\n"
+        "BggqhkjOPQQDAgNIADBFAiEAyDew3iwRdRdVeysWWjmlMSBiWfTivYk/TqaPnCps\n"
+        "2kgCIGVH96I2dnGzBsGb/uhu076OekP8VyNKz0Q8m1uqeX5F\n"
+        "-----END CERTIFICATE-----\n";
+
+// The same certificates, as converted by openssl x509 -outform der
+constexpr const char CHAIN_DER_HEX[] =
+        "3082017230820118a003020102020101300a06082a8648ce3d04030230183116"
+        "301406035504030c0d616e6a61792d746573742d3178301e170d323631303138"
+        "3139333134355a170d3336313031353139333134355a30183116301406035504"
+        "030c0d616e6a61792d746573742d31783059301306072a8648ce3d020106082a"
+        "8648ce3d030107034200043b4494aeabfb978c651e3ad6c7a390ea4be410afbb"
+        "b6afe003506fd4ffabc039c275d94b743f99f3385bde6258c5d2c5c519b058e3"
+        "5cad6ff5a911e82fbcaaffa3533051301d0603551d0e0416041452bf5cc47df8"
+        "98a8803071c411652fda3178362a301f0603551d2304183016801452bf5cc47d"
+        "f898a8803071c411652fda3178362a300f0603551d130101ff040530030101ff"
+        "300a06082a8648ce3d0403020348003045022100f67f06b425e8d45ca868deaf"
+        "41a32917a28d9002a2537347237921c405cbd38002204e4f14633fd661f55a73"
+        "dae3fff1e2046b9a33624bcc6baa657c05a08fb394ba308201743082011aa003"
+        "020102020107300a06082a8648ce3d04030230193117301506035504030c0e61"
+        "6e6a61792d746573742d616263301e170d3236313031383139333134395a170d"
+        "3336313031353139333134395a30193117301506035504030c0e616e6a61792d"
+        "746573742d6162633059301306072a8648ce3d020106082a8648ce3d03010703"
+        "4200045db01d9da2fa2276aa2ed7c1b7118b01c0e4001336cf15ba1562bbe6aa"
+        "c31d2caa1808bd29954f8b0823816b596ada2e92bbf50fc5c4ffa3be459e7192"
+        "a67807a3533051301d0603551d0e0416041423c65d2ef879d6708517fee6643b"
+        "3e2488e7c07f301f0603551d2304183016801423c65d2ef879d6708517fee664"
+        "3b3e2488e7c07f300f0603551d130101ff040530030101ff300a06082a8648ce"
+        "3d040302034800304502205be42fe7f886d36a8f5675fc90fe5b78868c2f8ec8"
+        "d0cd38e9e0f4db7b4efdbe022100d678cfcd889aefca4aae8f5a5015c77af013"
+        "1c35f2ed3d89aa4085111f38d2f23082017030820116a003020102020104300a"
+        "06082a8648ce3d04030230173115301306035504030c0c616e6a61792d746573"
+        "742d34301e170d3236313031383139333134355a170d33363130313531393331"
+        "34355a30173115301306035504030c0c616e6a61792d746573742d3430593013"
+        "06072a8648ce3d020106082a8648ce3d030107034200046ca4ea3c0427fdaff3"
+        "906c63f2554bec16c3105ab52b79ff5ea2fea09b1ddfb67bbc35498410fe19b1"
+        "36b7828268fba105a6d84ee7596f630fd67a1d343c3323a3533051301d060355"
+        "1d0e04160414d934b6a4cf3fec1a25fe22a4acad9809197181e9301f0603551d"
+        "23041830168014d934b6a4cf3fec1a25fe22a4acad9809197181e9300f060355"
+        "1d130101ff040530030101ff300a06082a8648ce3d0403020348003045022100"
+        "c837b0de2c117517557b2b165a39a531206259f4e2bd893f4ea68f9c2a6cda48"
+        "02206547f7a2367671b306c19bfee86ed3be8e7a43fc57234acf443c9b5baa79"
+        "7e45";
+
+// The second certificate, without the header lines, quoted like the values
+// from the application configuration are by AVS_QUOTE_MACRO()
+constexpr const char QUOTED_BASE64[] =
+        "\"MIIBdDCCARqgAwIBAgIBBzAKBggqhkjOPQQDAjAZMRcwFQYDVQQDDA5hbmpheS10"
+        "ZXN0LWFiYzAeFw0yNjEwMTgxOTMxNDlaFw0zNjEwMTUxOTMxNDlaMBkxFzAVBgNV"
+        "BAMMDmFuamF5LXRlc3QtYWJjMFkwEwYHKoZIzj0CAQYIKoZIzj0DAQcDQgAEXbAd"
+        "naL6InaqLtfBtxGLAcDkABM2zxW6FWK75qrDHSyqGAi9KZVPiwgjgWtZatoukrv1"
+        "D8XE/6O+RZ5xkqZ4B6NTMFEwHQYDVR0OBBYEFCPGXS74edZwhRf+5mQ7PiSI58B/"
+        "MB8GA1UdIwQYMBaAFCPGXS74edZwhRf+5mQ7PiSI58B/MA8GA1UdEwEB/wQFMAMB"
+        "Af8wCgYIKoZIzj0EAwIDSAAwRQIgW+Qv5/iG02qPVnX8kP5beIaML47I0M046eD0"
+        "23tO/b4CIQDWeM/NiJrvykquj1pQFcd68BMcNfLtPYmqQIURHzjS8g==\"";
+
+constexpr const char BAD_PADDING_PEM[] = "-----BEGIN X-----\n"
+                                         "MAA=A\n"
+                                         "-----END X-----\n";
+constexpr const char NOT_SEQUENCE_PEM[] = "BAEA";
+constexpr const char TRUNCATED_PEM[] = "MAMCAQ==";
+
+constexpr const char MIXED_CASE_HEX[] = "00 7f:80 Ab cD ff";
+
+std::vector<uint8_t> from_hex(const char *hex) {
+    std::vector<uint8_t> result;
+    for (; hex[0] && hex[1]; hex += 2) {
+        result.push_back((uint8_t) std::stoul(std::string(hex, 2), nullptr,
+                                               16));
+    }
+    return result;
+}
+
+template <typename Array>
+std::vector<uint8_t> as_vector(const Array &array) {
+    return std::vector<uint8_t>(array.begin(), array.end());
+}
+
+} // namespace
+
+HOST_TEST(chain_decodes_to_known_der) {
+    constexpr auto DER = pem2der<sizeof(CHAIN_PEM), CHAIN_PEM>();
+    HOST_CHECK_EQ(DER.size(), 374 + 376 + 372);
+    HOST_CHECK(as_vector(DER) == from_hex(CHAIN_DER_HEX));
+}
+
+HOST_TEST(quoted_base64_decodes_to_known_der) {
+    constexpr auto DER = pem2der<sizeof(QUOTED_BASE64), QUOTED_BASE64>();
+    const std::vector<uint8_t> chain = from_hex(CHAIN_DER_HEX);
+    HOST_CHECK(as_vector(DER)
+               == std::vector<uint8_t>(chain.begin() + 374,
+                                       chain.begin() + 374 + 376));
+}
+
+HOST_TEST(invalid_input_is_detected_by_scan) {
+    // pem2der() static_asserts these, so they can only be checked on the scan
+    constexpr PemScanResult BAD_PADDING =
+            scan_pem<sizeof(BAD_PADDING_PEM), BAD_PADDING_PEM>();
+    HOST_CHECK(!BAD_PADDING.padding_valid);
+    constexpr PemScanResult NOT_SEQUENCE =
+            scan_pem<sizeof(NOT_SEQUENCE_PEM), NOT_SEQUENCE_PEM>();
+    HOST_CHECK(NOT_SEQUENCE.padding_valid);
+    HOST_CHECK(!NOT_SEQUENCE.der_valid);
+    constexpr PemScanResult TRUNCATED =
+            scan_pem<sizeof(TRUNCATED_PEM), TRUNCATED_PEM>();
+    HOST_CHECK(TRUNCATED.padding_valid);
+    HOST_CHECK(!TRUNCATED.der_valid);
+    constexpr PemScanResult CHAIN = scan_pem<sizeof(CHAIN_PEM), CHAIN_PEM>();
+    HOST_CHECK(CHAIN.padding_valid);
+    HOST_CHECK(CHAIN.der_valid);
+}
+
+HOST_TEST(unhexlify_accepts_both_cases) {
+    constexpr auto BYTES = unhexlify<sizeof(MIXED_CASE_HEX), MIXED_CASE_HEX>();
+    HOST_CHECK(as_vector(BYTES)
+               == std::vector<uint8_t>({ 0x00, 0x7F, 0x80, 0xAB, 0xCD, 0xFF }));
+    constexpr auto DER = unhexlify<sizeof(CHAIN_DER_HEX), CHAIN_DER_HEX>();
+    HOST_CHECK(as_vector(DER) == from_hex(CHAIN_DER_HEX));
+}
+
+int main() {
+    return host_test_run_all();
+}
@@ -35,18 +35,16 @@
 #include <anjay/anjay.h>
 #include <avsystem/commons/avs_defs.h>
 #include <avsystem/commons/avs_list.h>
-#include <avsystem/commons/avs_log.h>
-#include <avsystem/commons/avs_memory.h>
 
 #include <mbed.h>
 
-#include <XNucleoIKS01A2.h>
-
+#include "app_log.h"
+#include "client_local.h"
 #include "humidity.h"
+#include "sensor_backend.h"
+#include "static_object_storage.h"
 
-#define HUMIDITY_OBJ_LOG(...) avs_log(humidity_obj, __VA_ARGS__)
-
-#define SENSOR_ID 0xBC
+#define HUMIDITY_OBJ_LOG(...) APP_LOG(humidity_obj, __VA_ARGS__)
 
 #define HUMIDITY_OID 3304
 
@@ -104,7 +102,7 @@
 
 typedef struct humidity_struct {
     const anjay_dm_object_def_t *def;
-    HTS221Sensor *sensor;
+    SensorBackend *sensors;
     float min_value;
     float max_value;
     float curr_value;
@@ -248,23 +246,24 @@ struct ObjDef : public anjay_dm_object_def_t {
     }
 } const OBJ_DEF;
 
+CLIENT_LOCAL StaticObjectStorage<humidity_t> OBJ_STORAGE;
+
 const anjay_dm_object_def_t **humidity_object_create(void) {
-    HTS221Sensor *sensor = XNucleoIKS01A2::instance(D14, D15)->ht_sensor;
-    uint8_t id = 0;
+    SensorBackend &sensors = sensor_backend();
     float sensor_value;
-    if (sensor->read_id(&id) || id != SENSOR_ID || sensor->enable()
-        || sensor->get_humidity(&sensor_value)) {
+    if (sensors.enable(SensorType::HUMIDITY)
+        || sensors.read_scalar(SensorType::HUMIDITY, &sensor_value)) {
         HUMIDITY_OBJ_LOG(WARNING, "Failed to initialize humidity sensor");
         return NULL;
     }
 
-    humidity_t *obj = (humidity_t *) avs_calloc(1, sizeof(humidity_t));
+    humidity_t *obj = OBJ_STORAGE.construct();
     if (!obj) {
-        (void) sensor->disable();
+        (void) sensors.disable(SensorType::HUMIDITY);
         return NULL;
     }
     obj->def = &OBJ_DEF;
-    obj->sensor = sensor;
+    obj->sensors = &sensors;
     obj->curr_value = sensor_value;
     reset_min_max_values(obj);
 
@@ -273,12 +272,11 @@ const anjay_dm_object_def_t **humidity_object_create(void) {
 
 void humidity_object_release(const anjay_dm_object_def_t **def) {
     if (def) {
-        humidity_t *obj = get_obj(def);
-        avs_free(obj);
+        OBJ_STORAGE.destroy();
     }
 }
 
-const anjay_dm_object_def_t **OBJ_DEF_PTR;
+CLIENT_LOCAL const anjay_dm_object_def_t **OBJ_DEF_PTR;
 
 } // namespace
 
@@ -313,7 +311,7 @@ void humidity_object_update(anjay_t *anjay) {
     humidity_t *obj = get_obj(OBJ_DEF_PTR);
 
     float value;
-    if (obj->sensor->get_humidity(&value)) {
+    if (obj->sensors->read_scalar(SensorType::HUMIDITY, &value)) {
         HUMIDITY_OBJ_LOG(ERROR, "Failed to get humidity");
         return;
     }
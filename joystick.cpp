@@ -31,14 +31,16 @@
 #include <anjay/anjay.h>
 #include <avsystem/commons/avs_defs.h>
 #include <avsystem/commons/avs_list.h>
-#include <avsystem/commons/avs_log.h>
-#include <avsystem/commons/avs_memory.h>
 
 #include <mbed.h>
 
+#include "app_log.h"
+#include "client_local.h"
+#include "static_object_storage.h"
+
 #ifdef TARGET_DISCO_L496AG
 
-#define JOYSTICK_OBJ_LOG(...) avs_log(joystick_obj, __VA_ARGS__)
+#define JOYSTICK_OBJ_LOG(...) APP_LOG(joystick_obj, __VA_ARGS__)
 
 /**
  * Digital Input State: R, Single, Optional
@@ -144,6 +146,14 @@ typedef struct multiple_axis_joystick_struct {
     int last_y_value;
     int last_counter_value;
     bool last_pressed;
+
+    explicit multiple_axis_joystick_struct(const anjay_dm_object_def_t *def)
+            : def(def),
+              joystick(BUTTON1, PI_9, PF_11, PI_8, PI_10),
+              last_x_value(),
+              last_y_value(),
+              last_counter_value(),
+              last_pressed() {}
 } multiple_axis_joystick_t;
 
 static inline multiple_axis_joystick_t *
@@ -245,27 +255,23 @@ struct ObjDef : public anjay_dm_object_def_t {
     }
 } const OBJ_DEF;
 
+CLIENT_LOCAL StaticObjectStorage<multiple_axis_joystick_t> OBJ_STORAGE;
+
 const anjay_dm_object_def_t **multiple_axis_joystick_object_create(void) {
-    multiple_axis_joystick_t *obj = (multiple_axis_joystick_t *) avs_calloc(
-            1, sizeof(multiple_axis_joystick_t));
+    multiple_axis_joystick_t *obj = OBJ_STORAGE.construct(&OBJ_DEF);
     if (!obj) {
         return NULL;
     }
-    obj->def = &OBJ_DEF;
-
-    new (&obj->joystick) Joystick(BUTTON1, PI_9, PF_11, PI_8, PI_10);
     return &obj->def;
 }
 
 void multiple_axis_joystick_object_release(const anjay_dm_object_def_t **def) {
     if (def) {
-        multiple_axis_joystick_t *obj = get_obj(def);
-        obj->joystick.~Joystick();
-        avs_free(obj);
+        OBJ_STORAGE.destroy();
     }
 }
 
-const anjay_dm_object_def_t **OBJ_DEF_PTR;
+CLIENT_LOCAL const anjay_dm_object_def_t **OBJ_DEF_PTR;
 
 } // namespace
 
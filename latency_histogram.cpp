@@ -0,0 +1,160 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "latency_histogram.h"
+
+#include <assert.h>
+#include <cstdio>
+#include <cstring>
+
+#include <mbed.h>
+
+#ifndef __MBED__
+#include <chrono>
+#endif // __MBED__
+
+#include "app_log.h"
+
+#if defined(__MBED__) && defined(DWT) && defined(__CORTEX_M) \
+        && __CORTEX_M >= 3
+#define LATENCY_WITH_DWT 1
+#endif
+
+namespace {
+
+rtos::Mutex HISTOGRAMS_MUTEX;
+LatencyHistogram HISTOGRAMS[LATENCY_HISTOGRAM_COUNT] = {
+    LatencyHistogram("event_loop_lag"), LatencyHistogram("periodic_update"),
+    LatencyHistogram("sms_serve"), LatencyHistogram("persistence"),
+    LatencyHistogram("socket_serve"), LatencyHistogram("sched_run")
+};
+
+size_t histogram_index(LatencyHistogramId id) {
+    const size_t index = static_cast<size_t>(id);
+    assert(index < LATENCY_HISTOGRAM_COUNT);
+    return index;
+}
+
+size_t bucket_index(uint32_t duration_us) {
+    if (!duration_us) {
+        return 0;
+    }
+    const size_t index = 32 - __builtin_clz(duration_us);
+    return index < LatencyHistogram::BUCKET_COUNT
+                   ? index
+                   : LatencyHistogram::BUCKET_COUNT - 1;
+}
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram(const char *name)
+        : name_(name), count_(0), max_us_(0), buckets_() {}
+
+void LatencyHistogram::record_us(uint32_t duration_us) {
+    uint16_t &bucket = buckets_[bucket_index(duration_us)];
+    if (bucket < UINT16_MAX) {
+        ++bucket;
+    }
+    if (count_ < UINT32_MAX) {
+        ++count_;
+    }
+    if (duration_us > max_us_) {
+        max_us_ = duration_us;
+    }
+}
+
+void LatencyHistogram::reset() {
+    count_ = 0;
+    max_us_ = 0;
+    memset(buckets_, 0, sizeof(buckets_));
+}
+
+int LatencyHistogram::format(char *buf, size_t buf_size) const {
+    size_t used_buckets = BUCKET_COUNT;
+    while (used_buckets > 0 && !buckets_[used_buckets - 1]) {
+        --used_buckets;
+    }
+
+    int result = snprintf(buf, buf_size, "%lu;%lu;", (unsigned long) count_,
+                          (unsigned long) max_us_);
+    for (size_t i = 0; result >= 0 && i < used_buckets; ++i) {
+        const size_t offset = (size_t) result < buf_size ? result : buf_size;
+        const int written = snprintf(buf + offset, buf_size - offset, "%s%u",
+                                     i ? "," : "", (unsigned) buckets_[i]);
+        result = written < 0 ? written : result + written;
+    }
+    return result;
+}
+
+void latency_histogram_record_us(LatencyHistogramId id, uint32_t duration_us) {
+    ScopedMutexLock lock(HISTOGRAMS_MUTEX);
+    HISTOGRAMS[histogram_index(id)].record_us(duration_us);
+}
+
+LatencyHistogram latency_histogram_snapshot(LatencyHistogramId id) {
+    ScopedMutexLock lock(HISTOGRAMS_MUTEX);
+    return HISTOGRAMS[histogram_index(id)];
+}
+
+void latency_histograms_reset() {
+    ScopedMutexLock lock(HISTOGRAMS_MUTEX);
+    for (LatencyHistogram &histogram : HISTOGRAMS) {
+        histogram.reset();
+    }
+}
+
+void latency_histograms_log() {
+    APP_LOG(latency, INFO, "Latency histograms (count;max us;log2 buckets):");
+    for (size_t i = 0; i < LATENCY_HISTOGRAM_COUNT; ++i) {
+        // Formatted and logged without holding the mutex
+        const LatencyHistogram histogram =
+                latency_histogram_snapshot(static_cast<LatencyHistogramId>(i));
+        char buf[160];
+        histogram.format(buf, sizeof(buf));
+        APP_LOG(latency, INFO, "- %s: %s", histogram.name(), buf);
+    }
+}
+
+uint32_t latency_timestamp() {
+#if defined(LATENCY_WITH_DWT)
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    return DWT->CYCCNT;
+#elif defined(__MBED__)
+    // Unlike us_ticker_read(), scaled to microseconds and extended to 64 bits
+    // regardless of the frequency and width of the hardware ticker
+    return (uint32_t) ticker_read_us(get_us_ticker_data());
+#else
+    return (uint32_t) std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+#endif
+}
+
+uint32_t latency_elapsed_us(uint32_t start) {
+    // Unsigned arithmetic handles a single wrap-around of the timer
+    const uint32_t elapsed = latency_timestamp() - start;
+#if defined(LATENCY_WITH_DWT)
+    // The cycle counter does not count while the core is sleeping, which
+    // does not matter for measuring how long the CPU is busy
+    return (uint32_t) ((uint64_t) elapsed * 1000000 / SystemCoreClock);
+#else
+    return elapsed;
+#endif
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Histogram of durations with logarithmic buckets: bucket 0 counts zero
+ * durations and bucket i counts durations in [2^(i-1), 2^i) microseconds;
+ * the last bucket also counts all longer ones. Counters saturate instead of
+ * wrapping around.
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t BUCKET_COUNT = 24;
+
+    explicit LatencyHistogram(const char *name);
+
+    void record_us(uint32_t duration_us);
+    void reset();
+
+    const char *name() const {
+        return name_;
+    }
+
+    uint32_t count() const {
+        return count_;
+    }
+
+    uint32_t max_us() const {
+        return max_us_;
+    }
+
+    uint16_t bucket(size_t index) const {
+        return buckets_[index];
+    }
+
+    /**
+     * Formats the histogram as "<count>;<max>;<b0>,<b1>,...", with trailing
+     * empty buckets omitted.
+     *
+     * @returns Value returned by snprintf().
+     */
+    int format(char *buf, size_t buf_size) const;
+
+private:
+    const char *name_;
+    uint32_t count_;
+    uint32_t max_us_;
+    uint16_t buckets_[BUCKET_COUNT];
+};
+
+enum class LatencyHistogramId {
+    // How late the event loop wakes up for scheduled jobs
+    EVENT_LOOP_LAG,
+    PERIODIC_UPDATE,
+    SMS_SERVE,
+    PERSISTENCE,
+    // anjay_serve() of a single socket
+    SOCKET_SERVE,
+    // anjay_sched_run(), i.e. all the jobs due at the same time
+    SCHED_RUN
+};
+
+constexpr size_t LATENCY_HISTOGRAM_COUNT = 6;
+
+/**
+ * The histograms are guarded by a mutex, so the functions below may be
+ * called from any thread.
+ */
+void latency_histogram_record_us(LatencyHistogramId id, uint32_t duration_us);
+
+/**
+ * @returns Copy of the histogram, taken with the mutex held.
+ */
+LatencyHistogram latency_histogram_snapshot(LatencyHistogramId id);
+
+void latency_histograms_reset();
+
+void latency_histograms_log();
+
+/**
+ * @returns Current value of a free-running high resolution timer: the DWT
+ *          cycle counter on Cortex-M cores that have one, the microsecond
+ *          ticker on other targets, and std::chrono::steady_clock on host.
+ */
+uint32_t latency_timestamp();
+
+/**
+ * @returns Time elapsed since @p start, obtained from latency_timestamp(),
+ *          in microseconds.
+ */
+uint32_t latency_elapsed_us(uint32_t start);
+
+/**
+ * Records time elapsed from construction to destruction in a histogram.
+ */
+class LatencyScope {
+    LatencyHistogramId id_;
+    uint32_t start_;
+
+    LatencyScope(const LatencyScope &) = delete;
+    LatencyScope &operator=(const LatencyScope &) = delete;
+
+public:
+    explicit LatencyScope(LatencyHistogramId id)
+            : id_(id), start_(latency_timestamp()) {}
+
+    ~LatencyScope() {
+        latency_histogram_record_us(id_, latency_elapsed_us(start_));
+    }
+};
+
+#endif // LATENCY_HISTOGRAM_H
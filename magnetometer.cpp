@@ -32,17 +32,16 @@
 #include <anjay/anjay.h>
 #include <avsystem/commons/avs_defs.h>
 #include <avsystem/commons/avs_list_cxx.hpp>
-#include <avsystem/commons/avs_log.h>
 
 #include <mbed.h>
 
-#include <XNucleoIKS01A2.h>
-
+#include "app_log.h"
+#include "client_local.h"
 #include "magnetometer.h"
+#include "sensor_backend.h"
+#include "static_object_storage.h"
 
-#define MAGNETOMETER_OBJ_LOG(...) avs_log(magnetometer_obj, __VA_ARGS__)
-
-#define SENSOR_ID LSM303AGR_MAG_WHO_AM_I
+#define MAGNETOMETER_OBJ_LOG(...) APP_LOG(magnetometer_obj, __VA_ARGS__)
 
 using namespace std;
 
@@ -84,7 +83,7 @@ constexpr double VALUE_SCALE = 1e-7;
 struct MagnetometerObject {
     const anjay_dm_object_def_t *const def;
 
-    LSM303AGRMagSensor *sensor;
+    SensorBackend *sensors;
 
     int32_t x_value;
     int32_t y_value;
@@ -171,22 +170,22 @@ MagnetometerObject::MagnetometerObject() : def(&OBJ_DEF) {}
 
 MagnetometerObject::~MagnetometerObject() {}
 
+CLIENT_LOCAL StaticObjectStorage<MagnetometerObject> OBJ_STORAGE;
+
 const anjay_dm_object_def_t **magnetometer_object_create(void) {
-    LSM303AGRMagSensor *sensor =
-            XNucleoIKS01A2::instance(D14, D15)->magnetometer;
-    uint8_t id = 0;
+    SensorBackend &sensors = sensor_backend();
     int32_t sensor_value[3];
-    if (sensor->read_id(&id) || id != SENSOR_ID || sensor->enable()
-        || sensor->get_m_axes(sensor_value)) {
+    if (sensors.enable(SensorType::MAGNETOMETER)
+        || sensors.read_axes(SensorType::MAGNETOMETER, sensor_value)) {
         MAGNETOMETER_OBJ_LOG(WARNING, "Failed to initialize magnetometer");
         return NULL;
     }
 
-    MagnetometerObject *obj = new (nothrow) MagnetometerObject;
+    MagnetometerObject *obj = OBJ_STORAGE.construct();
     if (!obj) {
         return NULL;
     }
-    obj->sensor = sensor;
+    obj->sensors = &sensors;
     obj->x_value = sensor_value[0];
     obj->y_value = sensor_value[1];
     obj->z_value = sensor_value[2];
@@ -196,11 +195,11 @@ const anjay_dm_object_def_t **magnetometer_object_create(void) {
 
 void magnetometer_object_release(const anjay_dm_object_def_t **def) {
     if (def) {
-        delete get_obj(def);
+        OBJ_STORAGE.destroy();
     }
 }
 
-const anjay_dm_object_def_t **OBJ_DEF_PTR;
+CLIENT_LOCAL const anjay_dm_object_def_t **OBJ_DEF_PTR;
 
 } // namespace
 
@@ -237,7 +236,7 @@ void magnetometer_object_update(anjay_t *anjay) {
     MagnetometerObject *obj = get_obj(OBJ_DEF_PTR);
 
     int32_t value[3];
-    if (obj->sensor->get_m_axes(value)) {
+    if (obj->sensors->read_axes(SensorType::MAGNETOMETER, value)) {
         MAGNETOMETER_OBJ_LOG(ERROR, "Failed to get magnetometer values");
         return;
     }
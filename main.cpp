@@ -21,15 +21,20 @@
 #include "CellularContext.h"
 #include "CellularDevice.h"
 #include "QUECTEL_BG96.h"
+#include "app_log.h"
 #include "avs_socket_global.h"
-#include "conn_monitoring_object.h"
+#include "boot_timing.h"
+#include "coap_params.h"
+#include "connection_manager.h"
+#include "deferred_log.h"
 #include "device_config_serial_menu.h"
-#include "device_object.h"
-#ifdef MBED_CLOUD_CLIENT_FOTA_ENABLE
-#include "fw_update.h"
-#endif // MBED_CLOUD_CLIENT_FOTA_ENABLE
+#include "event_loop.h"
+#include "latency_histogram.h"
+#include "object_registry.h"
 #include "persistence.h"
+#include "runtime_stats.h"
 #include "sms_driver.h"
+#include "wakeup_stats.h"
 #include <EthernetInterface.h>
 #include <anjay/access_control.h>
 #include <anjay/anjay.h>
@@ -44,19 +49,19 @@
 #include <mbed_trace.h>
 #include <memory>
 
-#include "joystick.h" // gets activated with TARGET_DISCO_L496AG
-
-#include "accelerometer.h" // Gets activated with SENSORS_IKS01A2 == 1
-#include "barometer.h"
-#include "humidity.h"
-#include "magnetometer.h"
-
 #include "default_config.h"
 
 #if defined(ANJAY_WITH_SMS) && MBED_CONF_CELLULAR_USE_SMS
 #define WITH_SMS 1
 #endif // ANJAY_WITH_SMS && MBED_CONF_CELLULAR_USE_SMS
 
+#if (MBED_MEM_TRACING_ENABLED                                 \
+     || (MBED_STACK_STATS_ENABLED && MBED_HEAP_STATS_ENABLED) \
+     || (MBED_MEM_TRACING_ENABLED && MBED_HEAP_STATS_ENABLED)) \
+        && MBED_CONF_APP_STATS_LOG_PERIOD_MS > 0
+#define WITH_STATS_LOG 1
+#endif // (MBED_MEM_TRACING_ENABLED || ...) && STATS_LOG_PERIOD_MS > 0
+
 namespace {
 
 #ifdef WITH_SMS
@@ -66,21 +71,28 @@ struct ServeSmsArgs {
 };
 
 void serve_sms(avs_sched_t *sched, const void *args_) {
+    WakeupScope wakeup(WakeupCause::SMS);
     const ServeSmsArgs *args = reinterpret_cast<const ServeSmsArgs *>(args_);
+    (void) sched;
 
     for (const auto &it : avs::ListView<const anjay_socket_entry_t>(
                  anjay_get_socket_entries(args->anjay))) {
         if (it.transport == ANJAY_SOCKET_TRANSPORT_SMS) {
             if (nrf_smsdrv_has_unread(args->smsdrv)) {
+                LatencyScope latency(LatencyHistogramId::SMS_SERVE);
                 anjay_serve(args->anjay, it.socket);
             }
             break;
         }
     }
+}
 
-    AVS_SCHED_DELAYED(sched, nullptr,
-                      avs_time_duration_from_scalar(1, AVS_TIME_S), serve_sms,
-                      args, sizeof(*args));
+// Called from the cellular stack context when the modem reports a new SMS.
+// Anjay's scheduler is thread-safe, so the SMS is handled by the LwM2M thread
+// the next time its event loop wakes up, instead of polling the modem.
+void on_sms_received(ServeSmsArgs *args) {
+    AVS_SCHED_NOW(anjay_get_scheduler(args->anjay), nullptr, serve_sms, args,
+                  sizeof(*args));
 }
 #endif // WITH_SMS
 
@@ -89,6 +101,7 @@ void serve_sms(avs_sched_t *sched, const void *args_) {
 // mbed-os/platform/Callback.h)
 CellularNetwork *NETWORK;
 Lwm2mConfig SERIAL_MENU_CONFIG;
+ConnectionManager CONNECTION_MANAGER;
 
 #if MBED_CONF_APP_WITH_EST
 constexpr const char client_pub_cert_pem[] =
@@ -147,7 +160,7 @@ int configure_servers_from_config(anjay_t *anjay) {
                         ANJAY_SSID_BOOTSTRAP);
         if ((result = anjay_security_object_add_instance(anjay, &bs_instance,
                                                          &bs_instance_iid))) {
-            avs_log(lwm2m, ERROR,
+            APP_LOG(lwm2m, ERROR,
                     "could not add bootstrap server security instance");
             return result;
         }
@@ -160,7 +173,7 @@ int configure_servers_from_config(anjay_t *anjay) {
                 SERIAL_MENU_CONFIG.rg_server_config.as_security_instance(1);
         if ((result = anjay_security_object_add_instance(anjay, &rg_instance,
                                                          &rg_instance_iid))) {
-            avs_log(lwm2m, ERROR,
+            APP_LOG(lwm2m, ERROR,
                     "could not add regular server security instance");
             return result;
         }
@@ -171,15 +184,20 @@ int configure_servers_from_config(anjay_t *anjay) {
         anjay_server_instance_t server_instance;
         memset(&server_instance, 0, sizeof(server_instance));
         server_instance.ssid = 1;
-        server_instance.lifetime = 50;
         server_instance.default_min_period = -1;
         server_instance.default_max_period = -1;
         server_instance.disable_timeout = -1;
-        server_instance.binding = "U";
+        if (SERIAL_MENU_CONFIG.queue_mode_enabled) {
+            server_instance.lifetime = MBED_CONF_APP_QUEUE_MODE_LIFETIME_S;
+            server_instance.binding = "UQ";
+        } else {
+            server_instance.lifetime = 50;
+            server_instance.binding = "U";
+        }
         server_instance.notification_storing = false;
         if ((result = anjay_server_object_add_instance(anjay, &server_instance,
                                                        &server_instance_iid))) {
-            avs_log(lwm2m, ERROR, "could not install server object");
+            APP_LOG(lwm2m, ERROR, "could not install server object");
             return result;
         }
     }
@@ -188,14 +206,38 @@ int configure_servers_from_config(anjay_t *anjay) {
 }
 #endif // MBED_CONF_APP_WITH_EST
 
+// Set while the device configuration menu may be shown, so that messages
+// from the network bring-up running in the background do not clutter it
+bool CONSOLE_QUIET;
+
+// Messages are printed by a low-priority thread, so that logging does not
+// stall the calling thread until the UART transmission finishes
 void log_handler(avs_log_level_t level,
                  const char *module,
                  const char *message) {
-    (void) level;
     (void) module;
-    printf("%s\n", message);
+    if (level < AVS_LOG_ERROR && core_util_atomic_load_bool(&CONSOLE_QUIET)) {
+        return;
+    }
+    deferred_log_write(level, message);
 }
 
+class QuietConsole {
+    uint8_t trace_config_;
+
+public:
+    QuietConsole() : trace_config_(mbed_trace_config_get()) {
+        mbed_trace_config_set((trace_config_ & ~TRACE_MASK_LEVEL)
+                              | TRACE_ACTIVE_LEVEL_NONE);
+        core_util_atomic_store_bool(&CONSOLE_QUIET, true);
+    }
+
+    ~QuietConsole() {
+        core_util_atomic_store_bool(&CONSOLE_QUIET, false);
+        mbed_trace_config_set(trace_config_);
+    }
+};
+
 #if !MBED_CONF_APP_WITH_EST
 const char *try_get_modem_imei() {
     static char imei_buf[32] = "";
@@ -218,7 +260,7 @@ const char *try_get_modem_imei() {
     at->unlock();
 
     if (result < 0) {
-        avs_log(modem_bg96, WARNING, "unable to get IMEI: %d",
+        APP_LOG(modem_bg96, WARNING, "unable to get IMEI: %d",
                 (int) at->get_last_error());
         return nullptr;
     }
@@ -253,41 +295,161 @@ const char *get_endpoint_name() {
     return DEFAULT_ENDPOINT_NAME;
 }
 
-void periodic_update(avs_sched_t *sched, const void *anjay_ptr) {
-    anjay_t *anjay = *(anjay_t *const *) anjay_ptr;
+// Lets Anjay wait for the network instead of failing all the connections
+// and being restarted from scratch when the link is lost
+void update_transport_state(anjay_t *anjay) {
+    const bool link_up = CONNECTION_MANAGER.link_up();
+    if (link_up == anjay_transport_is_offline(anjay, ANJAY_TRANSPORT_SET_IP)) {
+        if (link_up) {
+            APP_LOG(lwm2m, INFO, "network is back, resuming");
+            anjay_transport_exit_offline(anjay, ANJAY_TRANSPORT_SET_IP);
+        } else {
+            APP_LOG(lwm2m, INFO, "network lost, pausing");
+            anjay_transport_enter_offline(anjay, ANJAY_TRANSPORT_SET_IP);
+        }
+    }
+}
+
+void update_transport_state_job(avs_sched_t *sched, const void *anjay_ptr) {
+    (void) sched;
+    update_transport_state(*(anjay_t *const *) anjay_ptr);
+}
+
+// Anjay instance of the LwM2M thread, if any, to which link changes are
+// reported; the instance is replaced whenever the client is restarted
+Mutex LWM2M_ANJAY_MUTEX;
+anjay_t *LWM2M_ANJAY;
+
+void set_lwm2m_anjay(anjay_t *anjay) {
+    ScopedMutexLock lock(LWM2M_ANJAY_MUTEX);
+    LWM2M_ANJAY = anjay;
+}
+
+void log_network_addresses(NetworkInterface *netif) {
+    // Print IP address and MAC address, quite useful in troubleshooting
+    SocketAddress sa;
+    nsapi_error_t err = netif->get_ip_address(&sa);
+    if (err != NSAPI_ERROR_OK) {
+        APP_LOG(network, WARNING, "get_ip_address() - failed, status %d", err);
+    } else {
+        APP_LOG(network, INFO, "IP: %s",
+                (sa.get_ip_address() ? sa.get_ip_address() : "None"));
+        APP_LOG(network, INFO, "MAC address: %s",
+                (netif->get_mac_address() ? netif->get_mac_address()
+                                          : "None"));
+    }
+}
+
+// Called by CONNECTION_MANAGER from the shared event queue. Anjay is only
+// used by the LwM2M thread, so the transports are switched from a job run
+// there; the scheduler is thread-safe.
+void on_link_change(bool up) {
+    if (up) {
+        log_network_addresses(NetworkInterface::get_default_instance());
+        boot_timing_mark(BootPhase::NETWORK_UP);
+    }
+    ScopedMutexLock lock(LWM2M_ANJAY_MUTEX);
+    if (LWM2M_ANJAY) {
+        AVS_SCHED_NOW(anjay_get_scheduler(LWM2M_ANJAY), nullptr,
+                      update_transport_state_job, &LWM2M_ANJAY,
+                      sizeof(LWM2M_ANJAY));
+    }
+}
+
+#ifdef WITH_STATS_LOG
+// Time at which the runtime statistics are to be logged next
+avs_time_monotonic_t NEXT_STATS_LOG_TIME;
+
+// Checked from periodic_update(), so that logging the statistics never wakes
+// the MCU up on its own
+bool stats_log_due() {
+    const avs_time_monotonic_t now = avs_time_monotonic_now();
+    if (avs_time_monotonic_valid(NEXT_STATS_LOG_TIME)
+        && avs_time_monotonic_before(now, NEXT_STATS_LOG_TIME)) {
+        return false;
+    }
+    NEXT_STATS_LOG_TIME = avs_time_monotonic_add(
+            now, avs_time_duration_from_scalar(
+                         MBED_CONF_APP_STATS_LOG_PERIOD_MS, AVS_TIME_MS));
+    return true;
+}
+#endif // WITH_STATS_LOG
+
+// Time at which periodic_update() is expected to run next; used to measure
+// how late the event loop runs scheduled jobs
+avs_time_monotonic_t NEXT_UPDATE_TIME;
+
+struct PeriodicUpdateArgs {
+    anjay_t *anjay;
+    EventLoop *event_loop;
+};
+
+void periodic_update(avs_sched_t *sched, const void *args_) {
+    WakeupScope wakeup(WakeupCause::PERIODIC_UPDATE);
+    const PeriodicUpdateArgs *args = (const PeriodicUpdateArgs *) args_;
+    anjay_t *anjay = args->anjay;
+
+    LatencyScope latency(LatencyHistogramId::PERIODIC_UPDATE);
+    if (avs_time_monotonic_valid(NEXT_UPDATE_TIME)) {
+        const avs_time_duration_t lag = avs_time_monotonic_diff(
+                avs_time_monotonic_now(), NEXT_UPDATE_TIME);
+        runtime_stats_record_event_loop_lag(lag);
+    }
+
+#ifdef WITH_STATS_LOG
+    const bool log_stats = stats_log_due();
+#else  // WITH_STATS_LOG
+    const bool log_stats = false;
+#endif // WITH_STATS_LOG
+    // Sampled regardless of logging, as the statistics are also exposed by the
+    // System Health object, updated right below
+    runtime_stats_sample(log_stats);
+    object_registry_update(anjay);
+#ifdef WITH_STATS_LOG
+    if (log_stats) {
+        wakeup_stats_log();
+        latency_histograms_log();
+    }
+#endif // WITH_STATS_LOG
 
-    device_object_update(anjay);
-    humidity_object_update(anjay);
-    barometer_object_update(anjay);
-    joystick_object_update(anjay);
-    magnetometer_object_update(anjay);
-    accelerometer_object_update(anjay);
+    if (!anjay_ongoing_registration_exists(anjay)
+        && !anjay_all_connections_failed(anjay)
+        && anjay_get_socket_entries(anjay)) {
+        boot_timing_mark(BootPhase::REGISTERED);
+    }
 
     if (anjay_all_connections_failed(anjay)) {
-        anjay_event_loop_interrupt(anjay);
+        args->event_loop->interrupt();
     } else {
-        AVS_SCHED_DELAYED(sched, nullptr,
-                          avs_time_duration_from_scalar(1, AVS_TIME_S),
-                          periodic_update, &anjay, sizeof(anjay));
+        const avs_time_duration_t delay =
+                object_registry_next_update_delay(anjay);
+        NEXT_UPDATE_TIME =
+                avs_time_monotonic_add(avs_time_monotonic_now(), delay);
+        AVS_SCHED_DELAYED(sched, nullptr, delay, periodic_update, args,
+                          sizeof(*args));
     }
 
-    if (SERIAL_MENU_CONFIG.persistence_enabled
-        && persist_anjay_if_required(anjay)) {
-        avs_log(lwm2m, ERROR, "couldn't persist Anjay's state");
+    if (SERIAL_MENU_CONFIG.persistence_enabled) {
+        LatencyScope persistence_latency(LatencyHistogramId::PERSISTENCE);
+        if (persist_anjay_if_required(anjay)) {
+            APP_LOG(lwm2m, ERROR, "couldn't persist Anjay's state");
+        }
     }
 }
 
 void lwm2m_serve() {
-    avs_log(lwm2m, INFO, "lwm2m_task starting up");
+    APP_LOG(lwm2m, INFO, "lwm2m_task starting up");
 
     while (true) {
         anjay_configuration_t CONFIG;
         memset(&CONFIG, 0, sizeof(CONFIG));
         CONFIG.endpoint_name = get_endpoint_name();
-        CONFIG.in_buffer_size = 1024;
-        CONFIG.out_buffer_size = 1024;
-        CONFIG.msg_cache_size = 2048;
+        CONFIG.in_buffer_size = MBED_CONF_APP_COAP_IN_BUFFER_SIZE;
+        CONFIG.out_buffer_size = MBED_CONF_APP_COAP_OUT_BUFFER_SIZE;
+        CONFIG.msg_cache_size = MBED_CONF_APP_COAP_MSG_CACHE_SIZE;
         CONFIG.disable_legacy_server_initiated_bootstrap = true;
+        const avs_coap_udp_tx_params_t tx_params = coap_udp_tx_params();
+        CONFIG.udp_tx_params = &tx_params;
 #ifdef ANJAY_WITH_LWM2M11
         anjay_lwm2m_version_config_t version_config = {
             .minimum_version = ANJAY_LWM2M_VERSION_1_0,
@@ -306,11 +468,16 @@ void lwm2m_serve() {
         }
 #endif // WITH_SMS
 
-        avs_log(lwm2m, INFO, "endpoint name: %s", CONFIG.endpoint_name);
+        APP_LOG(lwm2m, INFO, "endpoint name: %s", CONFIG.endpoint_name);
+        APP_LOG(lwm2m, INFO,
+                "CoAP buffers: in %u B, out %u B, message cache %u B",
+                (unsigned) CONFIG.in_buffer_size,
+                (unsigned) CONFIG.out_buffer_size,
+                (unsigned) CONFIG.msg_cache_size);
         anjay_t *anjay = anjay_new(&CONFIG);
 
         if (!anjay) {
-            avs_log(lwm2m, ERROR, "could not create anjay object");
+            APP_LOG(lwm2m, ERROR, "could not create anjay object");
             goto finish;
         }
 
@@ -319,7 +486,7 @@ void lwm2m_serve() {
             // Access Control object is necessary if Server Object with many
             // servers is loaded
             || anjay_access_control_install(anjay)) {
-            avs_log(lwm2m, ERROR, "cannot install core objects");
+            APP_LOG(lwm2m, ERROR, "cannot install core objects");
         }
 
         if ((!SERIAL_MENU_CONFIG.persistence_enabled
@@ -331,134 +498,65 @@ void lwm2m_serve() {
             configure_servers_from_config(anjay)
 #endif // MBED_CONF_APP_WITH_EST
         ) {
-            avs_log(lwm2m, ERROR, "cannot configure servers");
+            APP_LOG(lwm2m, ERROR, "cannot configure servers");
             goto finish;
         }
 
-        if (device_object_install(anjay)
-#ifdef MBED_CLOUD_CLIENT_FOTA_ENABLE
-            || fw_update_object_install(anjay)
-#endif // MBED_CLOUD_CLIENT_FOTA_ENABLE
-            || joystick_object_install(anjay) || humidity_object_install(anjay)
-            || barometer_object_install(anjay)
-            || magnetometer_object_install(anjay)
-            || accelerometer_object_install(anjay)) {
-            avs_log(lwm2m, ERROR, "cannot register data model objects");
+        if (object_registry_install(anjay, NETWORK)) {
+            APP_LOG(lwm2m, ERROR, "cannot register data model objects");
             goto finish;
         }
 
-        if (NETWORK) {
-            if (auto *ctx = CellularContext::get_default_instance()) {
-                if (conn_monitoring_object_install(anjay, ctx, NETWORK)) {
-                    avs_log(lwm2m, ERROR, "cannot register data model objects");
-                    goto finish;
-                }
-            }
-        }
+        // Transports start offline if the network is not up yet, and follow
+        // the link from then on, instead of failing the connections
+        set_lwm2m_anjay(anjay);
+        update_transport_state(anjay);
 
-        periodic_update(anjay_get_scheduler(anjay), &anjay);
 #ifdef WITH_SMS
         ServeSmsArgs serve_sms_args;
-        serve_sms_args.anjay = anjay;
-        serve_sms_args.smsdrv = CONFIG.sms_driver;
-        serve_sms(anjay_get_scheduler(anjay), &serve_sms_args);
+#endif // WITH_SMS
+        {
+            // The event loop sleeps until the next scheduled job or incoming
+            // packet; the maximum wait only bounds the latency of jobs
+            // scheduled from other threads
+            EventLoop event_loop(anjay, MBED_CONF_APP_EVENT_LOOP_MAX_WAIT_MS);
+
+            NEXT_UPDATE_TIME = AVS_TIME_MONOTONIC_INVALID;
+            const PeriodicUpdateArgs update_args = { anjay, &event_loop };
+            periodic_update(anjay_get_scheduler(anjay), &update_args);
+#ifdef WITH_SMS
+            serve_sms_args.anjay = anjay;
+            serve_sms_args.smsdrv = CONFIG.sms_driver;
+            // Handle messages received before the client started
+            serve_sms(anjay_get_scheduler(anjay), &serve_sms_args);
+            if (CONFIG.sms_driver) {
+                nrf_smsdrv_set_receive_callback(
+                        CONFIG.sms_driver,
+                        callback(on_sms_received, &serve_sms_args));
+            }
 #endif // WITH_SMS
 
-        anjay_event_loop_run(anjay,
-                             avs_time_duration_from_scalar(100, AVS_TIME_MS));
-        avs_log(lwm2m, ERROR, "lwm2m_task finished unexpectedly");
+            event_loop.run();
+        }
+        APP_LOG(lwm2m, ERROR, "lwm2m_task finished unexpectedly");
 
     finish:
         if (anjay) {
-            conn_monitoring_object_uninstall(anjay);
-            device_object_uninstall(anjay);
-            joystick_object_uninstall(anjay);
-            humidity_object_uninstall(anjay);
-            barometer_object_uninstall(anjay);
-            magnetometer_object_uninstall(anjay);
-            accelerometer_object_uninstall(anjay);
+#ifdef WITH_SMS
+            if (CONFIG.sms_driver) {
+                nrf_smsdrv_set_receive_callback(CONFIG.sms_driver, nullptr);
+            }
+#endif // WITH_SMS
+            set_lwm2m_anjay(nullptr);
+            object_registry_uninstall(anjay);
             anjay_delete(anjay);
         }
 
-        avs_log(lwm2m, ERROR, "resetting to factory defaults after 30s");
+        APP_LOG(lwm2m, ERROR, "resetting to factory defaults after 30s");
         ThisThread::sleep_for(30s);
     }
 }
 
-const Kernel::Clock::duration_u32 STATS_SAMPLE_TIME = 15s;
-
-float cpu_usage_percent(uint64_t idle_diff, uint64_t sample_time) {
-    float usage_percent =
-            100.0f
-            - (static_cast<float>(idle_diff) / static_cast<float>(sample_time))
-                      * 100.0f;
-    return std::max(0.0f, std::min(100.0f, usage_percent));
-}
-
-void print_stats(void) {
-#if !MBED_MEM_TRACING_ENABLED || !MBED_STACK_STATS_ENABLED
-#warning "Thread stack statistics require MBED_STACK_STATS_ENABLED and " \
-             "MBED_MEM_TRACING_ENABLED to be defined in mbed_app.json"
-    avs_log(mbed_stats, INFO, "Thread stacks stats disabled");
-#else
-    int num_threads = osThreadGetCount();
-    assert(num_threads >= 0);
-    std::unique_ptr<mbed_stats_stack_t[]> stack_stats{ new (
-            std::nothrow) mbed_stats_stack_t[num_threads] };
-    if (!stack_stats) {
-        avs_log(mbed_stats, ERROR, "out of memory");
-        return;
-    }
-    num_threads = mbed_stats_stack_get_each(stack_stats.get(), num_threads);
-
-    avs_log(mbed_stats, INFO, "Thread stacks:");
-    for (int i = 0; i < num_threads; ++i) {
-        const auto &stats = stack_stats[i];
-        avs_log(mbed_stats, INFO, "- thread %#08" PRIx32 ": %5lu / %5lu B used",
-                stats.thread_id, stats.max_size, stats.reserved_size);
-    }
-#endif
-
-#if !MBED_MEM_TRACING_ENABLED || !MBED_HEAP_STATS_ENABLED
-#warning "Thread stack statistics require MBED_HEAP_STATS_ENABLED and " \
-             "MBED_MEM_TRACING_ENABLED to be defined in mbed_app.json"
-    avs_log(mbed_stats, INFO, "Heap usage stats disabled");
-#else
-    mbed_stats_heap_t heap_stats;
-    mbed_stats_heap_get(&heap_stats);
-    avs_log(mbed_stats, INFO, "Heap: %lu/%lu B used", heap_stats.current_size,
-            heap_stats.reserved_size);
-#endif
-
-#if !MBED_CPU_STATS_ENABLED
-#warning "CPU usage statistics require MBED_CPU_STATS_ENABLED to be " \
-             "defined in mbed_app.json"
-    avs_log(mbed_stats, INFO, "CPU usage stats disabled");
-#else
-    static mbed_stats_cpu_t prev_cpu_stats;
-    mbed_stats_cpu_t cpu_stats;
-    mbed_stats_cpu_get(&cpu_stats);
-
-    static uint64_t samples_gathered = 0;
-    ++samples_gathered;
-
-    avs_log(mbed_stats, INFO, "CPU usage: %.4f%% current, %.4f%% average",
-            cpu_usage_percent(
-                    cpu_stats.idle_time - prev_cpu_stats.idle_time,
-                    std::chrono::duration_cast<std::chrono::microseconds>(
-                            STATS_SAMPLE_TIME)
-                            .count()),
-            cpu_usage_percent(
-                    cpu_stats.idle_time,
-                    std::chrono::duration_cast<std::chrono::microseconds>(
-                            STATS_SAMPLE_TIME)
-                                    .count()
-                            * samples_gathered));
-
-    prev_cpu_stats = cpu_stats;
-#endif
-}
-
 Thread thread_lwm2m(osPriorityNormal, 16384, nullptr, "lwm2m");
 
 #if MBED_CONF_TARGET_NETWORK_DEFAULT_INTERFACE_TYPE == CELLULAR
@@ -475,28 +573,123 @@ void set_modem_configuration(CellularInterface *dest, const ModemConfig &src) {
         dest->set_sim_pin(src.sim_pin_code.c_str());
     }
 }
+
+// eDRX cycle lengths for each value of the eDRX parameter in S1 mode, see
+// 3GPP TS 24.008, table 10.5.5.32
+const uint32_t EDRX_CYCLE_MS[] = { 5120,    10240,   20480,   40960,
+                                   61440,   81920,   102400,  122880,
+                                   143360,  163840,  327680,  655360,
+                                   1310720, 2621440, 5242880, 10485760 };
+
+// -1 disables eDRX
+static_assert(MBED_CONF_APP_EDRX_CYCLE >= -1
+                      && MBED_CONF_APP_EDRX_CYCLE
+                                 < (int) AVS_ARRAY_SIZE(EDRX_CYCLE_MS),
+              "invalid eDRX cycle");
+
+/**
+ * In queue mode, requests PSM with the active time equal to the time Anjay
+ * keeps listening after the last exchange, so that the radio is reachable
+ * exactly as long as the LwM2M Server may expect it to be, and sleeps
+ * otherwise. The periodic TAU is aligned with the lifetime, as the radio
+ * needs to wake up for the Registration Update anyway. eDRX further reduces
+ * power usage during the active time, if its cycle is short enough not to
+ * make the device unreachable.
+ *
+ * Outside of the queue mode, both PSM and eDRX are disabled.
+ */
+void configure_power_saving(CellularNetwork *network,
+                            const Lwm2mConfig &config) {
+    using EDRXAccessTechnology = CellularNetwork::EDRXAccessTechnology;
+    using RAT = CellularNetwork::RadioAccessTechnology;
+    EDRXAccessTechnology edrx_act;
+    bool edrx_supported = true;
+    switch (config.modem_config.rat) {
+    case RAT::RAT_E_UTRAN:
+    case RAT::RAT_CATM1:
+        edrx_act = EDRXAccessTechnology::EDRXEUTRAN_WB_S1_mode;
+        break;
+    case RAT::RAT_NB1:
+        edrx_act = EDRXAccessTechnology::EDRXEUTRAN_NB_S1_mode;
+        break;
+    default:
+        edrx_act = EDRXAccessTechnology::EDRXAccessTechnologyNotUsed;
+        edrx_supported = false;
+        break;
+    }
+
+    if (!config.queue_mode_enabled) {
+        network->set_power_save_mode(0, 0);
+        if (edrx_supported) {
+            network->set_receive_period(0, edrx_act, 0);
+        }
+        return;
+    }
+
+    const int active_time_s = coap_max_transmit_wait_s();
+    nsapi_error_t err =
+            network->set_power_save_mode(MBED_CONF_APP_QUEUE_MODE_LIFETIME_S,
+                                         active_time_s);
+    if (err) {
+        APP_LOG(network, WARNING, "could not enable PSM: %d", err);
+    } else {
+        APP_LOG(network, INFO, "PSM requested: TAU %d s, active time %d s",
+                MBED_CONF_APP_QUEUE_MODE_LIFETIME_S, active_time_s);
+    }
+
+    if (!edrx_supported || MBED_CONF_APP_EDRX_CYCLE < 0) {
+        return;
+    }
+    if (EDRX_CYCLE_MS[MBED_CONF_APP_EDRX_CYCLE]
+        >= (uint32_t) active_time_s * 1000) {
+        APP_LOG(network, WARNING,
+                "eDRX cycle is not shorter than PSM active time, not enabling "
+                "eDRX");
+        return;
+    }
+    if ((err = network->set_receive_period(1, edrx_act,
+                                           MBED_CONF_APP_EDRX_CYCLE))) {
+        APP_LOG(network, WARNING, "could not enable eDRX: %d", err);
+    }
+}
+#endif // MBED_CONF_TARGET_NETWORK_DEFAULT_INTERFACE_TYPE == CELLULAR
+
+#if MBED_CONF_TARGET_NETWORK_DEFAULT_INTERFACE_TYPE == CELLULAR
+bool network_config_changed(const Lwm2mConfig &old_config,
+                            const Lwm2mConfig &new_config) {
+    return old_config.modem_config != new_config.modem_config
+           || old_config.queue_mode_enabled != new_config.queue_mode_enabled;
+}
+#else  // MBED_CONF_TARGET_NETWORK_DEFAULT_INTERFACE_TYPE == CELLULAR
+bool network_config_changed(const Lwm2mConfig &old_config,
+                            const Lwm2mConfig &new_config) {
+    (void) old_config;
+    (void) new_config;
+    return false;
+}
 #endif // MBED_CONF_TARGET_NETWORK_DEFAULT_INTERFACE_TYPE == CELLULAR
 
 class NetworkService {
     NetworkInterface *iface_;
-
-public:
-    NetworkService() : iface_() {}
+    Lwm2mConfig config_;
+    std::unique_ptr<Thread> thread_;
+    int result_;
 
     /**
      * This function is responsible for simple connection management. It's
      * supposed to:
-     *      - initialize underlying network devices & connect to the network,
+     *      - initialize underlying network devices & start connecting to the
+     *        network in the background (see ConnectionManager),
      *      - setup iface_ field to a valid NetworkInterface instance,
      *      - (optional) setup NETWORK global variable if the network is
      *        cellular.
      *
+     * It does not wait for the link: the LwM2M client starts with its
+     * transports offline and follows the link from then on.
+     *
      * @returns 0 on success, negative value otherwise.
      */
     int init(Lwm2mConfig &config) {
-        SocketAddress sa;
-        nsapi_error_t err;
-
         NetworkInterface *netif = NetworkInterface::get_default_instance();
         if (!netif) {
             printf("ERROR - can't get default network instance!\n");
@@ -507,40 +700,80 @@ public:
         if (CellularInterface *cellular = netif->cellularInterface()) {
             set_modem_configuration(cellular, config.modem_config);
         }
-#endif // MBED_CONF_TARGET_NETWORK_DEFAULT_INTERFACE_TYPE == CELLULAR
-
-        printf("Configuring network interface\n");
-        for (int retry = 0;
-             netif->get_connection_status() != NSAPI_STATUS_GLOBAL_UP;
-             ++retry) {
-            printf("connect, retry = %d\n", retry);
-            nsapi_error_t err = netif->connect();
-            printf("connect result = %d\n", err);
-        }
-
-#if MBED_CONF_TARGET_NETWORK_DEFAULT_INTERFACE_TYPE == CELLULAR
         if (CellularDevice *device = CellularDevice::get_default_instance()) {
             NETWORK = device->open_network();
             NETWORK->set_access_technology(config.modem_config.rat);
+            configure_power_saving(NETWORK, config);
         }
 #endif // MBED_CONF_TARGET_NETWORK_DEFAULT_INTERFACE_TYPE == CELLULAR
 
-        // Print IP address and MAC address, quite useful in troubleshooting
-        err = netif->get_ip_address(&sa);
-        if (err != NSAPI_ERROR_OK) {
-            printf("get_ip_address() - failed, status %d\n", err);
-        } else {
-            printf("IP: %s\n",
-                   (sa.get_ip_address() ? sa.get_ip_address() : "None"));
-            printf("MAC address: %s\n",
-                   (netif->get_mac_address() ? netif->get_mac_address()
-                                             : "None"));
+        APP_LOG(network, INFO, "Configuring network interface");
+        if (CONNECTION_MANAGER.start(netif, mbed_event_queue())) {
+            return -1;
         }
 
         iface_ = netif;
         return 0;
     }
 
+    void run() {
+        result_ = init(config_);
+    }
+
+public:
+    NetworkService() : iface_(), config_(), thread_(), result_(-1) {}
+
+    /**
+     * Starts bringing up the network in a background thread, so that it can
+     * run in parallel with other boot steps. Only the network-related parts
+     * of @p config are used.
+     *
+     * @returns 0 on success, negative value otherwise.
+     */
+    int start(const Lwm2mConfig &config) {
+        assert(!thread_);
+        config_ = config;
+        // The same stack size is used as when this was done in main()
+        thread_.reset(new (std::nothrow)
+                              Thread(osPriorityNormal,
+                                     MBED_CONF_RTOS_MAIN_THREAD_STACK_SIZE,
+                                     nullptr, "network"));
+        if (!thread_
+            || thread_->start(callback(this, &NetworkService::run)) != osOK) {
+            thread_.reset();
+            return -1;
+        }
+        return 0;
+    }
+
+    /**
+     * Waits until the network bring-up started with start() finishes. The
+     * link itself may still be down, see init().
+     *
+     * @returns 0 if the network interface is started, negative value
+     *          otherwise.
+     */
+    int wait() {
+        if (thread_) {
+            thread_->join();
+            // Release the thread stack, it is no longer needed
+            thread_.reset();
+        }
+        return result_;
+    }
+
+    /**
+     * Disconnects the network, if any, and starts bringing it up again with
+     * a new configuration.
+     */
+    int restart(const Lwm2mConfig &config) {
+        wait();
+        CONNECTION_MANAGER.stop();
+        iface_ = nullptr;
+        result_ = -1;
+        return start(config);
+    }
+
     NetworkInterface *get_network_interface() {
         return iface_;
     }
@@ -549,18 +782,41 @@ public:
 } // namespace
 
 int main() {
+    Lwm2mConfigPersistence config_persistence;
+    if (config_persistence.persistence(
+                Lwm2mConfigPersistence::Direction::RESTORE,
+                SERIAL_MENU_CONFIG)) {
+        printf("[INFO] Error occurred during loading configuration from "
+               "flash. Possible cause: device is booted up right after "
+               "factory reset or data on flash is corrupted.\n");
+    }
+    boot_timing_mark(BootPhase::CONFIG_LOADED);
+
+    mbed_trace_init();
+    avs_log_set_default_level(SERIAL_MENU_CONFIG.log_level);
+    if (deferred_log_start()) {
+        printf("[ERROR] Could not start the logging thread\n");
+    } else {
+        avs_log_set_handler(log_handler);
+    }
+
+    // See https://github.com/ARMmbed/mbed-os/issues/7069. In general this is
+    // required to initialize hardware RNG used by default.
+    mbedtls_platform_setup(NULL);
+
+    CONNECTION_MANAGER.set_link_callback(callback(on_link_change));
+    NetworkService ns{};
+    int ns_result;
     {
-        Lwm2mConfigPersistence config_persistence;
-        if (config_persistence.persistence(
-                    Lwm2mConfigPersistence::Direction::RESTORE,
-                    SERIAL_MENU_CONFIG)) {
-            printf("[INFO] Error occurred during loading configuration from "
-                   "flash. Possible cause: device is booted up right after "
-                   "factory reset or data on flash is corrupted.\n");
-        }
+        // Bring up the network while waiting for the user to enter the
+        // configuration menu, as it may take tens of seconds on cellular
+        QuietConsole quiet_console;
+        ns_result = ns.start(SERIAL_MENU_CONFIG);
+
         printf("\nPress any key in 3 seconds to enter device configuration "
                "menu...\n");
         if (should_show_menu(avs_time_duration_from_scalar(3, AVS_TIME_S))) {
+            const Lwm2mConfig previous_config = SERIAL_MENU_CONFIG;
             show_menu_and_maybe_update_config(SERIAL_MENU_CONFIG);
             if (config_persistence.persistence(
                         Lwm2mConfigPersistence::Direction::STORE,
@@ -568,27 +824,26 @@ int main() {
                 printf("[INFO] Error occurred during saving configuration into "
                        "flash.\n");
             }
+            avs_log_set_default_level(SERIAL_MENU_CONFIG.log_level);
+            if (!ns_result
+                && network_config_changed(previous_config,
+                                          SERIAL_MENU_CONFIG)) {
+                printf("[INFO] Network configuration changed, "
+                       "reconnecting...\n");
+                ns_result = ns.restart(SERIAL_MENU_CONFIG);
+            }
         }
     }
 
-    mbed_trace_init();
-    avs_log_set_default_level(SERIAL_MENU_CONFIG.log_level);
-    avs_log_set_handler(log_handler);
+    // Console input is only used by the configuration menu, and keeping the
+    // UART receiver enabled would prevent the MCU from entering deep sleep
+    mbed_file_handle(STDIN_FILENO)->enable_input(false);
 
-#if MBED_MEM_TRACING_ENABLED                                     \
-        || (MBED_STACK_STATS_ENABLED && MBED_HEAP_STATS_ENABLED) \
-        || (MBED_HEAP_STATS_ENABLED && MBED_HEAP_STATS_ENABLED)
-    mbed_event_queue()->call_every(STATS_SAMPLE_TIME, print_stats);
-#else
-    avs_log(mbed_stats, INFO, "All stats disabled");
-#endif
-
-    // See https://github.com/ARMmbed/mbed-os/issues/7069. In general this is
-    // required to initialize hardware RNG used by default.
-    mbedtls_platform_setup(NULL);
+#ifndef WITH_STATS_LOG
+    APP_LOG(mbed_stats, INFO, "All stats disabled");
+#endif // WITH_STATS_LOG
 
-    NetworkService ns{};
-    if (ns.init(SERIAL_MENU_CONFIG)) {
+    if (ns_result || ns.wait()) {
         printf("[ERROR] The target platform you're using does not have network "
                "configuration pre-implemented. Please see the NetworkService "
                "class (defined in main.cpp) for more details.\n");
@@ -599,15 +854,24 @@ int main() {
     }
 
     {
-        AvsSocketGlobal avs(ns.get_network_interface(), 32, 1536,
+        AvsSocketGlobal avs(ns.get_network_interface(),
+                            MBED_CONF_APP_AVS_SOCKET_GLOBAL_EVENT_QUEUE_SIZE,
+                            MBED_CONF_APP_AVS_SOCKET_GLOBAL_THREAD_STACK_SIZE,
                             AVS_NET_AF_INET4);
 
         thread_lwm2m.start(lwm2m_serve);
+#if MBED_CONF_APP_HEARTBEAT_LED
         DigitalOut heartbeat{ LED1 };
         int heartbeat_value = 0;
         for (;;) {
-            heartbeat = (heartbeat_value ^= 1);
+            {
+                WakeupScope wakeup(WakeupCause::HEARTBEAT);
+                heartbeat = (heartbeat_value ^= 1);
+            }
             ThisThread::sleep_for(1s);
         }
+#else  // MBED_CONF_APP_HEARTBEAT_LED
+        thread_lwm2m.join();
+#endif // MBED_CONF_APP_HEARTBEAT_LED
     }
 }
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "object_registry.h"
+
+#include <CellularContext.h>
+#include <avsystem/commons/avs_defs.h>
+
+#include "accelerometer.h"
+#include "app_log.h"
+#include "barometer.h"
+#include "client_local.h"
+#include "conn_monitoring_object.h"
+#include "device_object.h"
+#include "fota_stats_object.h"
+#ifdef MBED_CLOUD_CLIENT_FOTA_ENABLE
+#include "fw_update.h"
+#endif // MBED_CLOUD_CLIENT_FOTA_ENABLE
+#include "humidity.h"
+#include "joystick.h"
+#include "magnetometer.h"
+#include "system_health_object.h"
+
+namespace {
+
+// Network passed to object_registry_install()
+CLIENT_LOCAL mbed::CellularNetwork *NETWORK;
+
+int install_conn_monitoring_object(anjay_t *anjay) {
+    if (NETWORK) {
+        if (auto *ctx = mbed::CellularContext::get_default_instance()) {
+            return conn_monitoring_object_install(anjay, ctx, NETWORK);
+        }
+    }
+    return 0;
+}
+
+struct ObjectDescriptor {
+    const char *name;
+    anjay_oid_t oid;
+    int (*install)(anjay_t *anjay);
+    void (*uninstall)(anjay_t *anjay);
+    void (*update)(anjay_t *anjay);
+    // Resources of instance 0 whose changes can only be detected by polling
+    // in periodic_update()
+    const anjay_rid_t *polled_rids;
+    size_t polled_rid_count;
+    // Sampling period while any of polled_rids is observed
+    uint32_t period_ms;
+};
+
+constexpr uint32_t SENSOR_PERIOD_MS = MBED_CONF_APP_SENSOR_SAMPLE_PERIOD_MS;
+
+#if (SENSORS_IKS01A2 == 1)
+constexpr anjay_rid_t SENSOR_POLLED_RIDS[] = {
+    5700 // Sensor Value
+};
+
+constexpr anjay_rid_t AXES_POLLED_RIDS[] = {
+    5702, // X Value
+    5703, // Y Value
+    5704  // Z Value
+};
+#endif // SENSORS_IKS01A2
+
+#ifdef TARGET_DISCO_L496AG
+constexpr anjay_rid_t JOYSTICK_POLLED_RIDS[] = {
+    5500, // Digital Input State
+    5501, // Digital Input Counter
+    5702, // X Value
+    5703  // Y Value
+};
+#endif // TARGET_DISCO_L496AG
+
+/**
+ * Application objects, in the order of installation. They are uninstalled in
+ * the reverse order. Objects that are not compiled in are left out of the
+ * table altogether.
+ */
+constexpr ObjectDescriptor OBJECTS[] = {
+    // Current Time is computed on read and only notified on clock
+    // adjustments, so it does not need to be polled
+    { "Device", 3, device_object_install, device_object_uninstall,
+      device_object_update, nullptr, 0, 0 },
+#ifdef MBED_CLOUD_CLIENT_FOTA_ENABLE
+    // Firmware Update object is released by anjay_delete()
+    { "Firmware Update", 5, fw_update_object_install, nullptr, nullptr,
+      nullptr, 0, 0 },
+    { "FOTA Statistics", FOTA_STATS_OID, fota_stats_object_install,
+      fota_stats_object_uninstall, fota_stats_object_update, nullptr, 0, 0 },
+#endif // MBED_CLOUD_CLIENT_FOTA_ENABLE
+    { "System Health", SYSTEM_HEALTH_OID, system_health_object_install,
+      system_health_object_uninstall, system_health_object_update, nullptr,
+      0, 0 },
+#ifdef TARGET_DISCO_L496AG
+    { "Multiple Axis Joystick", 3345, joystick_object_install,
+      joystick_object_uninstall, joystick_object_update, JOYSTICK_POLLED_RIDS,
+      AVS_ARRAY_SIZE(JOYSTICK_POLLED_RIDS), SENSOR_PERIOD_MS },
+#endif // TARGET_DISCO_L496AG
+#if (SENSORS_IKS01A2 == 1)
+    { "Humidity", 3304, humidity_object_install, humidity_object_uninstall,
+      humidity_object_update, SENSOR_POLLED_RIDS,
+      AVS_ARRAY_SIZE(SENSOR_POLLED_RIDS), SENSOR_PERIOD_MS },
+    { "Barometer", 3315, barometer_object_install, barometer_object_uninstall,
+      barometer_object_update, SENSOR_POLLED_RIDS,
+      AVS_ARRAY_SIZE(SENSOR_POLLED_RIDS), SENSOR_PERIOD_MS },
+    { "Magnetometer", 3314, magnetometer_object_install,
+      magnetometer_object_uninstall, magnetometer_object_update,
+      AXES_POLLED_RIDS, AVS_ARRAY_SIZE(AXES_POLLED_RIDS), SENSOR_PERIOD_MS },
+    { "Accelerometer", 3313, accelerometer_object_install,
+      accelerometer_object_uninstall, accelerometer_object_update,
+      AXES_POLLED_RIDS, AVS_ARRAY_SIZE(AXES_POLLED_RIDS), SENSOR_PERIOD_MS },
+#endif // SENSORS_IKS01A2
+    { "Connectivity Monitoring", CONN_MONITORING_OID,
+      install_conn_monitoring_object, conn_monitoring_object_uninstall,
+      nullptr, nullptr, 0, 0 }
+};
+
+} // namespace
+
+int object_registry_install(anjay_t *anjay, mbed::CellularNetwork *network) {
+    NETWORK = network;
+    for (const ObjectDescriptor &object : OBJECTS) {
+        if (object.install(anjay)) {
+            APP_LOG(lwm2m, ERROR, "cannot install %s object", object.name);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void object_registry_uninstall(anjay_t *anjay) {
+    for (size_t i = AVS_ARRAY_SIZE(OBJECTS); i-- > 0;) {
+        if (OBJECTS[i].uninstall) {
+            OBJECTS[i].uninstall(anjay);
+        }
+    }
+}
+
+void object_registry_update(anjay_t *anjay) {
+    for (const ObjectDescriptor &object : OBJECTS) {
+        if (object.update) {
+            object.update(anjay);
+        }
+    }
+}
+
+avs_time_duration_t object_registry_next_update_delay(anjay_t *anjay) {
+    // All objects are sampled together, at the shortest period of the
+    // observed ones
+    uint32_t delay_ms = MBED_CONF_APP_IDLE_UPDATE_PERIOD_MS;
+    for (const ObjectDescriptor &object : OBJECTS) {
+        if (object.period_ms >= delay_ms) {
+            continue;
+        }
+        for (size_t i = 0; i < object.polled_rid_count; ++i) {
+            if (anjay_resource_observation_status(anjay, object.oid, 0,
+                                                  object.polled_rids[i])
+                        .is_observed) {
+                delay_ms = object.period_ms;
+                break;
+            }
+        }
+    }
+    return avs_time_duration_from_scalar(delay_ms, AVS_TIME_MS);
+}
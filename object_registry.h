@@ -0,0 +1,60 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef OBJECT_REGISTRY_H
+#define OBJECT_REGISTRY_H
+
+#include <CellularNetwork.h>
+#include <anjay/anjay.h>
+#include <avsystem/commons/avs_time.h>
+
+/**
+ * Installs the application objects that are compiled in, in a fixed order.
+ * Connectivity Monitoring object is only installed if @p network is not NULL.
+ *
+ * @returns 0 on success, negative value if any of the objects could not be
+ *          installed. object_registry_uninstall() shall be called in either
+ *          case.
+ */
+int object_registry_install(anjay_t *anjay, mbed::CellularNetwork *network);
+
+/**
+ * Uninstalls the application objects, in the reverse order of installation.
+ */
+void object_registry_uninstall(anjay_t *anjay);
+
+/**
+ * Updates the state of the application objects and notifies the changes.
+ * All objects are sampled in a single call, so that Anjay flushes the
+ * resulting notifications at once: a Composite-Observe of several sensors
+ * gets a single notification with all the values changed since the previous
+ * call. It shall therefore be called from a single scheduler job.
+ */
+void object_registry_update(anjay_t *anjay);
+
+/**
+ * Sensors only need to be sampled frequently if a LwM2M Server observes any
+ * of them. Otherwise, object_registry_update() only performs housekeeping and
+ * can be called rarely, which lets the MCU stay in (deep) sleep.
+ *
+ * @returns Delay after which object_registry_update() should be called next:
+ *          the shortest sampling period of the Objects that are observed, or
+ *          the idle update period if none is.
+ */
+avs_time_duration_t object_registry_next_update_delay(anjay_t *anjay);
+
+#endif // OBJECT_REGISTRY_H
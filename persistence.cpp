@@ -21,7 +21,6 @@
 #include <anjay/security.h>
 #include <anjay/server.h>
 
-#include <avsystem/commons/avs_log.h>
 #include <avsystem/commons/avs_stream_inbuf.h>
 #include <avsystem/commons/avs_stream_membuf.h>
 
@@ -33,7 +32,10 @@
 
 #include <kvstore_global_api/kvstore_global_api.h>
 
-#define LOG(...) avs_log(persistence, __VA_ARGS__)
+#include "app_log.h"
+#include "client_local.h"
+
+#define LOG(...) APP_LOG(persistence, __VA_ARGS__)
 
 namespace {
 
@@ -80,7 +82,7 @@ const Target targets[] = {
     DECL_TARGET(est_state),
 #endif // MBED_CONF_APP_WITH_EST
 };
-bool previous_attempt_failed;
+CLIENT_LOCAL bool previous_attempt_failed;
 
 #undef DECL_TARGET
 
@@ -0,0 +1,190 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime_stats.h"
+
+#include <algorithm>
+#include <cstring>
+#include <inttypes.h>
+#include <memory>
+#include <new>
+
+#include <mbed.h>
+
+#include "app_log.h"
+
+namespace {
+
+rtos::Mutex STATS_MUTEX;
+RuntimeStats STATS;
+
+// Samples are taken into static storage rather than on the stack, as they
+// are too large for the stacks of the threads that take them. SAMPLE_MUTEX
+// guards it against concurrent samplers.
+rtos::Mutex SAMPLE_MUTEX;
+RuntimeStats SAMPLE;
+#ifdef RUNTIME_STATS_WITH_STACK
+mbed_stats_stack_t STACK_STATS[RUNTIME_STATS_MAX_THREADS];
+#endif // RUNTIME_STATS_WITH_STACK
+
+#ifdef RUNTIME_STATS_WITH_CPU
+float cpu_usage_percent(uint64_t idle_diff, uint64_t sample_time) {
+    float usage_percent =
+            100.0f
+            - (static_cast<float>(idle_diff) / static_cast<float>(sample_time))
+                      * 100.0f;
+    return std::max(0.0f, std::min(100.0f, usage_percent));
+}
+#endif // RUNTIME_STATS_WITH_CPU
+
+void sample_stack_stats(RuntimeStats *stats, bool log) {
+#ifndef RUNTIME_STATS_WITH_STACK
+#warning "Thread stack statistics require MBED_STACK_STATS_ENABLED and " \
+             "MBED_MEM_TRACING_ENABLED to be defined in mbed_app.json"
+    (void) stats;
+    if (log) {
+        APP_LOG(mbed_stats, INFO, "Thread stacks stats disabled");
+    }
+#else  // RUNTIME_STATS_WITH_STACK
+    mbed_stats_stack_t *stack_stats = STACK_STATS;
+    int capacity = (int) RUNTIME_STATS_MAX_THREADS;
+    // Only the first RUNTIME_STATS_MAX_THREADS threads are kept in the
+    // statistics, but all of them are logged; a temporary buffer is
+    // allocated in the rare case when there are more
+    std::unique_ptr<mbed_stats_stack_t[]> all_stack_stats;
+    const int thread_count = osThreadGetCount();
+    if (log && thread_count > capacity) {
+        all_stack_stats.reset(new (std::nothrow)
+                                      mbed_stats_stack_t[thread_count]);
+        if (all_stack_stats) {
+            stack_stats = all_stack_stats.get();
+            capacity = thread_count;
+        }
+    }
+    const int num_threads = mbed_stats_stack_get_each(stack_stats, capacity);
+
+    if (log) {
+        APP_LOG(mbed_stats, INFO, "Thread stacks:");
+    }
+    stats->thread_count = 0;
+    for (int i = 0; i < num_threads; ++i) {
+        const mbed_stats_stack_t &stack = stack_stats[i];
+        if (log) {
+            APP_LOG(mbed_stats, INFO,
+                    "- thread %#08" PRIx32 ": %5lu / %5lu B used",
+                    stack.thread_id, stack.max_size, stack.reserved_size);
+        }
+
+        if (stats->thread_count == RUNTIME_STATS_MAX_THREADS) {
+            continue;
+        }
+        ThreadStackStats &thread = stats->threads[stats->thread_count++];
+        const char *name = osThreadGetName((osThreadId_t) stack.thread_id);
+        snprintf(thread.name, sizeof(thread.name), "%s", name ? name : "");
+        thread.max_used = stack.max_size;
+        thread.size = stack.reserved_size;
+    }
+    if (log && thread_count > num_threads) {
+        APP_LOG(mbed_stats, WARNING, "- %d more threads not shown",
+                thread_count - num_threads);
+    }
+#endif // RUNTIME_STATS_WITH_STACK
+}
+
+void sample_heap_stats(RuntimeStats *stats, bool log) {
+#ifndef RUNTIME_STATS_WITH_HEAP
+#warning "Thread stack statistics require MBED_HEAP_STATS_ENABLED and " \
+             "MBED_MEM_TRACING_ENABLED to be defined in mbed_app.json"
+    (void) stats;
+    if (log) {
+        APP_LOG(mbed_stats, INFO, "Heap usage stats disabled");
+    }
+#else  // RUNTIME_STATS_WITH_HEAP
+    mbed_stats_heap_t heap_stats;
+    mbed_stats_heap_get(&heap_stats);
+    if (log) {
+        APP_LOG(mbed_stats, INFO, "Heap: %lu/%lu B used",
+                heap_stats.current_size, heap_stats.reserved_size);
+    }
+
+    stats->heap_used = heap_stats.current_size;
+    stats->heap_peak = heap_stats.max_size;
+    stats->heap_size = heap_stats.reserved_size;
+    stats->alloc_count = heap_stats.alloc_cnt;
+    stats->alloc_failures = heap_stats.alloc_fail_cnt;
+#endif // RUNTIME_STATS_WITH_HEAP
+}
+
+void sample_cpu_stats(RuntimeStats *stats, bool log) {
+#ifndef RUNTIME_STATS_WITH_CPU
+#warning "CPU usage statistics require MBED_CPU_STATS_ENABLED to be " \
+             "defined in mbed_app.json"
+    (void) stats;
+    if (log) {
+        APP_LOG(mbed_stats, INFO, "CPU usage stats disabled");
+    }
+#else  // RUNTIME_STATS_WITH_CPU
+    static mbed_stats_cpu_t prev_cpu_stats;
+    mbed_stats_cpu_t cpu_stats;
+    mbed_stats_cpu_get(&cpu_stats);
+
+    stats->cpu_usage =
+            cpu_usage_percent(cpu_stats.idle_time - prev_cpu_stats.idle_time,
+                              cpu_stats.uptime - prev_cpu_stats.uptime);
+    stats->average_cpu_usage =
+            cpu_usage_percent(cpu_stats.idle_time, cpu_stats.uptime);
+    if (log) {
+        APP_LOG(mbed_stats, INFO, "CPU usage: %.4f%% current, %.4f%% average",
+                stats->cpu_usage, stats->average_cpu_usage);
+    }
+
+    prev_cpu_stats = cpu_stats;
+#endif // RUNTIME_STATS_WITH_CPU
+}
+
+} // namespace
+
+void runtime_stats_sample(bool log) {
+    ScopedMutexLock sample_lock(SAMPLE_MUTEX);
+    // Sampled into a separate copy, so that logging is done without holding
+    // STATS_MUTEX
+    runtime_stats_get(&SAMPLE);
+
+    sample_stack_stats(&SAMPLE, log);
+    sample_heap_stats(&SAMPLE, log);
+    sample_cpu_stats(&SAMPLE, log);
+
+    ScopedMutexLock lock(STATS_MUTEX);
+    SAMPLE.event_loop_lag_ms = STATS.event_loop_lag_ms;
+    SAMPLE.max_event_loop_lag_ms = STATS.max_event_loop_lag_ms;
+    SAMPLE.generation = STATS.generation + 1;
+    STATS = SAMPLE;
+}
+
+void runtime_stats_record_event_loop_lag(avs_time_duration_t lag) {
+    int64_t lag_ms;
+    if (avs_time_duration_to_scalar(&lag_ms, AVS_TIME_MS, lag) || lag_ms < 0) {
+        lag_ms = 0;
+    }
+    ScopedMutexLock lock(STATS_MUTEX);
+    STATS.event_loop_lag_ms = lag_ms;
+    STATS.max_event_loop_lag_ms = std::max(STATS.max_event_loop_lag_ms, lag_ms);
+}
+
+void runtime_stats_get(RuntimeStats *out_stats) {
+    ScopedMutexLock lock(STATS_MUTEX);
+    *out_stats = STATS;
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RUNTIME_STATS_H
+#define RUNTIME_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <avsystem/commons/avs_time.h>
+
+#if MBED_MEM_TRACING_ENABLED && MBED_STACK_STATS_ENABLED
+#define RUNTIME_STATS_WITH_STACK 1
+#endif // MBED_MEM_TRACING_ENABLED && MBED_STACK_STATS_ENABLED
+
+#if MBED_MEM_TRACING_ENABLED && MBED_HEAP_STATS_ENABLED
+#define RUNTIME_STATS_WITH_HEAP 1
+#endif // MBED_MEM_TRACING_ENABLED && MBED_HEAP_STATS_ENABLED
+
+#if MBED_CPU_STATS_ENABLED
+#define RUNTIME_STATS_WITH_CPU 1
+#endif // MBED_CPU_STATS_ENABLED
+
+constexpr size_t RUNTIME_STATS_MAX_THREADS = 16;
+
+struct ThreadStackStats {
+    char name[16];
+    uint32_t max_used;
+    uint32_t size;
+};
+
+/**
+ * Snapshot of the runtime statistics, taken by runtime_stats_sample(). Only
+ * the statistics enabled with the RUNTIME_STATS_WITH_* macros are filled in.
+ */
+struct RuntimeStats {
+    // Incremented whenever a new sample is taken
+    uint32_t generation;
+
+    uint32_t heap_used;
+    uint32_t heap_peak;
+    uint32_t heap_size;
+    uint32_t alloc_count;
+    uint32_t alloc_failures;
+
+    size_t thread_count;
+    ThreadStackStats threads[RUNTIME_STATS_MAX_THREADS];
+
+    float cpu_usage;
+    float average_cpu_usage;
+
+    // Delay of the most recent periodic job in the LwM2M event loop and the
+    // largest one seen, in milliseconds
+    int64_t event_loop_lag_ms;
+    int64_t max_event_loop_lag_ms;
+};
+
+/**
+ * Collects heap, thread stack and CPU usage statistics, and logs them if
+ * @p log is true. Intended to be called periodically.
+ */
+void runtime_stats_sample(bool log);
+
+/**
+ * Records how late a job scheduled in the LwM2M event loop has been run.
+ */
+void runtime_stats_record_event_loop_lag(avs_time_duration_t lag);
+
+void runtime_stats_get(RuntimeStats *out_stats);
+
+#endif // RUNTIME_STATS_H
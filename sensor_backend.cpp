@@ -0,0 +1,107 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#if (SENSORS_IKS01A2 == 1)
+
+#include "sensor_backend.h"
+
+#include <XNucleoIKS01A2.h>
+
+namespace {
+
+constexpr uint8_t HTS221_WHO_AM_I = 0xBC;
+
+class Iks01a2SensorBackend : public SensorBackend {
+    static XNucleoIKS01A2 *board() {
+        return XNucleoIKS01A2::instance(D14, D15);
+    }
+
+public:
+    int enable(SensorType type) override {
+        uint8_t id = 0;
+        switch (type) {
+        case SensorType::BAROMETER:
+            return board()->pt_sensor->enable();
+        case SensorType::HUMIDITY:
+            return board()->ht_sensor->read_id(&id) || id != HTS221_WHO_AM_I
+                           ? -1
+                           : board()->ht_sensor->enable();
+        case SensorType::ACCELEROMETER:
+            return board()->accelerometer->read_id(&id)
+                                   || id != LSM303AGR_ACC_WHO_AM_I
+                           ? -1
+                           : board()->accelerometer->enable();
+        case SensorType::MAGNETOMETER:
+            return board()->magnetometer->read_id(&id)
+                                   || id != LSM303AGR_MAG_WHO_AM_I
+                           ? -1
+                           : board()->magnetometer->enable();
+        }
+        return -1;
+    }
+
+    int disable(SensorType type) override {
+        switch (type) {
+        case SensorType::BAROMETER:
+            return board()->pt_sensor->disable();
+        case SensorType::HUMIDITY:
+            return board()->ht_sensor->disable();
+        case SensorType::ACCELEROMETER:
+            return board()->accelerometer->disable();
+        case SensorType::MAGNETOMETER:
+            return board()->magnetometer->disable();
+        }
+        return -1;
+    }
+
+    int read_scalar(SensorType type, float *out_value) override {
+        switch (type) {
+        case SensorType::BAROMETER:
+            return board()->pt_sensor->get_pressure(out_value);
+        case SensorType::HUMIDITY:
+            return board()->ht_sensor->get_humidity(out_value);
+        default:
+            return -1;
+        }
+    }
+
+    int read_axes(SensorType type, int32_t *out_axes) override {
+        switch (type) {
+        case SensorType::ACCELEROMETER:
+            return board()->accelerometer->get_x_axes(out_axes);
+        case SensorType::MAGNETOMETER:
+            return board()->magnetometer->get_m_axes(out_axes);
+        default:
+            return -1;
+        }
+    }
+};
+
+Iks01a2SensorBackend IKS01A2_BACKEND;
+SensorBackend *BACKEND = &IKS01A2_BACKEND;
+
+} // namespace
+
+SensorBackend &sensor_backend() {
+    return *BACKEND;
+}
+
+void sensor_backend_set(SensorBackend &backend) {
+    BACKEND = &backend;
+}
+
+#endif // SENSORS_IKS01A2
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SENSOR_BACKEND_H
+#define SENSOR_BACKEND_H
+
+#if (SENSORS_IKS01A2 == 1)
+
+#include <cstddef>
+#include <cstdint>
+
+enum class SensorType { BAROMETER, HUMIDITY, ACCELEROMETER, MAGNETOMETER };
+
+constexpr size_t SENSOR_TYPE_COUNT = 4;
+
+/**
+ * Source of readings for the sensor Objects. Scalar sensors are read with
+ * read_scalar(): barometer in hPa, humidity in %RH. Three-axis sensors are
+ * read with read_axes(): accelerometer in mg, magnetometer in mgauss. All
+ * methods return 0 on success and a non-zero value in case of error,
+ * including a sensor type that is not available.
+ */
+class SensorBackend {
+public:
+    virtual ~SensorBackend() {}
+
+    virtual int enable(SensorType type) = 0;
+    virtual int disable(SensorType type) = 0;
+    virtual int read_scalar(SensorType type, float *out_value) = 0;
+    virtual int read_axes(SensorType type, int32_t *out_axes) = 0;
+};
+
+/**
+ * @returns Backend used by the sensor Objects; by default, the one reading
+ *          the X-NUCLEO-IKS01A2 expansion board.
+ */
+SensorBackend &sensor_backend();
+
+/**
+ * Replaces the backend used by the sensor Objects, e.g. with one replaying
+ * recorded readings. Shall be called before the Objects are installed.
+ */
+void sensor_backend_set(SensorBackend &backend);
+
+#endif // SENSORS_IKS01A2
+#endif // SENSOR_BACKEND_H
@@ -19,11 +19,12 @@
 #include "sms_driver.h"
 #include <array>
 #include <avsystem/commons/avs_list_cxx.hpp>
-#include <avsystem/commons/avs_log.h>
 
 #include <anjay/anjay_config.h>
 #include <anjay/sms.h>
 
+#include "app_log.h"
+
 #ifdef ANJAY_WITH_SMS_MULTIPART
 #error SMS multipart is already handled by mbedOS
 #endif // ANJAY_WITH_SMS_MULTIPART
@@ -76,7 +77,7 @@ int sms_send(anjay_smsdrv_t *smsdrv_,
              avs_time_duration_t timeout) noexcept {
     (void) timeout;
     if (multipart_info) {
-        avs_log(sms_driver, ERROR,
+        APP_LOG(sms_driver, ERROR,
                 "Anjay WITH_SMS_MULTIPART compile option should be set to OFF "
                 "because SMS multiparts are handled internally in MbedOS");
         return -1;
@@ -130,7 +131,7 @@ int sms_should_try_recv(anjay_smsdrv_t *smsdrv_,
             return SMS_SHOULD_TRY_RECV_YES;
         } else {
             if (error != -1) {
-                avs_log(sms_driver, ERROR,
+                APP_LOG(sms_driver, ERROR,
                         "Error %d while trying to receive an sms", error);
             }
 
@@ -177,7 +178,7 @@ int sms_system_socket(anjay_smsdrv_t *smsdrv_, const void **out) noexcept {
     (void) out;
     nrf_smsdrv_t *smsdrv = get_smsdrv(smsdrv_);
 
-    avs_log(sms_driver, ERROR,
+    APP_LOG(sms_driver, ERROR,
             "anjay_smsdrv_system_socket_t method not implemented");
     smsdrv->error = AVS_ENOTSUP;
     return -1;
@@ -208,7 +209,7 @@ anjay_smsdrv_t *nrf_smsdrv_create(CellularSMS *sms) {
     nsapi_error_t error = sms->initialize(CellularSMS::CellularSMSMmodePDU,
                                           CellularSMS::CellularSMSEncoding8Bit);
     if (error) {
-        avs_log(sms_driver, ERROR, "sms->initialize failed, error = %d", error);
+        APP_LOG(sms_driver, ERROR, "sms->initialize failed, error = %d", error);
         return nullptr;
     }
     nrf_smsdrv_t *smsdrv = new (std::nothrow) nrf_smsdrv_t(sms);
@@ -221,4 +222,9 @@ bool nrf_smsdrv_has_unread(anjay_smsdrv_t *smsdrv) {
            == SMS_SHOULD_TRY_RECV_YES;
 }
 
+void nrf_smsdrv_set_receive_callback(anjay_smsdrv_t *smsdrv,
+                                     Callback<void()> callback) {
+    get_smsdrv(smsdrv)->sms->set_sms_callback(callback);
+}
+
 #endif // MBED_CONF_CELLULAR_USE_SMS
@@ -31,6 +31,14 @@
 anjay_smsdrv_t *nrf_smsdrv_create(mbed::CellularSMS *sms);
 bool nrf_smsdrv_has_unread(anjay_smsdrv_t *smsdrv);
 
+/**
+ * Sets a function to be called when the modem reports a new SMS. It is called
+ * from the cellular stack context, so it shall only defer the actual handling.
+ * Passing a null callback disables the notifications.
+ */
+void nrf_smsdrv_set_receive_callback(anjay_smsdrv_t *smsdrv,
+                                     mbed::Callback<void()> callback);
+
 #endif // MBED_CONF_CELLULAR_USE_SMS
 
 #endif // SMS_DRIVER_H
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef STATIC_OBJECT_STORAGE_H
+#define STATIC_OBJECT_STORAGE_H
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Statically allocated storage for at most one object of type @p T at a time.
+ *
+ * Used for LwM2M Objects that are created and released on every restart of
+ * the LwM2M client, so that they do not fragment the heap on long-running
+ * devices. The storage is not released automatically - destroy() shall be
+ * called for every successful construct().
+ *
+ * The host restart benchmark (host/restart_bench_main.cpp) is also built with
+ * APP_OBJECTS_ON_HEAP, which allocates the objects on the heap instead, like
+ * the application used to, to compare heap fragmentation of both.
+ */
+#ifdef APP_OBJECTS_ON_HEAP
+template <typename T>
+class StaticObjectStorage {
+    T *obj_;
+
+    StaticObjectStorage(const StaticObjectStorage &) = delete;
+    StaticObjectStorage &operator=(const StaticObjectStorage &) = delete;
+
+public:
+    constexpr StaticObjectStorage() : obj_(nullptr) {}
+
+    template <typename... Args>
+    T *construct(Args &&... args) {
+        if (obj_) {
+            return nullptr;
+        }
+        obj_ = new (std::nothrow) T(std::forward<Args>(args)...);
+        return obj_;
+    }
+
+    void destroy() {
+        delete obj_;
+        obj_ = nullptr;
+    }
+};
+#else // APP_OBJECTS_ON_HEAP
+template <typename T>
+class StaticObjectStorage {
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_;
+    bool constructed_;
+
+    StaticObjectStorage(const StaticObjectStorage &) = delete;
+    StaticObjectStorage &operator=(const StaticObjectStorage &) = delete;
+
+public:
+    constexpr StaticObjectStorage() : storage_(), constructed_(false) {}
+
+    /**
+     * Constructs the object in place. Objects without user-provided
+     * constructors are value-initialized, i.e. zeroed like with avs_calloc().
+     *
+     * @returns Pointer to the constructed object, or NULL if the object is
+     *          already constructed.
+     */
+    template <typename... Args>
+    T *construct(Args &&... args) {
+        if (constructed_) {
+            return nullptr;
+        }
+        T *obj = new (&storage_) T(std::forward<Args>(args)...);
+        constructed_ = true;
+        return obj;
+    }
+
+    /**
+     * Destroys the object, if constructed.
+     */
+    void destroy() {
+        if (constructed_) {
+            reinterpret_cast<T *>(&storage_)->~T();
+            constructed_ = false;
+        }
+    }
+};
+#endif // APP_OBJECTS_ON_HEAP
+
+#endif // STATIC_OBJECT_STORAGE_H
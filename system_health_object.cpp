@@ -0,0 +1,621 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * LwM2M Object: System Health
+ * ID: 26242, Vendor-specific, Optional, Single
+ *
+ * Diagnostic information about the device runtime, intended for tracking
+ * the device behaviour across the fleet.
+ */
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <anjay/anjay.h>
+#ifdef ANJAY_WITH_NET_STATS
+#include <anjay/stats.h>
+#endif // ANJAY_WITH_NET_STATS
+#include <avsystem/commons/avs_defs.h>
+
+#include "app_log.h"
+#include "boot_timing.h"
+#include "client_local.h"
+#include "deferred_log.h"
+#include "device_object.h"
+#include "latency_histogram.h"
+#include "runtime_stats.h"
+#include "static_object_storage.h"
+#include "system_health_object.h"
+
+#define SYSTEM_HEALTH_OBJ_LOG(...) APP_LOG(system_health_obj, __VA_ARGS__)
+
+/**
+ * Config Loaded Time: R, Single, Mandatory
+ * type: integer, range: N/A, unit: ms
+ * Time since reset after which the device configuration has been loaded,
+ * or -1 if that has not happened yet.
+ */
+#define RID_CONFIG_LOADED_TIME 0
+
+/**
+ * Network Up Time: R, Single, Mandatory
+ * type: integer, range: N/A, unit: ms
+ * Time since reset after which the network connection has been brought up
+ * for the first time, or -1 if that has not happened yet.
+ */
+#define RID_NETWORK_UP_TIME 1
+
+/**
+ * Registration Time: R, Single, Mandatory
+ * type: integer, range: N/A, unit: ms
+ * Time since reset after which the device has registered to a LwM2M Server
+ * for the first time, or -1 if that has not happened yet.
+ */
+#define RID_REGISTRATION_TIME 2
+
+/**
+ * Heap Used: R, Single, Optional
+ * type: integer, range: N/A, unit: B
+ * Amount of heap memory currently allocated.
+ */
+#define RID_HEAP_USED 3
+
+/**
+ * Heap Peak: R, Single, Optional
+ * type: integer, range: N/A, unit: B
+ * Largest amount of heap memory allocated at once since reset.
+ */
+#define RID_HEAP_PEAK 4
+
+/**
+ * Heap Size: R, Single, Optional
+ * type: integer, range: N/A, unit: B
+ * Total size of the heap.
+ */
+#define RID_HEAP_SIZE 5
+
+/**
+ * Allocation Count: R, Single, Optional
+ * type: integer, range: N/A, unit: N/A
+ * Number of heap allocations that have not been freed yet. A steady growth
+ * indicates a memory leak.
+ */
+#define RID_ALLOCATION_COUNT 6
+
+/**
+ * Allocation Failures: R, Single, Optional
+ * type: integer, range: N/A, unit: N/A
+ * Number of heap allocations that failed since reset.
+ */
+#define RID_ALLOCATION_FAILURES 7
+
+/**
+ * Thread Name: R, Multiple, Optional
+ * type: string, range: N/A, unit: N/A
+ * Name of each thread. Resource Instance IDs are shared with Stack
+ * High-Water Mark and Stack Size Resources.
+ */
+#define RID_THREAD_NAME 8
+
+/**
+ * Stack High-Water Mark: R, Multiple, Optional
+ * type: integer, range: N/A, unit: B
+ * Largest amount of stack used by each thread since it has been started.
+ */
+#define RID_STACK_HIGH_WATER_MARK 9
+
+/**
+ * Stack Size: R, Multiple, Optional
+ * type: integer, range: N/A, unit: B
+ * Stack size of each thread.
+ */
+#define RID_STACK_SIZE 10
+
+/**
+ * CPU Usage: R, Single, Optional
+ * type: float, range: 0-100, unit: %
+ * CPU usage in the most recent statistics sampling period.
+ */
+#define RID_CPU_USAGE 11
+
+/**
+ * Average CPU Usage: R, Single, Optional
+ * type: float, range: 0-100, unit: %
+ * CPU usage since reset.
+ */
+#define RID_AVERAGE_CPU_USAGE 12
+
+/**
+ * Event Loop Lag: R, Single, Mandatory
+ * type: integer, range: N/A, unit: ms
+ * How late the most recent periodic job has been run by the LwM2M event
+ * loop.
+ */
+#define RID_EVENT_LOOP_LAG 13
+
+/**
+ * Max Event Loop Lag: R, Single, Mandatory
+ * type: integer, range: N/A, unit: ms
+ * Largest Event Loop Lag observed since reset.
+ */
+#define RID_MAX_EVENT_LOOP_LAG 14
+
+/**
+ * Latency Histogram: R, Multiple, Optional
+ * type: string, range: N/A, unit: N/A
+ * Distribution of event loop lag (Instance 0), of durations of the periodic
+ * update (1), SMS handling (2) and persistence (3) jobs, and of durations of
+ * every socket serve (4) and scheduler run (5) of the event loop, formatted
+ * as "<count>;<max>;<b0>,<b1>,...", where max is in microseconds and bucket
+ * bN counts values in [2^(N-1), 2^N) microseconds.
+ */
+#define RID_LATENCY_HISTOGRAM 15
+
+/**
+ * Reset Latency Histograms: E, Single, Optional
+ * type: N/A, range: N/A, unit: N/A
+ * Clears all Latency Histogram Resource Instances.
+ */
+#define RID_RESET_LATENCY_HISTOGRAMS 16
+
+/**
+ * Dropped Log Messages: R, Single, Mandatory
+ * type: integer, range: N/A, unit: N/A
+ * Number of log messages dropped since reset because the log buffer was
+ * full.
+ */
+#define RID_DROPPED_LOG_MESSAGES 17
+
+/**
+ * Current Time Reads: R, Single, Mandatory
+ * type: integer, range: N/A, unit: N/A
+ * Number of reads of Device Current Time (/3/0/13) since the Device Object
+ * has been installed, including those made by the observation engine. Not
+ * notified on change itself; observe it with the pmax attribute.
+ */
+#define RID_CURRENT_TIME_READS 18
+
+/**
+ * Received Bytes: R, Single, Optional
+ * type: integer, range: N/A, unit: B
+ * Number of bytes received by the LwM2M client since it has been started.
+ */
+#define RID_RECEIVED_BYTES 19
+
+/**
+ * Sent Bytes: R, Single, Optional
+ * type: integer, range: N/A, unit: B
+ * Number of bytes sent by the LwM2M client since it has been started.
+ */
+#define RID_SENT_BYTES 20
+
+/**
+ * Incoming Retransmissions: R, Single, Optional
+ * type: integer, range: N/A, unit: N/A
+ * Number of retransmitted requests received since the LwM2M client has been
+ * started, whether or not their response was still in the message cache
+ * (coap_msg_cache_size).
+ */
+#define RID_INCOMING_RETRANSMISSIONS 21
+
+/**
+ * Outgoing Retransmissions: R, Single, Optional
+ * type: integer, range: N/A, unit: N/A
+ * Number of retransmissions of Confirmable messages sent since the LwM2M
+ * client has been started.
+ */
+#define RID_OUTGOING_RETRANSMISSIONS 22
+
+#ifdef RUNTIME_STATS_WITH_HEAP
+#define HEAP_STATS_PRESENCE ANJAY_DM_RES_PRESENT
+#else  // RUNTIME_STATS_WITH_HEAP
+#define HEAP_STATS_PRESENCE ANJAY_DM_RES_ABSENT
+#endif // RUNTIME_STATS_WITH_HEAP
+
+#ifdef RUNTIME_STATS_WITH_STACK
+#define STACK_STATS_PRESENCE ANJAY_DM_RES_PRESENT
+#else  // RUNTIME_STATS_WITH_STACK
+#define STACK_STATS_PRESENCE ANJAY_DM_RES_ABSENT
+#endif // RUNTIME_STATS_WITH_STACK
+
+#ifdef RUNTIME_STATS_WITH_CPU
+#define CPU_STATS_PRESENCE ANJAY_DM_RES_PRESENT
+#else  // RUNTIME_STATS_WITH_CPU
+#define CPU_STATS_PRESENCE ANJAY_DM_RES_ABSENT
+#endif // RUNTIME_STATS_WITH_CPU
+
+#ifdef ANJAY_WITH_NET_STATS
+#define NET_STATS_PRESENCE ANJAY_DM_RES_PRESENT
+#else  // ANJAY_WITH_NET_STATS
+#define NET_STATS_PRESENCE ANJAY_DM_RES_ABSENT
+#endif // ANJAY_WITH_NET_STATS
+
+typedef struct system_health_struct {
+    const anjay_dm_object_def_t *def;
+    int64_t last_registration_time;
+    uint32_t last_dropped_log_messages;
+    // Copy of the runtime statistics that have been last reported
+    RuntimeStats stats;
+} system_health_t;
+
+static inline system_health_t *
+get_obj(const anjay_dm_object_def_t *const *obj_ptr) {
+    assert(obj_ptr);
+    return AVS_CONTAINER_OF(obj_ptr, system_health_t, def);
+}
+
+static int list_resources(anjay_t *anjay,
+                          const anjay_dm_object_def_t *const *obj_ptr,
+                          anjay_iid_t iid,
+                          anjay_dm_resource_list_ctx_t *ctx) {
+    (void) anjay;
+    (void) obj_ptr;
+    (void) iid;
+
+    anjay_dm_emit_res(ctx, RID_CONFIG_LOADED_TIME, ANJAY_DM_RES_R,
+                      ANJAY_DM_RES_PRESENT);
+    anjay_dm_emit_res(ctx, RID_NETWORK_UP_TIME, ANJAY_DM_RES_R,
+                      ANJAY_DM_RES_PRESENT);
+    anjay_dm_emit_res(ctx, RID_REGISTRATION_TIME, ANJAY_DM_RES_R,
+                      ANJAY_DM_RES_PRESENT);
+    anjay_dm_emit_res(ctx, RID_HEAP_USED, ANJAY_DM_RES_R, HEAP_STATS_PRESENCE);
+    anjay_dm_emit_res(ctx, RID_HEAP_PEAK, ANJAY_DM_RES_R, HEAP_STATS_PRESENCE);
+    anjay_dm_emit_res(ctx, RID_HEAP_SIZE, ANJAY_DM_RES_R, HEAP_STATS_PRESENCE);
+    anjay_dm_emit_res(ctx, RID_ALLOCATION_COUNT, ANJAY_DM_RES_R,
+                      HEAP_STATS_PRESENCE);
+    anjay_dm_emit_res(ctx, RID_ALLOCATION_FAILURES, ANJAY_DM_RES_R,
+                      HEAP_STATS_PRESENCE);
+    anjay_dm_emit_res(ctx, RID_THREAD_NAME, ANJAY_DM_RES_RM,
+                      STACK_STATS_PRESENCE);
+    anjay_dm_emit_res(ctx, RID_STACK_HIGH_WATER_MARK, ANJAY_DM_RES_RM,
+                      STACK_STATS_PRESENCE);
+    anjay_dm_emit_res(ctx, RID_STACK_SIZE, ANJAY_DM_RES_RM,
+                      STACK_STATS_PRESENCE);
+    anjay_dm_emit_res(ctx, RID_CPU_USAGE, ANJAY_DM_RES_R, CPU_STATS_PRESENCE);
+    anjay_dm_emit_res(ctx, RID_AVERAGE_CPU_USAGE, ANJAY_DM_RES_R,
+                      CPU_STATS_PRESENCE);
+    anjay_dm_emit_res(ctx, RID_EVENT_LOOP_LAG, ANJAY_DM_RES_R,
+                      ANJAY_DM_RES_PRESENT);
+    anjay_dm_emit_res(ctx, RID_MAX_EVENT_LOOP_LAG, ANJAY_DM_RES_R,
+                      ANJAY_DM_RES_PRESENT);
+    anjay_dm_emit_res(ctx, RID_LATENCY_HISTOGRAM, ANJAY_DM_RES_RM,
+                      ANJAY_DM_RES_PRESENT);
+    anjay_dm_emit_res(ctx, RID_RESET_LATENCY_HISTOGRAMS, ANJAY_DM_RES_E,
+                      ANJAY_DM_RES_PRESENT);
+    anjay_dm_emit_res(ctx, RID_DROPPED_LOG_MESSAGES, ANJAY_DM_RES_R,
+                      ANJAY_DM_RES_PRESENT);
+    anjay_dm_emit_res(ctx, RID_CURRENT_TIME_READS, ANJAY_DM_RES_R,
+                      ANJAY_DM_RES_PRESENT);
+    anjay_dm_emit_res(ctx, RID_RECEIVED_BYTES, ANJAY_DM_RES_R,
+                      NET_STATS_PRESENCE);
+    anjay_dm_emit_res(ctx, RID_SENT_BYTES, ANJAY_DM_RES_R, NET_STATS_PRESENCE);
+    anjay_dm_emit_res(ctx, RID_INCOMING_RETRANSMISSIONS, ANJAY_DM_RES_R,
+                      NET_STATS_PRESENCE);
+    anjay_dm_emit_res(ctx, RID_OUTGOING_RETRANSMISSIONS, ANJAY_DM_RES_R,
+                      NET_STATS_PRESENCE);
+    return 0;
+}
+
+static int resource_read(anjay_t *anjay,
+                         const anjay_dm_object_def_t *const *obj_ptr,
+                         anjay_iid_t iid,
+                         anjay_rid_t rid,
+                         anjay_riid_t riid,
+                         anjay_output_ctx_t *ctx) {
+    (void) anjay;
+    assert(iid == 0);
+
+    const RuntimeStats &stats = get_obj(obj_ptr)->stats;
+    switch (rid) {
+    case RID_CONFIG_LOADED_TIME:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_i64(ctx,
+                             boot_timing_get_ms(BootPhase::CONFIG_LOADED));
+
+    case RID_NETWORK_UP_TIME:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_i64(ctx, boot_timing_get_ms(BootPhase::NETWORK_UP));
+
+    case RID_REGISTRATION_TIME:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_i64(ctx, boot_timing_get_ms(BootPhase::REGISTERED));
+
+    case RID_HEAP_USED:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_i64(ctx, stats.heap_used);
+
+    case RID_HEAP_PEAK:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_i64(ctx, stats.heap_peak);
+
+    case RID_HEAP_SIZE:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_i64(ctx, stats.heap_size);
+
+    case RID_ALLOCATION_COUNT:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_i64(ctx, stats.alloc_count);
+
+    case RID_ALLOCATION_FAILURES:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_i64(ctx, stats.alloc_failures);
+
+    case RID_THREAD_NAME:
+        assert(riid < stats.thread_count);
+        return anjay_ret_string(ctx, stats.threads[riid].name);
+
+    case RID_STACK_HIGH_WATER_MARK:
+        assert(riid < stats.thread_count);
+        return anjay_ret_i64(ctx, stats.threads[riid].max_used);
+
+    case RID_STACK_SIZE:
+        assert(riid < stats.thread_count);
+        return anjay_ret_i64(ctx, stats.threads[riid].size);
+
+    case RID_CPU_USAGE:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_float(ctx, stats.cpu_usage);
+
+    case RID_AVERAGE_CPU_USAGE:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_float(ctx, stats.average_cpu_usage);
+
+    case RID_EVENT_LOOP_LAG:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_i64(ctx, stats.event_loop_lag_ms);
+
+    case RID_MAX_EVENT_LOOP_LAG:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_i64(ctx, stats.max_event_loop_lag_ms);
+
+    case RID_LATENCY_HISTOGRAM: {
+        assert(riid < LATENCY_HISTOGRAM_COUNT);
+        char buf[160];
+        latency_histogram_snapshot(static_cast<LatencyHistogramId>(riid))
+                .format(buf, sizeof(buf));
+        return anjay_ret_string(ctx, buf);
+    }
+
+    case RID_DROPPED_LOG_MESSAGES:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_i64(ctx, deferred_log_dropped());
+
+    case RID_CURRENT_TIME_READS:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_i64(ctx, device_object_current_time_reads());
+
+#ifdef ANJAY_WITH_NET_STATS
+    case RID_RECEIVED_BYTES:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_i64(ctx, (int64_t) anjay_get_rx_bytes(anjay));
+
+    case RID_SENT_BYTES:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_i64(ctx, (int64_t) anjay_get_tx_bytes(anjay));
+
+    case RID_INCOMING_RETRANSMISSIONS:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_i64(
+                ctx, (int64_t) anjay_get_num_incoming_retransmissions(anjay));
+
+    case RID_OUTGOING_RETRANSMISSIONS:
+        assert(riid == ANJAY_ID_INVALID);
+        return anjay_ret_i64(
+                ctx, (int64_t) anjay_get_num_outgoing_retransmissions(anjay));
+#endif // ANJAY_WITH_NET_STATS
+
+    default:
+        return ANJAY_ERR_METHOD_NOT_ALLOWED;
+    }
+}
+
+static int resource_execute(anjay_t *anjay,
+                            const anjay_dm_object_def_t *const *obj_ptr,
+                            anjay_iid_t iid,
+                            anjay_rid_t rid,
+                            anjay_execute_ctx_t *arg_ctx) {
+    (void) obj_ptr;
+    (void) arg_ctx;
+    assert(iid == 0);
+
+    switch (rid) {
+    case RID_RESET_LATENCY_HISTOGRAMS:
+        latency_histograms_reset();
+        (void) anjay_notify_changed(anjay, SYSTEM_HEALTH_OID, 0,
+                                    RID_LATENCY_HISTOGRAM);
+        return 0;
+
+    default:
+        return ANJAY_ERR_METHOD_NOT_ALLOWED;
+    }
+}
+
+static int list_resource_instances(anjay_t *anjay,
+                                   const anjay_dm_object_def_t *const *obj_ptr,
+                                   anjay_iid_t iid,
+                                   anjay_rid_t rid,
+                                   anjay_dm_list_ctx_t *ctx) {
+    (void) anjay;
+    assert(iid == 0);
+
+    switch (rid) {
+    case RID_THREAD_NAME:
+    case RID_STACK_HIGH_WATER_MARK:
+    case RID_STACK_SIZE:
+        for (size_t i = 0; i < get_obj(obj_ptr)->stats.thread_count; ++i) {
+            anjay_dm_emit(ctx, (anjay_riid_t) i);
+        }
+        return 0;
+
+    case RID_LATENCY_HISTOGRAM:
+        for (size_t i = 0; i < LATENCY_HISTOGRAM_COUNT; ++i) {
+            anjay_dm_emit(ctx, (anjay_riid_t) i);
+        }
+        return 0;
+
+    default:
+        return ANJAY_ERR_METHOD_NOT_ALLOWED;
+    }
+}
+
+namespace {
+
+struct ObjDef : public anjay_dm_object_def_t {
+    ObjDef() : anjay_dm_object_def_t() {
+        oid = SYSTEM_HEALTH_OID;
+
+        handlers.list_instances = anjay_dm_list_instances_SINGLE;
+
+        handlers.list_resources = list_resources;
+        handlers.resource_read = resource_read;
+        handlers.resource_execute = resource_execute;
+        handlers.list_resource_instances = list_resource_instances;
+
+        handlers.transaction_begin = anjay_dm_transaction_NOOP;
+        handlers.transaction_validate = anjay_dm_transaction_NOOP;
+        handlers.transaction_commit = anjay_dm_transaction_NOOP;
+        handlers.transaction_rollback = anjay_dm_transaction_NOOP;
+    }
+} const OBJ_DEF;
+
+CLIENT_LOCAL StaticObjectStorage<system_health_t> OBJ_STORAGE;
+
+const anjay_dm_object_def_t **system_health_object_create(void) {
+    system_health_t *obj = OBJ_STORAGE.construct();
+    if (!obj) {
+        return NULL;
+    }
+    obj->def = &OBJ_DEF;
+    obj->last_registration_time = boot_timing_get_ms(BootPhase::REGISTERED);
+    obj->last_dropped_log_messages = deferred_log_dropped();
+    runtime_stats_get(&obj->stats);
+    return &obj->def;
+}
+
+void system_health_object_release(const anjay_dm_object_def_t ***def) {
+    if (*def) {
+        OBJ_STORAGE.destroy();
+        *def = NULL;
+    }
+}
+
+CLIENT_LOCAL const anjay_dm_object_def_t **OBJ_DEF_PTR;
+
+void notify_if_changed(anjay_t *anjay,
+                       anjay_rid_t rid,
+                       bool changed) {
+    if (changed) {
+        (void) anjay_notify_changed(anjay, SYSTEM_HEALTH_OID, 0, rid);
+    }
+}
+
+bool thread_stats_changed(const RuntimeStats &prev, const RuntimeStats &curr) {
+    if (prev.thread_count != curr.thread_count) {
+        return true;
+    }
+    for (size_t i = 0; i < curr.thread_count; ++i) {
+        if (prev.threads[i].max_used != curr.threads[i].max_used
+            || prev.threads[i].size != curr.threads[i].size
+            || strcmp(prev.threads[i].name, curr.threads[i].name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void notify_stats_changed(anjay_t *anjay,
+                          const RuntimeStats &prev,
+                          const RuntimeStats &curr) {
+    notify_if_changed(anjay, RID_HEAP_USED, prev.heap_used != curr.heap_used);
+    notify_if_changed(anjay, RID_HEAP_PEAK, prev.heap_peak != curr.heap_peak);
+    notify_if_changed(anjay, RID_HEAP_SIZE, prev.heap_size != curr.heap_size);
+    notify_if_changed(anjay, RID_ALLOCATION_COUNT,
+                      prev.alloc_count != curr.alloc_count);
+    notify_if_changed(anjay, RID_ALLOCATION_FAILURES,
+                      prev.alloc_failures != curr.alloc_failures);
+    if (thread_stats_changed(prev, curr)) {
+        notify_if_changed(anjay, RID_THREAD_NAME, true);
+        notify_if_changed(anjay, RID_STACK_HIGH_WATER_MARK, true);
+        notify_if_changed(anjay, RID_STACK_SIZE, true);
+    }
+    notify_if_changed(anjay, RID_CPU_USAGE, prev.cpu_usage != curr.cpu_usage);
+    notify_if_changed(anjay, RID_AVERAGE_CPU_USAGE,
+                      prev.average_cpu_usage != curr.average_cpu_usage);
+    // Histograms are updated continuously, report them at the sampling rate
+    notify_if_changed(anjay, RID_LATENCY_HISTOGRAM, true);
+}
+
+} // namespace
+
+int system_health_object_install(anjay_t *anjay) {
+    if (OBJ_DEF_PTR) {
+        SYSTEM_HEALTH_OBJ_LOG(
+                ERROR, "System Health Object has been already installed");
+        return -1;
+    }
+
+    OBJ_DEF_PTR = system_health_object_create();
+    return anjay_register_object(anjay, OBJ_DEF_PTR);
+}
+
+void system_health_object_uninstall(anjay_t *anjay) {
+    if (OBJ_DEF_PTR) {
+        if (anjay_unregister_object(anjay, OBJ_DEF_PTR)) {
+            SYSTEM_HEALTH_OBJ_LOG(
+                    ERROR, "Error during unregistering System Health Object");
+        }
+        system_health_object_release(&OBJ_DEF_PTR);
+    }
+}
+
+void system_health_object_update(anjay_t *anjay) {
+    if (!OBJ_DEF_PTR) {
+        return;
+    }
+    system_health_t *obj = get_obj(OBJ_DEF_PTR);
+
+    // The other boot timings are known before the object is installed
+    const int64_t registration_time = boot_timing_get_ms(BootPhase::REGISTERED);
+    if (registration_time != obj->last_registration_time) {
+        obj->last_registration_time = registration_time;
+        (void) anjay_notify_changed(anjay, SYSTEM_HEALTH_OID, 0,
+                                    RID_REGISTRATION_TIME);
+    }
+
+    const uint32_t dropped_log_messages = deferred_log_dropped();
+    if (dropped_log_messages != obj->last_dropped_log_messages) {
+        obj->last_dropped_log_messages = dropped_log_messages;
+        (void) anjay_notify_changed(anjay, SYSTEM_HEALTH_OID, 0,
+                                    RID_DROPPED_LOG_MESSAGES);
+    }
+
+    RuntimeStats stats;
+    runtime_stats_get(&stats);
+    RuntimeStats &prev = obj->stats;
+    if (stats.event_loop_lag_ms != prev.event_loop_lag_ms) {
+        (void) anjay_notify_changed(anjay, SYSTEM_HEALTH_OID, 0,
+                                    RID_EVENT_LOOP_LAG);
+    }
+    if (stats.max_event_loop_lag_ms != prev.max_event_loop_lag_ms) {
+        (void) anjay_notify_changed(anjay, SYSTEM_HEALTH_OID, 0,
+                                    RID_MAX_EVENT_LOOP_LAG);
+    }
+    if (stats.generation != prev.generation) {
+        notify_stats_changed(anjay, prev, stats);
+    }
+    prev = stats;
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wakeup_stats.h"
+
+#include <inttypes.h>
+#include <mbed.h>
+
+#include "app_log.h"
+
+namespace {
+
+const char *const WAKEUP_CAUSE_NAMES[WAKEUP_CAUSE_COUNT] = {
+    "periodic update", "SMS", "network event", "heartbeat",
+    "incoming packet", "job", "loop timeout"
+};
+
+uint32_t WAKEUP_COUNTS[WAKEUP_CAUSE_COUNT];
+uint64_t AWAKE_TIMES_US[WAKEUP_CAUSE_COUNT];
+
+size_t cause_index(WakeupCause cause) {
+    const size_t index = static_cast<size_t>(cause);
+    assert(index < WAKEUP_CAUSE_COUNT);
+    return index;
+}
+
+} // namespace
+
+WakeupScope::WakeupScope(WakeupCause cause)
+        : cause_(cause), start_(avs_time_monotonic_now()) {}
+
+WakeupScope::~WakeupScope() {
+    int64_t awake_time_us;
+    if (avs_time_duration_to_scalar(
+                &awake_time_us, AVS_TIME_US,
+                avs_time_monotonic_diff(avs_time_monotonic_now(), start_))
+            || awake_time_us < 0) {
+        awake_time_us = 0;
+    }
+    const size_t index = cause_index(cause_);
+    core_util_atomic_incr_u32(&WAKEUP_COUNTS[index], 1);
+    core_util_atomic_incr_u64(&AWAKE_TIMES_US[index],
+                              (uint64_t) awake_time_us);
+}
+
+uint32_t wakeup_stats_count(WakeupCause cause) {
+    return core_util_atomic_load_u32(&WAKEUP_COUNTS[cause_index(cause)]);
+}
+
+uint64_t wakeup_stats_awake_time_us(WakeupCause cause) {
+    return core_util_atomic_load_u64(&AWAKE_TIMES_US[cause_index(cause)]);
+}
+
+void wakeup_stats_log() {
+    APP_LOG(wakeup_stats, INFO, "Wakeups:");
+    for (size_t i = 0; i < WAKEUP_CAUSE_COUNT; ++i) {
+        const WakeupCause cause = static_cast<WakeupCause>(i);
+        APP_LOG(wakeup_stats, INFO,
+                "- %-15s: %6" PRIu32 " times, %8" PRIu64 " us awake",
+                WAKEUP_CAUSE_NAMES[i], wakeup_stats_count(cause),
+                wakeup_stats_awake_time_us(cause));
+    }
+#if MBED_CPU_STATS_ENABLED
+    mbed_stats_cpu_t cpu_stats;
+    mbed_stats_cpu_get(&cpu_stats);
+    APP_LOG(wakeup_stats, INFO,
+            "Uptime %" PRIu64 " us, sleep %" PRIu64 " us, deep sleep %" PRIu64
+            " us",
+            cpu_stats.uptime, cpu_stats.sleep_time, cpu_stats.deep_sleep_time);
+#endif // MBED_CPU_STATS_ENABLED
+}
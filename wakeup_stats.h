@@ -0,0 +1,74 @@
+/*
+ * Copyright 2020-2025 AVSystem <avsystem@avsystem.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WAKEUP_STATS_H
+#define WAKEUP_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <avsystem/commons/avs_time.h>
+
+/**
+ * Application activities that wake the MCU up periodically or on external
+ * events.
+ *
+ * Every wakeup of the LwM2M event loop is accounted as an incoming packet, a
+ * scheduled job or a loop timeout (see EventLoop); periodic updates and SMS
+ * are handled by jobs of that loop, so they are accounted in addition.
+ */
+enum class WakeupCause {
+    PERIODIC_UPDATE,
+    SMS,
+    NETWORK_EVENT,
+    HEARTBEAT,
+    INCOMING_PACKET,
+    SCHEDULED_JOB,
+    // Maximum wait of the event loop elapsed with nothing to do
+    LOOP_TIMEOUT
+};
+
+constexpr size_t WAKEUP_CAUSE_COUNT = 7;
+
+/**
+ * Accounts a single wakeup for the given cause, along with the time spent
+ * awake handling it, measured from construction to destruction.
+ *
+ * May be used from any thread.
+ */
+class WakeupScope {
+    WakeupCause cause_;
+    avs_time_monotonic_t start_;
+
+    WakeupScope(const WakeupScope &) = delete;
+    WakeupScope &operator=(const WakeupScope &) = delete;
+
+public:
+    explicit WakeupScope(WakeupCause cause);
+    ~WakeupScope();
+};
+
+uint32_t wakeup_stats_count(WakeupCause cause);
+
+uint64_t wakeup_stats_awake_time_us(WakeupCause cause);
+
+/**
+ * Logs the number of wakeups and time spent awake for each cause, and the
+ * total time spent in sleep and deep sleep, if CPU statistics are enabled.
+ */
+void wakeup_stats_log();
+
+#endif // WAKEUP_STATS_H